@@ -6,6 +6,9 @@
  * Copyright © 2003, 2011 Mike Murphy
  *
  */
+using System;
+using EMU7800.Core.Extensions;
+
 namespace EMU7800.Core;
 
 public sealed class AddressSpace
@@ -27,6 +30,13 @@ public sealed class AddressSpace
 
     public byte DataBusState { get; private set; }
 
+    /// <summary>
+    /// The address of the last access, tracked only while <see cref="TracingAddressBus"/> is set.
+    /// </summary>
+    public ushort AddressBusState { get; private set; }
+
+    public bool TracingAddressBus { get; set; }
+
     public int MariaRead { get; set; }
 
     public byte this[ushort addr]
@@ -36,6 +46,8 @@ public sealed class AddressSpace
             // here DataBusState is just facilitating a dummy read to the snooper device
             // the read operation may have important side effects within the device
             DataBusState = Snooper[addr];
+            if (TracingAddressBus)
+                AddressBusState = addr;
             var pageno = (addr & AddrSpaceMask) >> PageShift;
             var dev = MemoryMap[pageno];
             DataBusState = dev[addr];
@@ -44,6 +56,8 @@ public sealed class AddressSpace
         set
         {
             DataBusState = value;
+            if (TracingAddressBus)
+                AddressBusState = addr;
             Snooper[addr] = DataBusState;
             var pageno = (addr & AddrSpaceMask) >> PageShift;
             var dev = MemoryMap[pageno];
@@ -56,10 +70,21 @@ public sealed class AddressSpace
         for (int addr = basea; addr < basea + size; addr += PageSize)
         {
             var pageno = (addr & AddrSpaceMask) >> PageShift;
-            MemoryMap[pageno] = device;
+            if (MemoryMap[pageno] is TrapDevice trap)
+            {
+                while (trap.Device is TrapDevice inner)
+                {
+                    trap = inner;
+                }
+                trap.Device = device;
+            }
+            else
+            {
+                MemoryMap[pageno] = device;
+            }
         }
 
-        LogDebug($"{this}: Mapped {device} to ${basea:x4}:${basea + size - 1:x4}");
+        M.Logger.Log(5, $"{this}: Mapped {device} to ${basea:x4}:${basea + size - 1:x4}");
     }
 
     public void Map(ushort basea, ushort size, Cart cart)
@@ -79,6 +104,98 @@ public sealed class AddressSpace
         return cart.Map();
     }
 
+    /// <summary>
+    /// Whether the specified device is mapped at the address, beneath any patches or watches.
+    /// </summary>
+    public bool IsMapped(ushort addr, IDevice device)
+    {
+        var dev = MemoryMap[(addr & AddrSpaceMask) >> PageShift];
+        while (dev is TrapDevice trap)
+        {
+            dev = trap.Device;
+        }
+        return dev == device;
+    }
+
+    /// <summary>
+    /// Makes reads of the specified address return the given value until unpatched, as for a cheat.
+    /// Only the page holding the address is rerouted, so accesses to unpatched pages cost nothing extra.
+    /// Reads through a mirror of the address on another page are unaffected; see <see cref="MachineBase.PatchRAM"/>.
+    /// </summary>
+    public void Patch(ushort addr, byte value)
+    {
+        var pageno = (addr & AddrSpaceMask) >> PageShift;
+        if (FindTrap<PatchDevice>(pageno) is not { } patch)
+        {
+            MemoryMap[pageno] = patch = new PatchDevice(MemoryMap[pageno], PageSize);
+        }
+        patch.Set(addr, value);
+
+        M.Logger.Log(3, $"{this}: Patched ${addr:x4}={value:x2}");
+    }
+
+    public void Unpatch(ushort addr)
+    {
+        var pageno = (addr & AddrSpaceMask) >> PageShift;
+        if (FindTrap<PatchDevice>(pageno) is { } patch && patch.Clear(addr))
+        {
+            RemoveTrap(pageno, patch);
+        }
+    }
+
+    public void UnpatchAll()
+    {
+        for (var pageno = 0; pageno < MemoryMap.Length; pageno++)
+        {
+            if (FindTrap<PatchDevice>(pageno) is { } patch)
+            {
+                RemoveTrap(pageno, patch);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Calls the handler with the address and data after each matching access of the specified address, e.g. to
+    /// react to a score changing. As with <see cref="Patch"/>, only the page holding the address is rerouted, so
+    /// accesses made through a mirror of the address on another page are not seen.
+    /// </summary>
+    /// <remarks>
+    /// The handler runs in the middle of a CPU instruction, so it should only observe; accessing the address space
+    /// from it may trigger device side effects. Watches are not saved with the machine, so one returned by
+    /// <see cref="MachineBase.Deserialize"/> starts without any.
+    /// </remarks>
+    public void Watch(ushort addr, WatchAccess access, Action<ushort, byte> handler)
+    {
+        var pageno = (addr & AddrSpaceMask) >> PageShift;
+        if (FindTrap<WatchDevice>(pageno) is not { } watch)
+        {
+            MemoryMap[pageno] = watch = new WatchDevice(MemoryMap[pageno], PageSize);
+        }
+        watch.Set(addr, access, handler);
+
+        M.Logger.Log(3, $"{this}: Watching ${addr:x4} ({access})");
+    }
+
+    public void Unwatch(ushort addr)
+    {
+        var pageno = (addr & AddrSpaceMask) >> PageShift;
+        if (FindTrap<WatchDevice>(pageno) is { } watch && watch.Clear(addr))
+        {
+            RemoveTrap(pageno, watch);
+        }
+    }
+
+    public void UnwatchAll()
+    {
+        for (var pageno = 0; pageno < MemoryMap.Length; pageno++)
+        {
+            if (FindTrap<WatchDevice>(pageno) is { } watch)
+            {
+                RemoveTrap(pageno, watch);
+            }
+        }
+    }
+
     #region Constructors
 
     public AddressSpace(MachineBase m, int addrSpaceShift, int pageShift)
@@ -105,6 +222,9 @@ public sealed class AddressSpace
     #region Serialization Members
 
     public AddressSpace(DeserializationContext input, MachineBase m, int addrSpaceShift, int pageShift) : this(m, addrSpaceShift, pageShift)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
         input.CheckVersion(1);
         DataBusState = input.ReadByte();
@@ -120,8 +240,149 @@ public sealed class AddressSpace
 
     #region Helpers
 
-    void LogDebug(string message)
-        => M.Logger.Log(5, message);
+    T? FindTrap<T>(int pageno) where T : TrapDevice
+    {
+        var dev = MemoryMap[pageno];
+        while (dev is TrapDevice trap)
+        {
+            if (trap is T found)
+            {
+                return found;
+            }
+            dev = trap.Device;
+        }
+        return null;
+    }
+
+    void RemoveTrap(int pageno, TrapDevice trap)
+    {
+        if (MemoryMap[pageno] == trap)
+        {
+            MemoryMap[pageno] = trap.Device;
+            return;
+        }
+        var outer = (TrapDevice)MemoryMap[pageno];
+        while (outer.Device != trap)
+        {
+            outer = (TrapDevice)outer.Device;
+        }
+        outer.Device = trap.Device;
+    }
 
     #endregion
+
+    /// <summary>
+    /// Interposed on a single page ahead of the device mapped there; traps on the same page are chained.
+    /// </summary>
+    abstract class TrapDevice : IDevice
+    {
+        public IDevice Device { get; set; }
+
+        public void Reset()
+            => Device.Reset();
+
+        public abstract byte this[ushort addr] { get; set; }
+
+        protected TrapDevice(IDevice device, int pageSize)
+        {
+            ArgumentException.ThrowIf(pageSize > 64, "pages larger than 64 bytes cannot be trapped", nameof(pageSize));
+
+            Device = device;
+        }
+    }
+
+    sealed class PatchDevice : TrapDevice
+    {
+        readonly byte[] _values;
+        readonly int _pageMask;
+        ulong _patched;
+
+        public override byte this[ushort addr]
+        {
+            get
+            {
+                // the underlying read still happens for any side effects, e.g. bankswitching hotspots
+                var data = Device[addr];
+                var i = addr & _pageMask;
+                return (_patched & (1UL << i)) != 0 ? _values[i] : data;
+            }
+            set => Device[addr] = value;
+        }
+
+        public void Set(ushort addr, byte value)
+        {
+            var i = addr & _pageMask;
+            _values[i] = value;
+            _patched |= 1UL << i;
+        }
+
+        /// <returns>true when no patches remain on the page.</returns>
+        public bool Clear(ushort addr)
+        {
+            _patched &= ~(1UL << (addr & _pageMask));
+            return _patched == 0;
+        }
+
+        public PatchDevice(IDevice device, int pageSize) : base(device, pageSize)
+        {
+            _values = new byte[pageSize];
+            _pageMask = pageSize - 1;
+        }
+    }
+
+    sealed class WatchDevice : TrapDevice
+    {
+        readonly Action<ushort, byte>[] _handlers;
+        readonly int _pageMask;
+        ulong _watchedReads, _watchedWrites;
+
+        public override byte this[ushort addr]
+        {
+            get
+            {
+                var data = Device[addr];
+                var i = addr & _pageMask;
+                if ((_watchedReads & (1UL << i)) != 0)
+                {
+                    _handlers[i](addr, data);
+                }
+                return data;
+            }
+            set
+            {
+                Device[addr] = value;
+                var i = addr & _pageMask;
+                if ((_watchedWrites & (1UL << i)) != 0)
+                {
+                    _handlers[i](addr, value);
+                }
+            }
+        }
+
+        public void Set(ushort addr, WatchAccess access, Action<ushort, byte> handler)
+        {
+            var i = addr & _pageMask;
+            var bit = 1UL << i;
+            _handlers[i] = handler;
+            _watchedReads = (access & WatchAccess.Read) != 0 ? _watchedReads | bit : _watchedReads & ~bit;
+            _watchedWrites = (access & WatchAccess.Write) != 0 ? _watchedWrites | bit : _watchedWrites & ~bit;
+        }
+
+        /// <returns>true when no watches remain on the page.</returns>
+        public bool Clear(ushort addr)
+        {
+            var i = addr & _pageMask;
+            _handlers[i] = static (_, _) => {};
+            _watchedReads &= ~(1UL << i);
+            _watchedWrites &= ~(1UL << i);
+            return (_watchedReads | _watchedWrites) == 0;
+        }
+
+        public WatchDevice(IDevice device, int pageSize) : base(device, pageSize)
+        {
+            _handlers = new Action<ushort, byte>[pageSize];
+            Array.Fill(_handlers, static (_, _) => {});
+            _pageMask = pageSize - 1;
+        }
+    }
 }
\ No newline at end of file
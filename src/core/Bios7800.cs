@@ -58,6 +58,12 @@ public sealed class Bios7800 : IDevice
         Mask--;
     }
 
+    public void Restore(DeserializationContext input)
+    {
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+    }
+
     public void GetObjectData(SerializationContext output)
     {
         output.WriteVersion(1);
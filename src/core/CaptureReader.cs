@@ -0,0 +1,147 @@
+/*
+ * CaptureReader.cs
+ *
+ * Decodes the video of a capture produced by CaptureRecorder, one frame of palette indices at a time.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.IO;
+using System.IO.Compression;
+using System.Runtime.Serialization;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class CaptureReader : IDisposable
+{
+    readonly Stream _stream;
+    readonly BufferedStream _records;
+    readonly byte[] _frame;
+    readonly uint[] _palette = new uint[256];
+    readonly int _version;
+    int _pendingDrops;
+
+    public int Pitch { get; }
+    public int Scanlines { get; }
+    public int FirstScanline { get; }
+    public int FrameHZ { get; }
+    public int SoundSamplesPerFrame { get; }
+    public ReadOnlySpan<uint> Palette => _palette;
+
+    /// <summary>
+    /// Number of frames decoded so far, including those dropped during recording.
+    /// </summary>
+    public long FrameCount { get; private set; }
+
+    /// <summary>
+    /// Number of frames decoded so far that were dropped during recording.
+    /// </summary>
+    public long FramesDropped { get; private set; }
+
+    /// <summary>
+    /// Whether the last frame read was dropped during recording, and so repeats the frame before it.
+    /// </summary>
+    public bool IsDroppedFrame { get; private set; }
+
+    /// <summary>
+    /// Decodes the next frame into the destination, which must hold Pitch * Scanlines palette indices.
+    /// A frame dropped during recording is decoded as a repeat of the prior frame; see <see cref="IsDroppedFrame"/>.
+    /// </summary>
+    /// <returns>false at the end of the capture, including one cut short by an abnormal exit.</returns>
+    public bool ReadFrame(Span<byte> destination)
+    {
+        ArgumentException.ThrowIf(destination.Length < _frame.Length, "too short for a frame", nameof(destination));
+
+        if (_pendingDrops == 0 && _version >= 2)
+        {
+            if (!TryReadCount(out _pendingDrops))
+                return false;
+        }
+        IsDroppedFrame = _pendingDrops > 0;
+        if (IsDroppedFrame)
+        {
+            _pendingDrops--;
+            _frame.CopyTo(destination);
+            FramesDropped++;
+            FrameCount++;
+            return true;
+        }
+
+        var i = 0;
+        while (i < _frame.Length)
+        {
+            if (!TryReadCount(out var unchanged))
+                return false;
+            i += unchanged;
+            if (!TryReadCount(out var literals))
+                return false;
+            SerializationException.ThrowIf(i + literals > _frame.Length, "Capture frame record overruns the frame.");
+            for (var end = i + literals; i < end; i++)
+            {
+                var b = _records.ReadByte();
+                if (b < 0)
+                    return false;
+                _frame[i] ^= (byte)b;
+            }
+        }
+
+        _frame.CopyTo(destination);
+        FrameCount++;
+        return true;
+    }
+
+    public void Dispose()
+    {
+        _records.Dispose();
+        _stream.Dispose();
+    }
+
+    #region Constructors
+
+    /// <param name="stream">Capture video stream; owned by the reader.</param>
+    public CaptureReader(Stream stream)
+    {
+        _stream = stream;
+
+        var reader = new BinaryReader(_stream);
+        SerializationException.ThrowIf(reader.ReadUInt32() != CaptureRecorder.Magic, "Unrecognized capture file format.");
+        _version = reader.ReadInt32();
+        SerializationException.ThrowIf(_version is < 1 or > CaptureRecorder.Version, "Unrecognized capture file format.");
+        Pitch = reader.ReadInt32();
+        Scanlines = reader.ReadInt32();
+        FirstScanline = reader.ReadInt32();
+        FrameHZ = reader.ReadInt32();
+        SoundSamplesPerFrame = reader.ReadInt32();
+        for (var i = 0; i < _palette.Length; i++)
+        {
+            _palette[i] = reader.ReadUInt32();
+        }
+        SerializationException.ThrowIf(Pitch <= 0 || Scanlines <= 0 || FrameHZ <= 0, "Capture file header is corrupt.");
+
+        _frame = new byte[Pitch * Scanlines];
+        _records = new(new DeflateStream(_stream, CompressionMode.Decompress, true), 1 << 16);
+    }
+
+    #endregion
+
+    #region Helpers
+
+    bool TryReadCount(out int count)
+    {
+        count = 0;
+        for (var shift = 0; shift < 32; shift += 7)
+        {
+            var b = _records.ReadByte();
+            if (b < 0)
+                return false;
+            count |= (b & 0x7f) << shift;
+            if (b < 0x80)
+                return true;
+        }
+        throw new SerializationException("Capture frame record is corrupt.");
+    }
+
+    #endregion
+}
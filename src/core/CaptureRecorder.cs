@@ -0,0 +1,308 @@
+/*
+ * CaptureRecorder.cs
+ *
+ * Lossless capture of emulator video and audio output, encoded on a background thread.
+ *
+ * Video is stored as palette indices, as computed into FrameBuffer.VideoBuffer:
+ *   header (uncompressed, little-endian):
+ *     "E78C", int32 version, int32 pitch, int32 scanlines, int32 first visible scanline,
+ *     int32 frame rate (HZ), int32 sound samples per frame, uint32 palette[256]
+ *   followed by a deflate stream of one record per frame. Each record starts with a LEB128 count of
+ *   frames dropped in its place. A count of zero is followed by a run-length encoding of the XOR of the
+ *   frame with the prior one (all zeros before the first frame) as repeated
+ *   (LEB128 unchanged byte count, LEB128 literal byte count, literal bytes) until the frame is covered.
+ * Audio, from FrameBuffer.SoundBuffer, is written as an 8-bit mono PCM WAV file, with a frame of silence
+ * in place of each dropped frame so that it stays in step with the video.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.IO;
+using System.IO.Compression;
+using System.Text;
+using System.Threading;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class CaptureRecorder : IDisposable
+{
+    public const uint Magic = 0x43383745; // "E78C"
+    public const int Version = 2;
+    public const int HeaderSize = 28 + 256 * 4;
+
+    readonly Stream _videoStream, _audioStream;
+    readonly DeflateStream _deflateStream;
+    readonly ILogger _logger;
+
+    // Filled frames travel to the encoder and emptied slots travel back, each through its own single producer queue.
+    readonly byte[][] _videoSlots, _soundSlots;
+    readonly SpscQueue<int> _filled, _free;
+
+    // Frames dropped ahead of the frame in each slot, and since the last recorded frame.
+    readonly int[] _slotDrops;
+    int _unrecordedDrops;
+
+    readonly byte[] _priorFrame, _record, _silence;
+    readonly Thread _encoderThread;
+    volatile bool _stopRequested;
+    volatile Exception? _encoderFault;
+    long _audioBytes, _videoBytesWritten;
+    bool _disposed;
+
+    public int Pitch { get; }
+    public int Scanlines { get; }
+    public int SoundSamplesPerFrame { get; }
+    public int FrameHZ { get; }
+
+    /// <summary>
+    /// Number of frames handed to the encoder.
+    /// </summary>
+    public long FramesRecorded { get; private set; }
+
+    /// <summary>
+    /// Number of frames lost because the encoder fell a full queue behind, or failed. Each is marked
+    /// in the capture unless the encoder failed.
+    /// </summary>
+    public long FramesDropped { get; private set; }
+
+    /// <summary>
+    /// Compressed size of the video written so far, excluding buffered output.
+    /// </summary>
+    public long VideoBytesWritten => Volatile.Read(ref _videoBytesWritten);
+
+    /// <summary>
+    /// Copies the computed frame for encoding. Never blocks and does not allocate; intended to be called
+    /// from the emulation thread after each computed frame.
+    /// </summary>
+    public void Record(FrameBuffer frameBuffer)
+    {
+        if (_encoderFault is not null || !_free.TryDequeue(out var slot))
+        {
+            FramesDropped++;
+            _unrecordedDrops++;
+            return;
+        }
+
+        frameBuffer.VideoBuffer.Span.CopyTo(_videoSlots[slot]);
+        frameBuffer.SoundBuffer.Span.CopyTo(_soundSlots[slot]);
+        _slotDrops[slot] = _unrecordedDrops;
+        _unrecordedDrops = 0;
+        _filled.TryEnqueue(slot);
+        FramesRecorded++;
+    }
+
+    /// <summary>
+    /// Waits for queued frames to be encoded, then completes and closes the output streams.
+    /// </summary>
+    public void Dispose()
+    {
+        if (_disposed)
+            return;
+        _disposed = true;
+
+        _stopRequested = true;
+        _encoderThread.Join();
+
+        try
+        {
+            if (_encoderFault is null && _unrecordedDrops > 0)
+            {
+                WriteDrops(_unrecordedDrops);
+            }
+            _deflateStream.Dispose();
+            if (_audioStream.CanSeek)
+            {
+                _audioStream.Position = 0;
+                WaveFile.WriteHeader(_audioStream, SoundSamplesPerFrame * FrameHZ, _audioBytes);
+            }
+        }
+        finally
+        {
+            _videoStream.Dispose();
+            _audioStream.Dispose();
+        }
+
+        if (_encoderFault is not null)
+        {
+            _logger.Log(1, $"{nameof(CaptureRecorder)}: Encoding failed: {_encoderFault.Message}");
+        }
+        else if (FramesDropped > 0)
+        {
+            _logger.Log(2, $"{nameof(CaptureRecorder)}: Encoder fell behind; {FramesDropped} frames dropped and marked in the capture");
+        }
+        _logger.Log(3, $"{nameof(CaptureRecorder)}: {FramesRecorded} frames recorded, {FramesDropped} dropped, {VideoBytesWritten} video bytes");
+    }
+
+    #region Constructors
+
+    /// <param name="m">Machine whose frame geometry, frame rate and palette are recorded.</param>
+    /// <param name="videoStream">Destination of the indexed-color video; owned by the recorder.</param>
+    /// <param name="audioStream">Destination of the WAV audio; owned by the recorder, and seekable for the final header.</param>
+    /// <param name="queueCapacity">Frames that may await encoding; must be a power of two.</param>
+    /// <param name="logger"></param>
+    public CaptureRecorder(MachineBase m, Stream videoStream, Stream audioStream, int queueCapacity, ILogger logger)
+    {
+        ArgumentException.ThrowIf(queueCapacity <= 0 || (queueCapacity & (queueCapacity - 1)) != 0, "must be a positive power of two", nameof(queueCapacity));
+
+        _videoStream = videoStream;
+        _audioStream = audioStream;
+        _logger = logger;
+
+        Pitch = m.FrameBuffer.VisiblePitch;
+        Scanlines = m.FrameBuffer.Scanlines;
+        SoundSamplesPerFrame = m.FrameBuffer.SoundBuffer.Length;
+        FrameHZ = m.FrameHZ;
+
+        var frameSize = m.FrameBuffer.VideoBuffer.Length;
+        _priorFrame = new byte[frameSize];
+        // Worst case a literal run is broken every five bytes, each break costing at most two 3-byte counts,
+        // after the count of dropped frames.
+        _record = new byte[1 + frameSize + 6 * (frameSize / 5 + 2)];
+
+        _filled = new(queueCapacity);
+        _free = new(queueCapacity);
+        _videoSlots = new byte[queueCapacity][];
+        _soundSlots = new byte[queueCapacity][];
+        _slotDrops = new int[queueCapacity];
+        _silence = new byte[SoundSamplesPerFrame];
+        for (var i = 0; i < queueCapacity; i++)
+        {
+            _videoSlots[i] = new byte[frameSize];
+            _soundSlots[i] = new byte[SoundSamplesPerFrame];
+            _free.TryEnqueue(i);
+        }
+
+        var writer = new BinaryWriter(_videoStream, Encoding.UTF8, true);
+        writer.Write(Magic);
+        writer.Write(Version);
+        writer.Write(Pitch);
+        writer.Write(Scanlines);
+        writer.Write(m.FirstScanline);
+        writer.Write(FrameHZ);
+        writer.Write(SoundSamplesPerFrame);
+        foreach (var color in m.Palette.Span)
+        {
+            writer.Write(color);
+        }
+        writer.Flush();
+
+        _deflateStream = new(_videoStream, CompressionLevel.Fastest, true);
+        WaveFile.WriteHeader(_audioStream, SoundSamplesPerFrame * FrameHZ, 0);
+
+        _encoderThread = new(EncoderThreadProc) { IsBackground = true, Name = nameof(CaptureRecorder), Priority = ThreadPriority.BelowNormal };
+        _encoderThread.Start();
+    }
+
+    #endregion
+
+    #region Helpers
+
+    void EncoderThreadProc()
+    {
+        try
+        {
+            while (true)
+            {
+                if (_filled.TryDequeue(out var slot))
+                {
+                    if (_slotDrops[slot] > 0)
+                    {
+                        WriteDrops(_slotDrops[slot]);
+                    }
+                    var length = EncodeFrame(_videoSlots[slot], _priorFrame, _record);
+                    _deflateStream.Write(_record, 0, length);
+                    _audioStream.Write(_soundSlots[slot]);
+                    _audioBytes += _soundSlots[slot].Length;
+                    _free.TryEnqueue(slot);
+                    if (_videoStream.CanSeek)
+                    {
+                        Volatile.Write(ref _videoBytesWritten, _videoStream.Position);
+                    }
+                }
+                else if (_stopRequested)
+                {
+                    break;
+                }
+                else
+                {
+                    // Polling keeps the emulation thread free of any signaling.
+                    Thread.Sleep(1);
+                }
+            }
+        }
+        catch (Exception ex)
+        {
+            _encoderFault = ex;
+        }
+    }
+
+    /// <summary>
+    /// Marks frames dropped in place of their records, and fills their audio with silence.
+    /// </summary>
+    void WriteDrops(int count)
+    {
+        var length = WriteCount(_record, count);
+        _deflateStream.Write(_record, 0, length);
+        for (var i = 0; i < count; i++)
+        {
+            _audioStream.Write(_silence);
+        }
+        _audioBytes += (long)count * _silence.Length;
+    }
+
+    /// <summary>
+    /// Run-length encodes the XOR delta of the frame against the prior frame, which becomes the frame.
+    /// </summary>
+    /// <returns>Length of the record.</returns>
+    static int EncodeFrame(ReadOnlySpan<byte> frame, Span<byte> prior, Span<byte> record)
+    {
+        var length = WriteCount(record, 0);  // no frames dropped
+        var i = 0;
+        while (i < frame.Length)
+        {
+            var unchanged = frame[i..].CommonPrefixLength(prior[i..]);
+            var literalStart = i + unchanged;
+
+            // Literal run ends at the next stretch of four or more unchanged bytes, or the end of the frame.
+            var literalEnd = literalStart;
+            while (literalEnd < frame.Length)
+            {
+                literalEnd++;
+                while (literalEnd < frame.Length && frame[literalEnd] != prior[literalEnd])
+                {
+                    literalEnd++;
+                }
+                var matched = frame[literalEnd..].CommonPrefixLength(prior[literalEnd..]);
+                if (matched >= 4 || literalEnd + matched == frame.Length)
+                    break;
+                literalEnd += matched;
+            }
+
+            length += WriteCount(record[length..], unchanged);
+            length += WriteCount(record[length..], literalEnd - literalStart);
+            for (var j = literalStart; j < literalEnd; j++)
+            {
+                record[length++] = (byte)(frame[j] ^ prior[j]);
+            }
+            i = literalEnd;
+        }
+        frame.CopyTo(prior);
+        return length;
+    }
+
+    static int WriteCount(Span<byte> destination, int count)
+    {
+        var length = 0;
+        while (count >= 0x80)
+        {
+            destination[length++] = (byte)(count | 0x80);
+            count >>= 7;
+        }
+        destination[length++] = (byte)count;
+        return length;
+    }
+
+    #endregion
+}
@@ -10,10 +10,8 @@ namespace EMU7800.Core;
 /// The Bankset scheme was created by Fred Quimby, in collaboration with Mike Saarna.
 /// For more details, see http://7800.8bitdev.org/index.php/Bankset_Bankswitching.
 /// </summary>
-public abstract class Cart78BB : Cart
+public abstract class Cart78BB : BankswitchedCart
 {
-    protected byte[] RAM { get; private set; } = [];
-
     protected Cart78BB() {}
     protected Cart78BB(DeserializationContext input) : base(input) {}
 
@@ -35,12 +33,6 @@ public abstract class Cart78BB : Cart
         System.Buffer.BlockCopy(romBytes, 0, ROM, 0, romBytes.Length);
     }
 
-    protected void LoadRam(byte[] ramBytes)
-    {
-        RAM = new byte[ramBytes.Length];
-        System.Buffer.BlockCopy(ramBytes, 0, RAM, 0, ramBytes.Length);
-    }
-
     protected void InitRam(int size)
     {
         RAM = new byte[size];
@@ -13,51 +13,70 @@ public sealed class Cart78BB128K : Cart78BB
     // 0xC000:0x4000   0x1C000:0x4000 ROM CPU readable - 16kb bank 7
     // 0xC000:0x4000   0x3C000:0x4000 ROM Maria readable - 16kb bank 7
 
-    readonly int[] Bank = [0, 6, 0, 7];
-
-    #region IDevice Members
-
     const int
         ROM_SHIFT     = 18,
         ROM_SIZE      = 1 << ROM_SHIFT,     // 256 KB, 0x40000
         ROMBANK_SHIFT = 14,
-        ROMBANK_SIZE  = 1 << ROMBANK_SHIFT, //  16 KB, 0x4000
-        ROMBANK_MASK  = ROMBANK_SIZE - 1
+        ROMBANK_SIZE  = 1 << ROMBANK_SHIFT  //  16 KB, 0x4000
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[(M.Mem.MariaRead << (ROM_SHIFT - 1)) | (Bank[addr >> ROMBANK_SHIFT] << ROMBANK_SHIFT) | (addr & ROMBANK_MASK)];
-        set
-        {
-            var bankNo = addr >> ROMBANK_SHIFT;
-            if (bankNo == 3)
-            {
-                Bank[2] = value & 7;
-            }
-        }
-    }
-
-    #endregion
+        InitialBanks = [0, 6, 0, 7],
+        Windows =
+        [
+            new(0x0000, ROMBANK_SIZE, BankSource.Rom) { Register = 0, MariaOffset = ROM_SIZE >> 1 },
+            new(0x4000, ROMBANK_SIZE, BankSource.Rom) { Register = 1, MariaOffset = ROM_SIZE >> 1 },
+            new(0x8000, ROMBANK_SIZE, BankSource.Rom) { Register = 2, MariaOffset = ROM_SIZE >> 1 },
+            new(0xc000, ROMBANK_SIZE, BankSource.Rom) { Register = 3, MariaOffset = ROM_SIZE >> 1 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0xc000, 0xffff, 2) { Mask = 7 },
+        ],
+    };
 
     public Cart78BB128K(byte[] romBytes)
     {
         LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
     }
 
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROMBANK_SHIFT];
+
     #region Serialization Members
 
     public Cart78BB128K(DeserializationContext input) : base(input)
     {
-        _ = input.CheckVersion(1);
+        var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadBytes());
+        Configure(Scheme);
+        ReadState(input, version);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        ReadState(input, version);
+    }
+
+    void ReadState(DeserializationContext input, int version)
+    {
+        if (version > 1)
+            ReadBanks(input);
+        else
+            SetInitialBanks();
     }
 
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(ROM);
+        output.Write(Banks);
     }
 
     #endregion
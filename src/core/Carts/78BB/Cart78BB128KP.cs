@@ -12,86 +12,73 @@ public sealed class Cart78BB128KP : Cart78BB
     // 0xC000:0x4000   0x1C000:0x4000 ROM CPU readable - 16kb bank 7
     // 0xC000:0x4000   0x3C000:0x4000 ROM Maria readable - 16kb bank 7
 
-    readonly int[] Bank = [0, 6, 0, 7];
-
-    PokeySound _pokeySound = PokeySound.Default;
-
-    #region IDevice Members
-
     const int
         ROM_SHIFT     = 18,
         ROM_SIZE      = 1 << ROM_SHIFT,     // 256 KB, 0x40000
         ROMBANK_SHIFT = 14,
-        ROMBANK_SIZE  = 1 << ROMBANK_SHIFT, //  16 KB, 0x4000
-        ROMBANK_MASK  = ROMBANK_SIZE - 1
+        ROMBANK_SIZE  = 1 << ROMBANK_SHIFT  //  16 KB, 0x4000
         ;
 
-    public override void Reset()
+    static readonly BankswitchScheme Scheme = new()
     {
-        base.Reset();
-        _pokeySound.Reset();
-    }
+        InitialBanks = [0, 6, 0, 7],
+        Windows =
+        [
+            new(0x0000, ROMBANK_SIZE, BankSource.Rom) { Register = 0, MariaOffset = ROM_SIZE >> 1 },
+            new(0x4000, 0x4000,       BankSource.Pokey),
+            new(0x8000, ROMBANK_SIZE, BankSource.Rom) { Register = 2, MariaOffset = ROM_SIZE >> 1 },
+            new(0xc000, ROMBANK_SIZE, BankSource.Rom) { Register = 3, MariaOffset = ROM_SIZE >> 1 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0xc000, 0xffff, 2) { Mask = 7 },
+        ],
+    };
 
-    public override byte this[ushort addr]
+    public Cart78BB128KP(byte[] romBytes)
     {
-        get
-        {
-            var bankNo = addr >> ROMBANK_SHIFT;
-            return bankNo switch
-            {
-                1 => _pokeySound.Read(addr),
-                _ => ROM[M.Mem.MariaRead << (ROM_SHIFT - 1) | Bank[bankNo] << ROMBANK_SHIFT | addr & ROMBANK_MASK]
-            };
-        }
-        set
-        {
-            var bankNo = addr >> ROMBANK_SHIFT;
-            switch (bankNo)
-            {
-                case 1:
-                    _pokeySound.Update(addr, value);
-                    break;
-                case 3:
-                    Bank[2] = value & 7;
-                    break;
-            }
-        }
+        LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
     }
 
-    #endregion
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROMBANK_SHIFT];
 
-    public override void Attach(MachineBase m)
+    #region Serialization Members
+
+    public Cart78BB128KP(DeserializationContext input, MachineBase m) : base(input)
     {
-        base.Attach(m);
-        _pokeySound = new(M);
+        var version = input.CheckVersion(1, 2);
+        LoadRom(input.ReadBytes());
+        Configure(Scheme);
+        Pokey = input.ReadOptionalPokeySound(m);
+        ReadState(input, version);
     }
 
-    public override void StartFrame()
-        => _pokeySound.StartFrame();
-
-    public override void EndFrame()
-        => _pokeySound.EndFrame();
-
-    public Cart78BB128KP(byte[] romBytes)
+    public override void Restore(DeserializationContext input)
     {
-        LoadRom(romBytes, ROM_SIZE);
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        input.RestoreOptional(Pokey);
+        ReadState(input, version);
     }
 
-    #region Serialization Members
-
-    public Cart78BB128KP(DeserializationContext input, MachineBase m) : base(input)
+    void ReadState(DeserializationContext input, int version)
     {
-        _ = input.CheckVersion(1);
-        LoadRom(input.ReadBytes());
-        _pokeySound = input.ReadOptionalPokeySound(m);
+        if (version > 1)
+            ReadBanks(input);
+        else
+            SetInitialBanks();
     }
 
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(ROM);
-        output.WriteOptional(_pokeySound);
+        output.WriteOptional(Pokey);
+        output.Write(Banks);
     }
 
     #endregion
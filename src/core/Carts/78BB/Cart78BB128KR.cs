@@ -14,66 +14,67 @@ public sealed class Cart78BB128KR : Cart78BB
     // 0xC000:0x4000   0x3C000:0x4000 ROM Maria readable - 16kb bank 7
     // 0xC000:0x4000    0x4000:0x4000 RAM CPU writable
 
-    readonly int[] Bank = [0, 6, 0, 7];
-
-    #region IDevice Members
-
     const int
         ROM_SHIFT     = 18,
         ROM_SIZE      = 1 << ROM_SHIFT,     // 256 KB, 0x40000
         ROMBANK_SHIFT = 14,
         ROMBANK_SIZE  = 1 << ROMBANK_SHIFT, //  16 KB, 0x4000
-        ROMBANK_MASK  = ROMBANK_SIZE - 1,
         RAMBANK_SHIFT = 14,
-        RAMBANK_SIZE  = 1 << RAMBANK_SHIFT, //  16 KB, 0x4000
-        RAMBANK_MASK  = RAMBANK_SIZE - 1
+        RAMBANK_SIZE  = 1 << RAMBANK_SHIFT  //  16 KB, 0x4000
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            var bankNo = addr >> ROMBANK_SHIFT;
-            return bankNo switch
-            {
-                1 => RAM[M.Mem.MariaRead << RAMBANK_SHIFT | addr & RAMBANK_MASK],
-                _ => ROM[M.Mem.MariaRead << (ROM_SHIFT - 1) | Bank[bankNo] << ROMBANK_SHIFT | addr & ROMBANK_MASK]
-            };
-        }
-        set
-        {
-            var bankNo = addr >> ROMBANK_SHIFT;
-            switch (bankNo)
-            {
-                case 1:
-                    RAM[addr & RAMBANK_MASK] = value;
-                    break;
-                case 2:
-                    Bank[2] = value & 7;
-                    break;
-                case 3:
-                    RAM[RAMBANK_SIZE | addr & RAMBANK_MASK] = value;
-                    break;
-            }
-        }
-    }
-
-    #endregion
+        InitialBanks = [0, 6, 0, 7],
+        Windows =
+        [
+            new(0x0000, ROMBANK_SIZE, BankSource.Rom) { Register = 0, MariaOffset = ROM_SIZE >> 1 },
+            new(0x8000, ROMBANK_SIZE, BankSource.Rom) { Register = 2, MariaOffset = ROM_SIZE >> 1 },
+            new(0xc000, ROMBANK_SIZE, BankSource.Rom) { Register = 3, MariaOffset = ROM_SIZE >> 1 },
+            new(0x4000, RAMBANK_SIZE, BankSource.Ram, BankAccess.Read) { MariaOffset = RAMBANK_SIZE },
+            new(0x4000, RAMBANK_SIZE, BankSource.Ram, BankAccess.Write),
+            new(0xc000, RAMBANK_SIZE, BankSource.Ram, BankAccess.Write) { Offset = RAMBANK_SIZE },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 2) { Mask = 7 },
+        ],
+    };
 
     public Cart78BB128KR(byte[] romBytes)
     {
         LoadRom(romBytes, ROM_SIZE);
         InitRam(RAMBANK_SIZE << 1);
+        Configure(Scheme);
     }
 
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROMBANK_SHIFT];
+
     #region Serialization Members
 
     public Cart78BB128KR(DeserializationContext input) : base(input)
     {
         _ = input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(4);
-        LoadRam(input.ReadBytes());
+        InitRam(RAMBANK_SIZE << 1);
+        Configure(Scheme);
+        ReadState(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadState(input);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
+        input.ReadIntegersInto(Banks);
+        input.ReadBytesInto(RAM);
+        SetBanks(Banks);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -81,7 +82,7 @@ public sealed class Cart78BB128KR : Cart78BB
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(Bank);
+        output.Write(Banks);
         output.Write(RAM);
     }
 
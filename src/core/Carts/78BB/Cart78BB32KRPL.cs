@@ -13,55 +13,24 @@ public sealed class Cart78BB32KRPL : Cart78BB
     // 0x8000:0x8000    0x8000:0x8000 ROM Maria readable
     // 0xC000:0x4000    0x4000:0x4000 RAM CPU writable
 
-    PokeySound _pokeySound = PokeySound.Default;
-
-    #region IDevice Members
-
     const int
         ROM_SHIFT     = 17,
         ROM_SIZE      = 1 << ROM_SHIFT,      // 128 KB, 0x20000
         RAMBANK_SHIFT = 14,
-        RAMBANK_SIZE  = 1 << RAMBANK_SHIFT,  //  16 KB, 0x4000
-        RAMBANK_MASK  = RAMBANK_SIZE - 1
+        RAMBANK_SIZE  = 1 << RAMBANK_SHIFT   //  16 KB, 0x4000
         ;
 
-    public override void Reset()
+    static readonly BankswitchScheme Scheme = new()
     {
-        base.Reset();
-        _pokeySound.Reset();
-    }
-
-    public override byte this[ushort addr]
-    {
-        get
-        {
-            if ((addr & 0xff00) == 0x0800)
-            {
-                return _pokeySound.Read(addr);
-            }
-            return addr is >= 0x4000 and < 0x8000
-                ? RAM[(M.Mem.MariaRead << RAMBANK_SHIFT) | (addr & RAMBANK_MASK)]
-                : ROM[(M.Mem.MariaRead << (ROM_SHIFT - 1)) | addr];
-        }
-        set
-        {
-            if ((addr & 0xff00) == 0x0800)
-            {
-                _pokeySound.Update(addr, value);
-            }
-            else switch (addr)
-            {
-                case >= 0x4000 and < 0x8000:
-                    RAM[addr & RAMBANK_MASK] = value;
-                    break;
-                case >= 0xc000:
-                    RAM[1 << RAMBANK_SHIFT | (addr & RAMBANK_MASK)] = value;
-                    break;
-            }
-        }
-    }
-
-    #endregion
+        Windows =
+        [
+            new(0x0000, 0x10000,      BankSource.Rom) { MariaOffset = ROM_SIZE >> 1 },
+            new(0x4000, RAMBANK_SIZE, BankSource.Ram, BankAccess.Read) { MariaOffset = RAMBANK_SIZE },
+            new(0x4000, RAMBANK_SIZE, BankSource.Ram, BankAccess.Write),
+            new(0xc000, RAMBANK_SIZE, BankSource.Ram, BankAccess.Write) { Offset = RAMBANK_SIZE },
+            new(0x0800, 0x100,        BankSource.Pokey),
+        ],
+    };
 
     public override bool Map()
     {
@@ -70,22 +39,11 @@ public sealed class Cart78BB32KRPL : Cart78BB
         return true;
     }
 
-    public override void Attach(MachineBase m)
-    {
-        base.Attach(m);
-        _pokeySound = new(M);
-    }
-
-    public override void StartFrame()
-        => _pokeySound.StartFrame();
-
-    public override void EndFrame()
-        => _pokeySound.EndFrame();
-
     public Cart78BB32KRPL(byte[] romBytes)
     {
         LoadRom(romBytes, ROM_SIZE);
         InitRam(RAMBANK_SIZE << 1);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -94,8 +52,19 @@ public sealed class Cart78BB32KRPL : Cart78BB
     {
         _ = input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        LoadRam(input.ReadBytes());
-        _pokeySound = input.ReadOptionalPokeySound(m);
+        InitRam(RAMBANK_SIZE << 1);
+        Configure(Scheme);
+        input.ReadBytesInto(RAM);
+        Pokey = input.ReadOptionalPokeySound(m);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        input.ReadBytesInto(RAM);
+        input.RestoreOptional(Pokey);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -104,7 +73,7 @@ public sealed class Cart78BB32KRPL : Cart78BB
         output.WriteVersion(1);
         output.Write(ROM);
         output.Write(RAM);
-        output.WriteOptional(_pokeySound);
+        output.WriteOptional(Pokey);
     }
 
     #endregion
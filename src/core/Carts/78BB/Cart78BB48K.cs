@@ -9,24 +9,23 @@ public sealed class Cart78BB48K : Cart78BB
     // 0x4000:0xc000    0x0000:0xc000 ROM CPU readable
     // 0x4000:0xc000    0xc000:0xc000 ROM Maria readable
 
-    #region IDevice Members
-
     const int
         ROM_SHIFT = 17,
         ROM_SIZE  = 1 << ROM_SHIFT // 128 KB, 0x20000
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[(M.Mem.MariaRead << (ROM_SHIFT - 1)) | addr];
-        set {}
-    }
-
-    #endregion
+        Windows =
+        [
+            new(0x0000, 0x10000, BankSource.Rom) { MariaOffset = ROM_SIZE >> 1 },
+        ],
+    };
 
     public Cart78BB48K(byte[] romBytes)
     {
         LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -35,6 +34,14 @@ public sealed class Cart78BB48K : Cart78BB
     {
         _ = input.CheckVersion(1);
         LoadRom(input.ReadBytes());
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -9,20 +9,18 @@ public sealed class Cart78BB52K : Cart78BB
     // 0x3000:0xd000    0x0000:0xd000 ROM CPU readable
     // 0x3000:0xd000    0xd000:0xd000 ROM Maria readable
 
-    #region IDevice Members
-
     const int
-       ROM_SHIFT = 17,
-       ROM_SIZE  = 1 << ROM_SHIFT // 128 KB, 0x20000
-       ;
+        ROM_SHIFT = 17,
+        ROM_SIZE  = 1 << ROM_SHIFT // 128 KB, 0x20000
+        ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[(M.Mem.MariaRead << (ROM_SHIFT - 1)) | addr];
-        set {}
-    }
-
-    #endregion
+        Windows =
+        [
+            new(0x0000, 0x10000, BankSource.Rom) { MariaOffset = ROM_SIZE >> 1 },
+        ],
+    };
 
     public override bool Map()
     {
@@ -33,6 +31,7 @@ public sealed class Cart78BB52K : Cart78BB
     public Cart78BB52K(byte[] romBytes)
     {
         LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -41,6 +40,14 @@ public sealed class Cart78BB52K : Cart78BB
     {
         _ = input.CheckVersion(1);
         LoadRom(input.ReadBytes());
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -10,46 +10,19 @@ public sealed class Cart78BB52KP : Cart78BB
     // 0x3000:0xd000    0x0000:0xd000 ROM CPU readable
     // 0x3000:0xd000    0xd000:0xd000 ROM Maria readable
 
-    PokeySound _pokeySound = PokeySound.Default;
-
-    #region IDevice Members
-
     const int
         ROM_SHIFT = 17,
         ROM_SIZE  = 1 << ROM_SHIFT // 128 KB, 0x20000
         ;
 
-    public override void Reset()
-    {
-        base.Reset();
-        _pokeySound.Reset();
-    }
-
-    public override byte this[ushort addr]
-    {
-        get => ROM[(M.Mem.MariaRead << (ROM_SHIFT - 1)) | addr];
-        set
-        {
-            if ((addr & 0xf000) == 0x4000)
-            {
-                _pokeySound.Update(addr, value);
-            }
-        }
-    }
-
-    #endregion
-
-    public override void Attach(MachineBase m)
+    static readonly BankswitchScheme Scheme = new()
     {
-        base.Attach(m);
-        _pokeySound = new(M);
-    }
-
-    public override void StartFrame()
-        => _pokeySound.StartFrame();
-
-    public override void EndFrame()
-        => _pokeySound.EndFrame();
+        Windows =
+        [
+            new(0x0000, 0x10000, BankSource.Rom) { MariaOffset = ROM_SIZE >> 1 },
+            new(0x4000, 0x1000,  BankSource.Pokey, BankAccess.Write),
+        ],
+    };
 
     public override bool Map()
     {
@@ -60,6 +33,7 @@ public sealed class Cart78BB52KP : Cart78BB
     public Cart78BB52KP(byte[] romBytes)
     {
         LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -68,7 +42,16 @@ public sealed class Cart78BB52KP : Cart78BB
     {
         _ = input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        _pokeySound = input.ReadOptionalPokeySound(m);
+        Configure(Scheme);
+        Pokey = input.ReadOptionalPokeySound(m);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        input.RestoreOptional(Pokey);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -76,7 +59,7 @@ public sealed class Cart78BB52KP : Cart78BB
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.WriteOptional(_pokeySound);
+        output.WriteOptional(Pokey);
     }
 
     #endregion
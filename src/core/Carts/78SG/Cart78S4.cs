@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 SuperGame S4 bankswitched cartridge
 /// </summary>
-public sealed class Cart78S4 : Cart
+public sealed class Cart78S4 : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -16,44 +16,36 @@ public sealed class Cart78S4 : Cart
     // Bank6: 0x18000:0x4000
     // Bank7: 0x1c000:0x4000
     //
-    readonly int[] Bank = [0, 2, 0, 3];
-    readonly byte[] RAM = [];
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 14,   // 16 KB, 0x4000
         ROM_SIZE  = 1 << ROM_SHIFT,
-        ROM_MASK  = ROM_SIZE - 1,
         RAM_SHIFT = 13,   //  8 KB, 0x2000
-        RAM_SIZE  = 1 << RAM_SHIFT,
-        RAM_MASK  = RAM_SIZE - 1
+        RAM_SIZE  = 1 << RAM_SHIFT
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            if (RAM.Length > 0 && addr is >= 0x6000 and < 0x6000 + RAM_SIZE)
-            {
-                return RAM[addr & RAM_MASK];
-            }
-            return ROM[(Bank[addr >> ROM_SHIFT] << ROM_SHIFT) | (addr & ROM_MASK)];
-        }
-        set
-        {
-            if (RAM.Length > 0 && addr is >= 0x6000 and < 0x6000 + RAM_SIZE)
-            {
-                RAM[addr & RAM_MASK] = value;
-            }
-            else if (addr >> ROM_SHIFT == 2)
-            {
-                Bank[2] = value & 3;
-            }
-        }
-    }
+        InitialBanks = [0, 2, 0, 3],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x4000, ROM_SIZE, BankSource.Rom) { Register = 1 },
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 2) { Mask = 3 },
+        ],
+    };
 
-    #endregion
+    static readonly BankswitchScheme SchemeWithRAM = new()
+    {
+        InitialBanks = Scheme.InitialBanks,
+        Windows      = [.. Scheme.Windows, new(0x6000, RAM_SIZE, BankSource.Ram)],
+        Hotspots     = Scheme.Hotspots,
+    };
 
     public Cart78S4(byte[] romBytes, bool needRAM)
     {
@@ -63,18 +55,36 @@ public sealed class Cart78S4 : Cart
         }
 
         LoadRom(romBytes, ROM_SIZE * 8);
+        Configure(needRAM ? SchemeWithRAM : Scheme);
     }
 
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
+
     #region Serialization Members
 
     public Cart78S4(DeserializationContext input) : base(input)
     {
         var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(4);
+        var banks = input.ReadIntegers(4);
+        if (version == 1)
+            input.ReadInt32();
+        RAM = input.ReadOptionalBytes(RAM_SIZE);
+        Configure(RAM.Length > 0 ? SchemeWithRAM : Scheme);
+        SetBanks(banks);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        input.ReadIntegersInto(Banks);
         if (version == 1)
             input.ReadInt32();
-        RAM = input.ReadOptionalBytes();
+        input.ReadOptionalBytesInto(RAM);
+        SetBanks(Banks);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -82,7 +92,7 @@ public sealed class Cart78S4 : Cart
         base.GetObjectData(output);
         output.WriteVersion(2);
         output.Write(ROM);
-        output.Write(Bank);
+        output.Write(Banks);
         output.WriteOptional(RAM);
     }
 
@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 SuperGame S9 bankswitched cartridge
 /// </summary>
-public sealed class Cart78S9 : Cart
+public sealed class Cart78S9 : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -17,9 +17,6 @@ public sealed class Cart78S9 : Cart
     // Bank7: 0x1c000:0x4000
     // Bank8: 0x20000:0x4000
     //
-    readonly int[] Bank = [0, 0, 1, 8];
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 14,   // 16 KB, 0x4000
@@ -27,22 +24,30 @@ public sealed class Cart78S9 : Cart
         ROM_MASK  = ROM_SIZE - 1
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[(Bank[addr >> ROM_SHIFT] << ROM_SHIFT) | (addr & ROM_MASK)];
-        set
-        {
-            if (addr >> ROM_SHIFT == 2)
-            {
-                Bank[2] = (value & 7) + 1;
-            }
-        }
-    }
-
-    #endregion
+        InitialBanks = [0, 0, 1, 8],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x4000, ROM_SIZE, BankSource.Rom) { Register = 1 },
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 2) { Mask = 7, Add = 1 },
+        ],
+    };
 
     public Cart78S9(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE * 9);
+    {
+        LoadRom(romBytes, ROM_SIZE * 9);
+        Configure(Scheme);
+    }
+
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
 
     #region Serialization Members
 
@@ -50,7 +55,16 @@ public sealed class Cart78S9 : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(4);
+        Configure(Scheme);
+        ReadBanks(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadBanks(input);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -58,7 +72,7 @@ public sealed class Cart78S9 : Cart
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(Bank);
+        output.Write(Banks);
     }
 
     #endregion
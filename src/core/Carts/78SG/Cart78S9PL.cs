@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 SuperGame S9 bankswitched cartridge w/Pokey at $0450
 /// </summary>
-public sealed class Cart78S9PL : Cart
+public sealed class Cart78S9PL : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -17,10 +17,6 @@ public sealed class Cart78S9PL : Cart
     // Bank7: 0x1c000:0x4000
     // Bank8: 0x20000:0x4000
     //
-    readonly int[] Bank = [0, 0, 1, 8];
-    PokeySound _pokeySound = PokeySound.Default;
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 14,   // 16 KB, 0x4000
@@ -28,43 +24,22 @@ public sealed class Cart78S9PL : Cart
         ROM_MASK  = ROM_SIZE - 1
         ;
 
-    public override byte this[ushort addr]
-    {
-        get => (addr & 0xfff0) switch
-        {
-            0x0450 => _pokeySound.Read(addr),
-            _      => ROM[(Bank[addr >> ROM_SHIFT] << ROM_SHIFT) | (addr & ROM_MASK)]
-        };
-        set
-        {
-            switch (addr & 0xfff0)
-            {
-                case 0x0450:
-                    _pokeySound.Update(addr, value);
-                    break;
-                default:
-                    if (addr >> ROM_SHIFT == 2)
-                    {
-                        Bank[2] = (value & 7) + 1;
-                    }
-                    break;
-            }
-        }
-    }
-
-    #endregion
-
-    public override void Attach(MachineBase m)
+    static readonly BankswitchScheme Scheme = new()
     {
-        base.Attach(m);
-        _pokeySound = new(m);
-    }
-
-    public override void StartFrame()
-        => _pokeySound.StartFrame();
-
-    public override void EndFrame()
-        => _pokeySound.EndFrame();
+        InitialBanks = [0, 0, 1, 8],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x4000, ROM_SIZE, BankSource.Rom) { Register = 1 },
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+            new(0x0450, 0x10,     BankSource.Pokey),
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 2) { Mask = 7, Add = 1 },
+        ],
+    };
 
     public override bool Map()
     {
@@ -74,7 +49,13 @@ public sealed class Cart78S9PL : Cart
     }
 
     public Cart78S9PL(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE * 9);
+    {
+        LoadRom(romBytes, ROM_SIZE * 9);
+        Configure(Scheme);
+    }
+
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
 
     #region Serialization Members
 
@@ -82,8 +63,18 @@ public sealed class Cart78S9PL : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(4);
-        _pokeySound = input.ReadOptionalPokeySound(m);
+        Configure(Scheme);
+        ReadBanks(input);
+        Pokey = input.ReadOptionalPokeySound(m);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadBanks(input);
+        input.RestoreOptional(Pokey);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -91,8 +82,8 @@ public sealed class Cart78S9PL : Cart
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(Bank);
-        output.WriteOptional(_pokeySound);
+        output.Write(Banks);
+        output.WriteOptional(Pokey);
     }
 
     #endregion
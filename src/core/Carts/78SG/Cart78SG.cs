@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 SuperGame bankswitched cartridge
 /// </summary>
-public sealed class Cart78SG : Cart
+public sealed class Cart78SG : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -16,46 +16,36 @@ public sealed class Cart78SG : Cart
     // Bank6: 0x18000:0x4000
     // Bank7: 0x1c000:0x4000
     //
-    readonly int[] Bank = [0, 6, 0, 7];
-    readonly byte[] RAM = [];
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 14,   // 16 KB, 0x4000
         ROM_SIZE  = 1 << ROM_SHIFT,
-        ROM_MASK  = ROM_SIZE - 1,
         RAM_SHIFT = 14,   // 16 KB, 0x4000
-        RAM_SIZE  = 1 << RAM_SHIFT,
-        RAM_MASK  = RAM_SIZE - 1
+        RAM_SIZE  = 1 << RAM_SHIFT
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            var bankNo = addr >> ROM_SHIFT;
-            if (RAM.Length > 0 && bankNo == 1)
-            {
-                return RAM[addr & RAM_MASK];
-            }
-            return ROM[(Bank[bankNo] << ROM_SHIFT) | (addr & ROM_MASK)];
-        }
-        set
-        {
-            var bankNo = addr >> ROM_SHIFT;
-            if (bankNo == 2)
-            {
-                Bank[2] = value & 7;
-            }
-            else if (RAM.Length >= 0x4000 && bankNo == 1)
-            {
-                RAM[addr & RAM_MASK] = value;
-            }
-        }
-    }
+        InitialBanks = [0, 6, 0, 7],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x4000, ROM_SIZE, BankSource.Rom) { Register = 1 },
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 2) { Mask = 7 },
+        ],
+    };
 
-    #endregion
+    static readonly BankswitchScheme SchemeWithRAM = new()
+    {
+        InitialBanks = Scheme.InitialBanks,
+        Windows      = [.. Scheme.Windows, new(0x4000, RAM_SIZE, BankSource.Ram)],
+        Hotspots     = Scheme.Hotspots,
+    };
 
     public Cart78SG(byte[] romBytes, bool needRAM)
     {
@@ -65,18 +55,36 @@ public sealed class Cart78SG : Cart
             RAM = new byte[RAM_SIZE];
         }
         LoadRom(romBytes, ROM_SIZE * 8);
+        Configure(needRAM ? SchemeWithRAM : Scheme);
     }
 
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
+
     #region Serialization Members
 
     public Cart78SG(DeserializationContext input) : base(input)
     {
         var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(4);
+        var banks = input.ReadIntegers(4);
         if (version == 1)
             input.ReadInt32();
         RAM = input.ReadOptionalBytes(RAM_SIZE);
+        Configure(RAM.Length > 0 ? SchemeWithRAM : Scheme);
+        SetBanks(banks);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        input.ReadIntegersInto(Banks);
+        if (version == 1)
+            input.ReadInt32();
+        input.ReadOptionalBytesInto(RAM);
+        SetBanks(Banks);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -84,7 +92,7 @@ public sealed class Cart78SG : Cart
         base.GetObjectData(output);
         output.WriteVersion(2);
         output.Write(ROM);
-        output.Write(Bank);
+        output.Write(Banks);
         output.WriteOptional(RAM);
     }
 
@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 SuperGame bankswitched cartridge w/Pokey at 4000
 /// </summary>
-public sealed class Cart78SGP : Cart
+public sealed class Cart78SGP : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -16,10 +16,6 @@ public sealed class Cart78SGP : Cart
     // Bank6: 0x18000:0x4000
     // Bank7: 0x1c000:0x4000
     //
-    readonly int[] _bank = [0, 0, 0, 7];
-    PokeySound _pokeySound = PokeySound.Default;
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 14,   // 16 KB, 0x4000
@@ -27,54 +23,30 @@ public sealed class Cart78SGP : Cart
         ROM_MASK  = ROM_SIZE - 1
         ;
 
-    public override void Reset()
-    {
-        base.Reset();
-        _pokeySound.Reset();
-    }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            var bankNo = addr >> ROM_SHIFT;
-            return bankNo switch
-            {
-                1 => _pokeySound.Read(addr),
-                _ => ROM[(_bank[bankNo] << ROM_SHIFT) | (addr & ROM_MASK)]
-            };
-        }
-        set
-        {
-            var bankNo = addr >> ROM_SHIFT;
-            switch (bankNo)
-            {
-                case 1:
-                    _pokeySound.Update(addr, value);
-                    break;
-                case 2:
-                    _bank[2] = value & 7;
-                    break;
-            }
-        }
-    }
-
-    #endregion
+        InitialBanks = [0, 0, 0, 7],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x4000, 0x4000,   BankSource.Pokey),
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 2) { Mask = 7 },
+        ],
+    };
 
-    public override void Attach(MachineBase m)
+    public Cart78SGP(byte[] romBytes)
     {
-        base.Attach(m);
-        _pokeySound = new(M);
+        LoadRom(romBytes, ROM_SIZE * 8);
+        Configure(Scheme);
     }
 
-    public override void StartFrame()
-        => _pokeySound.StartFrame();
-
-    public override void EndFrame()
-        => _pokeySound.EndFrame();
-
-    public Cart78SGP(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE * 8);
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
 
     #region Serialization Members
 
@@ -82,8 +54,18 @@ public sealed class Cart78SGP : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        _bank = input.ReadIntegers(4);
-        _pokeySound = input.ReadOptionalPokeySound(m);
+        Configure(Scheme);
+        ReadBanks(input);
+        Pokey = input.ReadOptionalPokeySound(m);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadBanks(input);
+        input.RestoreOptional(Pokey);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -91,8 +73,8 @@ public sealed class Cart78SGP : Cart
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(_bank);
-        output.WriteOptional(_pokeySound);
+        output.Write(Banks);
+        output.WriteOptional(Pokey);
     }
 
     #endregion
@@ -0,0 +1,112 @@
+/*
+ * BankswitchScheme.cs
+ *
+ * The address decoding of a bankswitched cart, declared as data for BankswitchedCart.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+namespace EMU7800.Core;
+
+public enum BankSource
+{
+    Rom,
+    Ram,
+    Pokey,
+}
+
+public enum BankAccess
+{
+    Read      = 1,
+    Write     = 2,
+    ReadWrite = Read | Write,
+}
+
+public enum HotspotTrigger
+{
+    /// <summary>
+    /// Reading or writing an address in the range selects the bank by the address.
+    /// </summary>
+    AddressOnAccess,
+    /// <summary>
+    /// Writing an address in the range selects the bank by the address.
+    /// </summary>
+    AddressOnWrite,
+    /// <summary>
+    /// Writing an address in the range selects the bank by the value written.
+    /// </summary>
+    ValueOnWrite,
+}
+
+/// <summary>
+/// A range of cart addresses backed by ROM, RAM or the cart's POKEY. Where windows overlap, the last
+/// one declared applies. Writes to a ROM window are ignored.
+/// </summary>
+/// <param name="Start">First cart address, after the scheme's address mask is applied.</param>
+/// <param name="Size">Length in bytes.</param>
+public readonly record struct BankWindow(int Start, int Size, BankSource Source, BankAccess Access = BankAccess.ReadWrite)
+{
+    /// <summary>
+    /// The bank register selecting the bank, or -1 when <see cref="Bank"/> is fixed.
+    /// </summary>
+    public int Register { get; init; } = -1;
+
+    public int Bank { get; init; }
+
+    /// <summary>
+    /// Bytes per bank number; the window size when zero.
+    /// </summary>
+    public int BankSize { get; init; }
+
+    /// <summary>
+    /// Added to the source address, e.g. to place a second RAM window after the first.
+    /// </summary>
+    public int Offset { get; init; }
+
+    /// <summary>
+    /// Added to the source address of reads made by Maria rather than the CPU, for Bankset carts.
+    /// </summary>
+    public int MariaOffset { get; init; }
+
+    /// <summary>
+    /// When not -1, the window applies only while this register holds <see cref="ActiveBank"/>.
+    /// </summary>
+    public int ActiveRegister { get; init; } = -1;
+
+    public int ActiveBank { get; init; }
+}
+
+/// <summary>
+/// Addresses that load a bank register. The bank is ((x + Bias) &amp; Mask) &lt;&lt; Shift + Add, modulo
+/// <see cref="Modulo"/> when set, where x is the value written or the address less <see cref="First"/>.
+/// </summary>
+public readonly record struct Hotspot(HotspotTrigger Trigger, int First, int Last, int Register)
+{
+    public int Bias { get; init; }
+    public int Mask { get; init; } = -1;
+    public int Shift { get; init; }
+    public int Add { get; init; }
+    public int Modulo { get; init; }
+}
+
+public sealed class BankswitchScheme
+{
+    /// <summary>
+    /// Applied to every address first; address lines the cart does not decode.
+    /// </summary>
+    public int AddressMask { get; init; } = 0xffff;
+
+    /// <summary>
+    /// Bank register contents at power on.
+    /// </summary>
+    public int[] InitialBanks { get; init; } = [];
+
+    /// <summary>
+    /// Whether a console reset restores <see cref="InitialBanks"/>.
+    /// </summary>
+    public bool ResetBanks { get; init; }
+
+    public BankWindow[] Windows { get; init; } = [];
+
+    public Hotspot[] Hotspots { get; init; } = [];
+}
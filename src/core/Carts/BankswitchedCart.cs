@@ -0,0 +1,396 @@
+/*
+ * BankswitchedCart.cs
+ *
+ * A cart whose address decoding is declared by a BankswitchScheme. The cart's address window is
+ * divided into pages no larger than the smallest window, and each page holds a pointer into ROM or
+ * RAM for reads and for writes. The pointers are recomputed only when a hotspot loads a bank
+ * register, so an access is a range check for hotspots and POKEY and then an indexed load.
+ * Everything derived from the scheme alone is computed once per scheme and shared by its carts.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public abstract class BankswitchedCart : Cart
+{
+    #region Fields
+
+    static readonly ConditionalWeakTable<BankswitchScheme, Layout> Layouts = new();
+
+    BankswitchScheme _scheme = new();
+    Layout _layout = Layout.Empty;
+    int _addressMask, _pageShift, _pageMask, _pageCount;
+    bool _mariaOffsets;
+
+    // Read pages for CPU reads, followed by those for Maria reads on Bankset carts.
+    byte[][] _readPages = [];
+    int[] _readOffsets = [];
+    byte[]?[] _writePages = [];
+    int[] _writeOffsets = [];
+
+    HotspotMap _readHotspots = HotspotMap.Empty, _writeHotspots = HotspotMap.Empty;
+    int _pokeyReadFirst, _pokeyReadSize, _pokeyWriteFirst, _pokeyWriteSize;
+
+    #endregion
+
+    /// <summary>
+    /// The bank registers loaded by the scheme's hotspots.
+    /// </summary>
+    protected int[] Banks { get; private set; } = [];
+
+    protected byte[] RAM { get; set; } = [];
+
+    protected PokeySound Pokey { get; set; } = PokeySound.Default;
+
+    bool HasPokey => _pokeyReadSize > 0 || _pokeyWriteSize > 0;
+
+    #region IDevice Members
+
+    public override void Reset()
+    {
+        if (_scheme.ResetBanks)
+            SetBanks(_scheme.InitialBanks);
+        if (HasPokey)
+            Pokey.Reset();
+    }
+
+    public sealed override byte this[ushort addr]
+    {
+        get
+        {
+            var a = addr & _addressMask;
+            if ((uint)(a - _readHotspots.First) < (uint)_readHotspots.Map.Length)
+                ApplyHotspots(_readHotspots, a, 0);
+            if ((uint)(a - _pokeyReadFirst) < (uint)_pokeyReadSize)
+                return Pokey.Read(addr);
+            var i = a >> _pageShift;
+            if (_mariaOffsets)
+                i += M.Mem.MariaRead * _pageCount;
+            return _readPages[i][_readOffsets[i] + (a & _pageMask)];
+        }
+        set
+        {
+            var a = addr & _addressMask;
+            if ((uint)(a - _writeHotspots.First) < (uint)_writeHotspots.Map.Length)
+                ApplyHotspots(_writeHotspots, a, value);
+            if ((uint)(a - _pokeyWriteFirst) < (uint)_pokeyWriteSize)
+            {
+                Pokey.Update(addr, value);
+                return;
+            }
+            var i = a >> _pageShift;
+            var page = _writePages[i];
+            if (page is not null)
+                page[_writeOffsets[i] + (a & _pageMask)] = value;
+        }
+    }
+
+    #endregion
+
+    public override void Attach(MachineBase m)
+    {
+        base.Attach(m);
+        if (HasPokey && Pokey == PokeySound.Default)
+            Pokey = new(M);
+    }
+
+    public override void StartFrame()
+    {
+        if (HasPokey)
+            Pokey.StartFrame();
+    }
+
+    public override void EndFrame()
+    {
+        if (HasPokey)
+            Pokey.EndFrame();
+    }
+
+    public override ReadOnlySpan<byte> RAMContents
+        => RAM;
+
+    /// <summary>
+    /// Builds the page tables for the scheme with the initial banks. Call once ROM and RAM are loaded.
+    /// </summary>
+    protected void Configure(BankswitchScheme scheme)
+    {
+        var layout = Layouts.GetValue(scheme, s => new(s));
+
+        _scheme = scheme;
+        _layout = layout;
+        _addressMask = scheme.AddressMask;
+        _pageShift = layout.PageShift;
+        _pageMask = (1 << layout.PageShift) - 1;
+        _pageCount = layout.PageWindows.Length;
+        _mariaOffsets = layout.MariaOffsets;
+        (_pokeyReadFirst, _pokeyReadSize) = (layout.PokeyReadFirst, layout.PokeyReadSize);
+        (_pokeyWriteFirst, _pokeyWriteSize) = (layout.PokeyWriteFirst, layout.PokeyWriteSize);
+        _readHotspots = layout.ReadHotspots;
+        _writeHotspots = layout.WriteHotspots;
+
+        var planes = _mariaOffsets ? 2 : 1;
+        _readPages = new byte[_pageCount * planes][];
+        _readOffsets = new int[_pageCount * planes];
+        _writePages = new byte[_pageCount][];
+        _writeOffsets = new int[_pageCount];
+
+        Banks = new int[scheme.InitialBanks.Length];
+        SetBanks(scheme.InitialBanks);
+    }
+
+    /// <summary>
+    /// Loads the bank registers, e.g. from a saved state.
+    /// </summary>
+    protected void SetBanks(ReadOnlySpan<int> banks)
+    {
+        ArgumentException.ThrowIf(banks.Length != Banks.Length, "Unexpected bank register count");
+        banks.CopyTo(Banks);
+        for (var page = 0; page < _pageCount; page++)
+            MapPage(page);
+    }
+
+    #region Constructors
+
+    protected BankswitchedCart() {}
+
+    #endregion
+
+    #region Serialization Members
+
+    protected BankswitchedCart(DeserializationContext input) : base(input) {}
+
+    /// <summary>
+    /// Reads the bank registers into place and maps them.
+    /// </summary>
+    protected void ReadBanks(DeserializationContext input)
+    {
+        input.ReadIntegersInto(Banks);
+        SetBanks(Banks);
+    }
+
+    /// <summary>
+    /// Maps the scheme's initial banks, for saved states from before the bank registers were written.
+    /// </summary>
+    protected void SetInitialBanks()
+        => SetBanks(_scheme.InitialBanks);
+
+    #endregion
+
+    #region Helpers
+
+    void ApplyHotspots(HotspotMap map, int a, byte value)
+    {
+        var group = map.Map[a - map.First];
+        if (group == 0)
+            return;
+        foreach (var h in map.Groups[group - 1])
+        {
+            var x = h.Trigger == HotspotTrigger.ValueOnWrite ? value : a - h.First;
+            var bank = (((x + h.Bias) & h.Mask) << h.Shift) + h.Add;
+            if (h.Modulo > 0)
+                bank %= h.Modulo;
+            if (Banks[h.Register] == bank)
+                continue;
+            Banks[h.Register] = bank;
+            foreach (var page in _layout.RegisterPages[h.Register])
+                MapPage(page);
+        }
+    }
+
+    void MapPage(int page)
+    {
+        var pageStart = page << _pageShift;
+        var windows = _layout.PageWindows[page];
+
+        _readPages[page] = _layout.OpenBus;
+        _readOffsets[page] = 0;
+        if (_mariaOffsets)
+        {
+            _readPages[page + _pageCount] = _layout.OpenBus;
+            _readOffsets[page + _pageCount] = 0;
+        }
+        _writePages[page] = null;
+        _writeOffsets[page] = 0;
+
+        bool read = false, write = false;
+        for (var k = windows.Length - 1; k >= 0 && !(read && write); k--)
+        {
+            var w = windows[k];
+            if (w.ActiveRegister >= 0 && Banks[w.ActiveRegister] != w.ActiveBank)
+                continue;
+
+            var source = w.Source == BankSource.Rom ? ROM : RAM;
+            var bank = w.Register >= 0 ? Banks[w.Register] : w.Bank;
+            var offset = w.Offset + bank * (w.BankSize > 0 ? w.BankSize : w.Size) + pageStart - w.Start;
+
+            if (!read && (w.Access & BankAccess.Read) != 0)
+            {
+                read = true;
+                MapRead(page, source, offset);
+                if (_mariaOffsets)
+                    MapRead(page + _pageCount, source, offset + w.MariaOffset);
+            }
+            if (!write && (w.Access & BankAccess.Write) != 0)
+            {
+                write = true;
+                if (w.Source == BankSource.Ram && offset >= 0 && offset + _pageMask < source.Length)
+                {
+                    _writePages[page] = source;
+                    _writeOffsets[page] = offset;
+                }
+            }
+        }
+    }
+
+    void MapRead(int i, byte[] source, int offset)
+    {
+        // Banks beyond the end of the source read as open bus rather than fault.
+        if (offset >= 0 && offset + _pageMask < source.Length)
+        {
+            _readPages[i] = source;
+            _readOffsets[i] = offset;
+        }
+    }
+
+    /// <summary>
+    /// The page size and tables that follow from a scheme alone.
+    /// </summary>
+    sealed class Layout
+    {
+        public static readonly Layout Empty = new(new() { AddressMask = 0 });
+
+        public readonly int PageShift;
+        public readonly bool MariaOffsets;
+        public readonly byte[] OpenBus;
+
+        // Windows covering each page in declaration order, and the pages each register affects.
+        public readonly BankWindow[][] PageWindows;
+        public readonly int[][] RegisterPages;
+
+        public readonly HotspotMap ReadHotspots, WriteHotspots;
+        public readonly int PokeyReadFirst, PokeyReadSize, PokeyWriteFirst, PokeyWriteSize;
+
+        public Layout(BankswitchScheme scheme)
+        {
+            var windows = scheme.Windows;
+            var addressBits = BitOperations.PopCount((uint)scheme.AddressMask);
+            ArgumentException.ThrowIf(scheme.AddressMask + 1 != 1 << addressBits, "Address mask must be contiguous low bits");
+
+            // Pages are as large as the alignment of every ROM and RAM window allows.
+            var pageShift = addressBits;
+            BankWindow? pokeyRead = null, pokeyWrite = null;
+            foreach (var w in windows)
+            {
+                ArgumentException.ThrowIf(w.Size <= 0 || w.Start < 0 || w.Start + w.Size > scheme.AddressMask + 1, "Window outside the address mask");
+                if (w.Source == BankSource.Pokey)
+                {
+                    if ((w.Access & BankAccess.Read) != 0)
+                    {
+                        ArgumentException.ThrowIf(pokeyRead is not null, "At most one POKEY read window");
+                        pokeyRead = w;
+                    }
+                    if ((w.Access & BankAccess.Write) != 0)
+                    {
+                        ArgumentException.ThrowIf(pokeyWrite is not null, "At most one POKEY write window");
+                        pokeyWrite = w;
+                    }
+                    continue;
+                }
+                pageShift = Math.Min(pageShift, BitOperations.TrailingZeroCount(w.Start | w.Size));
+            }
+
+            PageShift = pageShift;
+            MariaOffsets = Array.Exists(windows, w => w.MariaOffset != 0);
+            OpenBus = new byte[1 << pageShift];
+
+            (PokeyReadFirst, PokeyReadSize) = pokeyRead is { } pr ? (pr.Start, pr.Size) : (0, 0);
+            (PokeyWriteFirst, PokeyWriteSize) = pokeyWrite is { } pw ? (pw.Start, pw.Size) : (0, 0);
+
+            var pageCount = 1 << (addressBits - pageShift);
+            var pageWindows = new List<BankWindow>[pageCount];
+            for (var page = 0; page < pageCount; page++)
+                pageWindows[page] = [];
+            var registerCount = scheme.InitialBanks.Length;
+            var registerPages = new SortedSet<int>[registerCount];
+            for (var r = 0; r < registerCount; r++)
+                registerPages[r] = [];
+
+            foreach (var w in windows)
+            {
+                if (w.Source == BankSource.Pokey)
+                    continue;
+                ArgumentException.ThrowIf(w.Register >= registerCount || w.ActiveRegister >= registerCount, "Window refers to an undeclared bank register");
+                for (var page = w.Start >> pageShift; page < (w.Start + w.Size) >> pageShift; page++)
+                {
+                    pageWindows[page].Add(w);
+                    if (w.Register >= 0)
+                        registerPages[w.Register].Add(page);
+                    if (w.ActiveRegister >= 0)
+                        registerPages[w.ActiveRegister].Add(page);
+                }
+            }
+
+            PageWindows = Array.ConvertAll(pageWindows, l => l.ToArray());
+            RegisterPages = Array.ConvertAll(registerPages, s => s.ToArray());
+
+            foreach (var h in scheme.Hotspots)
+                ArgumentException.ThrowIf(h.Register < 0 || h.Register >= registerCount || h.First > h.Last, "Malformed hotspot");
+            ReadHotspots = new(Array.FindAll(scheme.Hotspots, h => h.Trigger == HotspotTrigger.AddressOnAccess));
+            WriteHotspots = new(scheme.Hotspots);
+        }
+    }
+
+    /// <summary>
+    /// Hotspots indexed by address over the range they span, for a single bounds check per access.
+    /// </summary>
+    readonly struct HotspotMap
+    {
+        public static readonly HotspotMap Empty = new([]);
+
+        public readonly int First;
+        public readonly byte[] Map = [];
+        public readonly Hotspot[][] Groups = [];
+
+        public HotspotMap(Hotspot[] hotspots)
+        {
+            if (hotspots.Length == 0)
+                return;
+
+            var first = int.MaxValue;
+            var last = int.MinValue;
+            foreach (var h in hotspots)
+            {
+                first = Math.Min(first, h.First);
+                last = Math.Max(last, h.Last);
+            }
+
+            // Hotspots declared over the same range form a group that applies together.
+            var groups = new List<Hotspot[]>();
+            var map = new byte[last - first + 1];
+            foreach (var range in hotspots.DistinctBy(h => (h.First, h.Last)))
+            {
+                groups.Add(Array.FindAll(hotspots, h => h.First == range.First && h.Last == range.Last));
+                ArgumentException.ThrowIf(groups.Count > byte.MaxValue, "Too many hotspot ranges");
+                for (var a = range.First; a <= range.Last; a++)
+                {
+                    ArgumentException.ThrowIf(map[a - first] != 0, "Overlapping hotspots");
+                    map[a - first] = (byte)groups.Count;
+                }
+            }
+
+            First = first;
+            Map = map;
+            Groups = [.. groups];
+        }
+    }
+
+    #endregion
+}
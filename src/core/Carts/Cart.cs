@@ -41,6 +41,24 @@ public abstract class Cart : IDevice
     protected internal virtual bool RequestSnooping
         => false;
 
+    /// <summary>
+    /// The music generator of a DPC cart, for TIASound to render the channels the game relays it through.
+    /// </summary>
+    protected internal virtual DPCMusic? Music
+        => null;
+
+    /// <summary>
+    /// Reports the ROM bank currently mapped at the specified address, for tracing purposes.
+    /// </summary>
+    public virtual byte GetBankNo(ushort addr)
+        => 0;
+
+    /// <summary>
+    /// The contents of any RAM on the cart, empty when there is none.
+    /// </summary>
+    public virtual ReadOnlySpan<byte> RAMContents
+        => [];
+
     /// <summary>
     /// Creates an instance of the specified cart.
     /// </summary>
@@ -137,6 +155,12 @@ public abstract class Cart : IDevice
     protected Cart(DeserializationContext input)
         => input.CheckVersion(1);
 
+    /// <summary>
+    /// Reads back into this cart what <see cref="GetObjectData"/> wrote, leaving everything else as deserialization would.
+    /// </summary>
+    public virtual void Restore(DeserializationContext input)
+        => input.CheckVersion(1);
+
     public virtual void GetObjectData(SerializationContext output)
         => output.WriteVersion(1);
 
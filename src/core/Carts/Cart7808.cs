@@ -3,31 +3,33 @@
 /// <summary>
 /// Atari 7800 non-bankswitched 8KB cartridge
 /// </summary>
-public sealed class Cart7808 : Cart
+public sealed class Cart7808 : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
     // 0x0000:0x2000              0xE000:0x2000 (repeated downward to 0x4000)
     //
 
-    #region IDevice Members
-
     const int
         ROM_SHIFT = 13,  // 8 KB, 0x2000
         ROM_SIZE  = 1 << ROM_SHIFT,
         ROM_MASK  = ROM_SIZE - 1
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[addr & ROM_MASK];
-        set {}
-    }
-
-    #endregion
+        AddressMask = ROM_MASK,
+        Windows =
+        [
+            new(0, ROM_SIZE, BankSource.Rom),
+        ],
+    };
 
     public Cart7808(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE);
+    {
+        LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
+    }
 
     #region Serialization Members
 
@@ -35,6 +37,14 @@ public sealed class Cart7808 : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(ROM_SIZE), ROM_SIZE);
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -3,16 +3,13 @@
 /// <summary>
 /// Atari 7800 non-bankswitched 32KB cartridge w/Pokey at $0450
 /// </summary>
-public sealed class Cart7832PL : Cart
+public sealed class Cart7832PL : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
     //                            0x0450:0x045f Pokey
     // 0x0000:0x8000              0x8000:0x8000
     //
-    PokeySound _pokeySound = PokeySound.Default;
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 15, // 32 KB rom size
@@ -20,43 +17,15 @@ public sealed class Cart7832PL : Cart
         ROM_MASK  = ROM_SIZE - 1
         ;
 
-    public override void Reset()
-    {
-        base.Reset();
-        _pokeySound.Reset();
-    }
-
-    public override byte this[ushort addr]
-    {
-        get => (addr & 0xfff0) switch
-        {
-            0x0450 => _pokeySound.Read(addr),
-            _      => ROM[addr & ROM_MASK]
-        };
-        set
-        {
-            switch (addr & 0xfff0)
-            {
-                case 0x0450:
-                    _pokeySound.Update(addr, value);
-                    break;
-            }
-        }
-    }
-
-    #endregion
-
-    public override void Attach(MachineBase m)
+    static readonly BankswitchScheme Scheme = new()
     {
-        base.Attach(m);
-        _pokeySound = new(m);
-    }
-
-    public override void StartFrame()
-        => _pokeySound.StartFrame();
-
-    public override void EndFrame()
-        => _pokeySound.EndFrame();
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom),
+            new(0x8000, ROM_SIZE, BankSource.Rom),
+            new(0x0450, 0x10, BankSource.Pokey),
+        ],
+    };
 
     public override bool Map()
     {
@@ -68,7 +37,10 @@ public sealed class Cart7832PL : Cart
     #region Constructors
 
     public Cart7832PL(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE);
+    {
+        LoadRom(romBytes, ROM_SIZE);
+        Configure(Scheme);
+    }
 
     #endregion
 
@@ -78,7 +50,16 @@ public sealed class Cart7832PL : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(ROM_SIZE), ROM_SIZE);
-        _pokeySound = input.ReadOptionalPokeySound(m);
+        Configure(Scheme);
+        Pokey = input.ReadOptionalPokeySound(m);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        input.RestoreOptional(Pokey);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -86,7 +67,7 @@ public sealed class Cart7832PL : Cart
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.WriteOptional(_pokeySound);
+        output.WriteOptional(Pokey);
     }
 
     #endregion
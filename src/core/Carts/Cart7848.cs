@@ -3,31 +3,32 @@
 /// <summary>
 /// Atari 7800 non-bankswitched 48KB cartridge
 /// </summary>
-public sealed class Cart7848 : Cart
+public sealed class Cart7848 : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
     // 0x0000:0xc000              0x4000:0xc000
     //
 
-    #region IDevice Members
-
     const int
         ROM_SHIFT = 14, // 16 KB rom size
         ROM_SIZE  = 1 << ROM_SHIFT,
         ROM_MASK  = ROM_SIZE - 1
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[((addr >> ROM_SHIFT) - 1) << ROM_SHIFT | (addr & ROM_MASK)];
-        set {}
-    }
-
-    #endregion
+        Windows =
+        [
+            new(0x4000, ROM_SIZE * 3, BankSource.Rom),
+        ],
+    };
 
     public Cart7848(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE * 3);
+    {
+        LoadRom(romBytes, ROM_SIZE * 3);
+        Configure(Scheme);
+    }
 
     #region Serialization Members
 
@@ -35,6 +36,14 @@ public sealed class Cart7848 : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(ROM_SIZE * 3), ROM_SIZE * 3);
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
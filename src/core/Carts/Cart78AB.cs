@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 Absolute bankswitched cartridge
 /// </summary>
-public sealed class Cart78AB : Cart
+public sealed class Cart78AB : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -12,32 +12,36 @@ public sealed class Cart78AB : Cart
     // Bank2: 0x08000:0x4000      0x8000:0x4000  Bank2
     // Bank3: 0x0c000:0x4000      0xc000:0x4000  Bank3
     //
-    readonly int[] Bank = [0, 0, 2, 3];
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 14, // 16 KB rom size
-        ROM_SIZE  = 1 << ROM_SHIFT,
-        ROM_MASK  = ROM_SIZE - 1
+        ROM_SIZE  = 1 << ROM_SHIFT
         ;
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[(Bank[addr >> ROM_SHIFT] << ROM_SHIFT) | (addr & ROM_MASK)];
-        set
-        {
-            if (addr >> ROM_SHIFT == 2)
-            {
-                Bank[1] = (value - 1) & 1;
-            }
-        }
-    }
-
-    #endregion
+        InitialBanks = [0, 0, 2, 3],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x4000, ROM_SIZE, BankSource.Rom) { Register = 1 },
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.ValueOnWrite, 0x8000, 0xbfff, 1) { Bias = -1, Mask = 1 },
+        ],
+    };
 
     public Cart78AB(byte[] romBytes)
-        =>  LoadRom(romBytes, 0x10000);
+    {
+        LoadRom(romBytes, 0x10000);
+        Configure(Scheme);
+    }
+
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
 
     #region Serialization Members
 
@@ -45,7 +49,21 @@ public sealed class Cart78AB : Cart
     {
         var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(4);
+        Configure(Scheme);
+        ReadState(input, version);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        ReadState(input, version);
+    }
+
+    void ReadState(DeserializationContext input, int version)
+    {
+        ReadBanks(input);
         if (version == 1)
             input.ReadInt32();
     }
@@ -55,7 +73,7 @@ public sealed class Cart78AB : Cart
         base.GetObjectData(output);
         output.WriteVersion(2);
         output.Write(ROM);
-        output.Write(Bank);
+        output.Write(Banks);
     }
 
     #endregion
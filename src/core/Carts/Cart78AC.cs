@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari 7800 Activision bankswitched cartridge
 /// </summary>
-public sealed class Cart78AC : Cart
+public sealed class Cart78AC : BankswitchedCart
 {
     //
     // Cart Format                 Mapping to ROM Address Space
@@ -26,30 +26,41 @@ public sealed class Cart78AC : Cart
     //
     // Banks are actually 16KB, but handled as 8KB for implementation ease.
     //
-    readonly int[] Bank = [0, 0, 13, 12, 15, 0, 1, 14];
-
-    #region IDevice Members
 
     const int
         ROM_SHIFT = 13,  // 8 KB, 0x2000
-        ROM_SIZE  = 1 << ROM_SHIFT,
-        ROM_MASK  = ROM_SIZE - 1
+        ROM_SIZE  = 1 << ROM_SHIFT
         ;
 
-    public override byte this[ushort addr] {
-        get => ROM[(Bank[addr >> ROM_SHIFT] << ROM_SHIFT) | (addr & ROM_MASK)];
-        set {
-            if ((addr & 0xfff0) == 0xff80) {
-                Bank[5] = (addr & 7) << 1;
-                Bank[6] = Bank[5] + 1;
-            }
-        }
-    }
-
-    #endregion
+    static readonly BankswitchScheme Scheme = new()
+    {
+        InitialBanks = [0, 0, 13, 12, 15, 0, 1, 14],
+        Windows =
+        [
+            new(0x0000, ROM_SIZE, BankSource.Rom) { Register = 0 },
+            new(0x2000, ROM_SIZE, BankSource.Rom) { Register = 1 },
+            new(0x4000, ROM_SIZE, BankSource.Rom) { Register = 2 },
+            new(0x6000, ROM_SIZE, BankSource.Rom) { Register = 3 },
+            new(0x8000, ROM_SIZE, BankSource.Rom) { Register = 4 },
+            new(0xa000, ROM_SIZE, BankSource.Rom) { Register = 5 },
+            new(0xc000, ROM_SIZE, BankSource.Rom) { Register = 6 },
+            new(0xe000, ROM_SIZE, BankSource.Rom) { Register = 7 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnWrite, 0xff80, 0xff8f, 5) { Mask = 7, Shift = 1 },
+            new(HotspotTrigger.AddressOnWrite, 0xff80, 0xff8f, 6) { Mask = 7, Shift = 1, Add = 1 },
+        ],
+    };
 
     public Cart78AC(byte[] romBytes)
-        => LoadRom(romBytes, ROM_SIZE * 16);
+    {
+        LoadRom(romBytes, ROM_SIZE * 16);
+        Configure(Scheme);
+    }
+
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[addr >> ROM_SHIFT];
 
     #region Serialization Members
 
@@ -57,7 +68,16 @@ public sealed class Cart78AC : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadBytes());
-        Bank = input.ReadIntegers(8);
+        Configure(Scheme);
+        ReadBanks(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadBanks(input);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -65,7 +85,7 @@ public sealed class Cart78AC : Cart
         base.GetObjectData(output);
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(Bank);
+        output.Write(Banks);
     }
 
     #endregion
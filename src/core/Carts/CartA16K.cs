@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari standard 16KB bankswitched carts
 /// </summary>
-public sealed class CartA16K : Cart
+public sealed class CartA16K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -12,48 +12,30 @@ public sealed class CartA16K : Cart
     // Bank3: 0x2000:0x1000
     // Bank4: 0x3000:0x1000
     //
-    ushort BankBaseAddr;
 
-    #region IDevice Members
-
-    public override void Reset()
-    {
-        BankBaseAddr = GetBankBaseAddr(0);
-    }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            addr &= 0x0fff;
-            UpdateBank(addr);
-            return ROM[BankBaseAddr + addr];
-        }
-        set
-        {
-            addr &= 0x0fff;
-            UpdateBank(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [0],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom) { Register = 0 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xff6, 0xff9, 0),
+        ],
+    };
 
     public CartA16K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x4000);
-        BankBaseAddr = GetBankBaseAddr(0);
+        Configure(Scheme);
     }
 
-    void UpdateBank(ushort addr)
-    {
-        if (addr is >= 0xff6 and <= 0xff9)
-        {
-            BankBaseAddr = GetBankBaseAddr(addr - 0xff6);
-        }
-    }
-
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 12);  // Multiply by 4096
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[0];
 
     #region Serialization Members
 
@@ -61,7 +43,16 @@ public sealed class CartA16K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x4000), 0x4000);
-        BankBaseAddr = input.ReadUInt16();
+        Configure(Scheme);
+        SetBanks([input.ReadUInt16() >> 12]);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        SetBanks([input.ReadUInt16() >> 12]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -70,7 +61,7 @@ public sealed class CartA16K : Cart
 
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(BankBaseAddr);
+        output.Write((ushort)(Banks[0] << 12));
     }
 
     #endregion
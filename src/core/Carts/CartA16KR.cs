@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari standard 16KB bankswitched carts with 128 bytes of RAM
 /// </summary>
-public sealed class CartA16KR : Cart
+public sealed class CartA16KR : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -15,75 +15,70 @@ public sealed class CartA16KR : Cart
     //                            0x1000:0x0080  RAM write port
     //                            0x1080:0x0080  RAM read port
     //
-    ushort BankBaseAddr;
-    readonly byte[] RAM = new byte[0x80];
 
-    #region IDevice Members
-
-    public override void Reset()
-    {
-        BankBaseAddr = GetBankBaseAddr(0);
-    }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            addr &= 0xfff;
-            if (addr is < 0x0100 and >= 0x0080)
-            {
-                return RAM[addr & 0x7f];
-            }
-            UpdateBank(addr);
-            return ROM[BankBaseAddr + addr];
-        }
-        set
-        {
-            addr &= 0xfff;
-            if (addr < 0x0080)
-            {
-                RAM[addr & 0x7f] = value;
-                return;
-            }
-            UpdateBank(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [0],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom) { Register = 0 },
+            new(0x0080, 0x0080, BankSource.Ram, BankAccess.Read),
+            new(0x0000, 0x0080, BankSource.Ram, BankAccess.Write),
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xff6, 0xff9, 0),
+        ],
+    };
 
     public CartA16KR(byte[] romBytes)
     {
         LoadRom(romBytes, 0x4000);
-        BankBaseAddr = GetBankBaseAddr(0);
-    }
-
-    void UpdateBank(ushort addr)
-    {
-        if (addr is >= 0xff6 and <= 0xff9)
-        {
-            BankBaseAddr = GetBankBaseAddr(addr - 0xff6);
-        }
+        RAM = new byte[0x80];
+        Configure(Scheme);
     }
 
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 12);  // Multiply by 4096
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[0];
 
     #region Serialization Members
 
     public CartA16KR(DeserializationContext input) : base(input)
     {
-        input.CheckVersion(1);
+        var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadExpectedBytes(0x4000), 0x4000);
-        BankBaseAddr = input.ReadUInt16();
+        RAM = new byte[0x80];
+        Configure(Scheme);
+        ReadState(input, version);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        ReadState(input, version);
+    }
+
+    void ReadState(DeserializationContext input, int version)
+    {
+        SetBanks([input.ReadUInt16() >> 12]);
+        if (version > 1)
+            input.ReadBytesInto(RAM);
+        else
+            System.Array.Clear(RAM);
     }
 
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
 
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(ROM);
-        output.Write(BankBaseAddr);
+        output.Write((ushort)(Banks[0] << 12));
+        output.Write(RAM);
     }
 
     #endregion
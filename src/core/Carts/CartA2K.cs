@@ -3,7 +3,7 @@
 /// <summary>
 ///  Atari standard 2KB carts (no bankswitching)
 /// </summary>
-public sealed class CartA2K : Cart
+public sealed class CartA2K : BankswitchedCart
 {
     //
     //  Cart Format                Mapping to ROM Address Space
@@ -11,24 +11,25 @@ public sealed class CartA2K : Cart
     //                             0x1800:0x0800  (1st 2k bank repeated)
     //
 
-    #region IDevice Members
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[addr & 0x07ff];
-        set {}
-    }
-
-    #endregion
+        AddressMask = 0x07ff,
+        Windows =
+        [
+            new(0x0000, 0x0800, BankSource.Rom),
+        ],
+    };
 
     public CartA2K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x0800);
+        Configure(Scheme);
     }
 
     public CartA2K(byte[] romBytes, int multicartBankSelector)
     {
         LoadRom(romBytes, 0x800, multicartBankSelector & 0x1f);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -37,6 +38,14 @@ public sealed class CartA2K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x0800), 0x0800);
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari standard 32KB bankswitched carts
 /// </summary>
-public sealed class CartA32K : Cart
+public sealed class CartA32K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -16,48 +16,30 @@ public sealed class CartA32K : Cart
     // Bank7: 0x6000:0x1000
     // Bank8: 0x7000:0x1000
     //
-    ushort BankBaseAddr;
 
-    #region IDevice Members
-
-    public override void Reset()
-    {
-        BankBaseAddr = GetBankBaseAddr(7);
-    }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            addr &= 0xfff;
-            UpdateBank(addr);
-            return ROM[BankBaseAddr + addr];
-        }
-        set
-        {
-            addr &= 0xfff;
-            UpdateBank(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [7],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom) { Register = 0 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xff4, 0xffb, 0),
+        ],
+    };
 
     public CartA32K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x8000);
-        BankBaseAddr = GetBankBaseAddr(7);
+        Configure(Scheme);
     }
 
-    void UpdateBank(ushort addr)
-    {
-        if (addr is >= 0x0ff4 and < 0x0ffc)
-        {
-            BankBaseAddr = GetBankBaseAddr(addr - 0xff4);
-        }
-    }
-
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 12);  // Multiply by 4096
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[0];
 
     #region Serialization Members
 
@@ -65,7 +47,16 @@ public sealed class CartA32K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x8000), 0x8000);
-        BankBaseAddr = input.ReadUInt16();
+        Configure(Scheme);
+        SetBanks([input.ReadUInt16() >> 12]);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        SetBanks([input.ReadUInt16() >> 12]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -74,7 +65,7 @@ public sealed class CartA32K : Cart
 
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(BankBaseAddr);
+        output.Write((ushort)(Banks[0] << 12));
     }
 
     #endregion
@@ -3,7 +3,7 @@
 /// <summary>
 /// Atari standard 32KB bankswitched carts with 128 bytes of RAM
 /// </summary>
-public sealed class CartA32KR : Cart
+public sealed class CartA32KR : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -19,59 +19,33 @@ public sealed class CartA32KR : Cart
     //                            0x1000:0x80 RAM write port
     //                            0x1080:0x80 RAM read port
     //
-    ushort BankBaseAddr;
-    readonly byte[] RAM;
 
-    #region IDevice Members
-
-    public override void Reset()
+    static readonly BankswitchScheme Scheme = new()
     {
-        BankBaseAddr = GetBankBaseAddr(7);
-    }
-
-    public override byte this[ushort addr]
-    {
-        get
-        {
-            addr &= 0xfff;
-            if (addr is >= 0x0080 and < 0x0100)
-            {
-                return RAM[addr & 0x007f];
-            }
-            UpdateBank(addr);
-            return ROM[BankBaseAddr + addr];
-        }
-        set
-        {
-            addr &= 0xfff;
-            if (addr < 0x0080)
-            {
-                RAM[addr & 0x007f] = value;
-                return;
-            }
-            UpdateBank(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [7],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom) { Register = 0 },
+            new(0x0080, 0x0080, BankSource.Ram, BankAccess.Read),
+            new(0x0000, 0x0080, BankSource.Ram, BankAccess.Write),
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xff4, 0xffb, 0),
+        ],
+    };
 
     public CartA32KR(byte[] romBytes)
     {
         LoadRom(romBytes, 0x8000);
         RAM = new byte[0x80];
-        BankBaseAddr = GetBankBaseAddr(7);
-    }
-
-    void UpdateBank(ushort addr)
-    {
-        if (addr is < 0xffc and >= 0xff4 )
-        {
-            BankBaseAddr = GetBankBaseAddr(addr - 0xff4);
-        }
+        Configure(Scheme);
     }
 
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 12);  // Multiply by 4096
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[0];
 
     #region Serialization Members
 
@@ -79,8 +53,23 @@ public sealed class CartA32KR : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x8000), 0x8000);
-        RAM = input.ReadExpectedBytes(0x80);
-        BankBaseAddr = input.ReadUInt16();
+        RAM = new byte[0x80];
+        Configure(Scheme);
+        ReadState(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadState(input);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
+        input.ReadBytesInto(RAM);
+        SetBanks([input.ReadUInt16() >> 12]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -90,7 +79,7 @@ public sealed class CartA32KR : Cart
         output.WriteVersion(1);
         output.Write(ROM);
         output.Write(RAM);
-        output.Write(BankBaseAddr);
+        output.Write((ushort)(Banks[0] << 12));
     }
 
     #endregion
@@ -3,23 +3,21 @@
 /// <summary>
 /// Atari standard 4KB carts (no bankswitching)
 /// </summary>
-public sealed class CartA4K : Cart
+public sealed class CartA4K : BankswitchedCart
 {
-    #region IDevice Members
-
-    public override void Reset() { }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get => ROM[addr & 0x0fff];
-        set {}
-    }
-
-    #endregion
+        AddressMask = 0x0fff,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom),
+        ],
+    };
 
     public CartA4K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x1000);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -28,6 +26,14 @@ public sealed class CartA4K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x1000), 0x1000);
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
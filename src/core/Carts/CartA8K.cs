@@ -3,55 +3,37 @@
 /// <summary>
 /// Atari standard 8KB bankswitched carts
 /// </summary>
-public sealed class CartA8K : Cart
+public sealed class CartA8K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
     // Bank1: 0x0000:0x1000       0x1000:0x1000  Bank selected by accessing 0x1ff8,0x1ff9
     // Bank2: 0x1000:0x1000
     //
-    ushort BankBaseAddr;
 
-    #region IDevice Members
-
-    public override void Reset()
-    {
-        BankBaseAddr = GetBankBaseAddr(1);
-    }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            addr &= 0xfff;
-            UpdateBank(addr);
-            return ROM[BankBaseAddr + addr];
-        }
-        set
-        {
-            addr &= 0xfff;
-            UpdateBank(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [1],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom) { Register = 0 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xff8, 0xff9, 0),
+        ],
+    };
 
     public CartA8K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x2000);
-        BankBaseAddr = GetBankBaseAddr(1);
+        Configure(Scheme);
     }
 
-    void UpdateBank(ushort addr)
-    {
-        if (addr is >= 0xff8 and <= 0xff9)
-        {
-            BankBaseAddr = GetBankBaseAddr(addr - 0xff8);
-        }
-    }
-
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 12);  // Multiply by 4096
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[0];
 
     #region Serialization Members
 
@@ -59,7 +41,16 @@ public sealed class CartA8K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x2000), 0x2000);
-        BankBaseAddr = input.ReadUInt16();
+        Configure(Scheme);
+        SetBanks([input.ReadUInt16() >> 12]);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        SetBanks([input.ReadUInt16() >> 12]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -68,7 +59,7 @@ public sealed class CartA8K : Cart
 
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(BankBaseAddr);
+        output.Write((ushort)(Banks[0] << 12));
     }
 
     #endregion
@@ -3,7 +3,7 @@
 /// <summary>
 /// CBS RAM Plus 12KB bankswitched carts with 128 bytes of RAM.
 /// </summary>
-public sealed class CartCBS12K : Cart
+public sealed class CartCBS12K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -14,59 +14,33 @@ public sealed class CartCBS12K : Cart
     //                            0x1000:0x80 RAM write port
     //                            0x1080:0x80 RAM read port
     //
-    ushort BankBaseAddr;
-    readonly byte[] RAM;
 
-    #region IDevice Members
-
-    public override void Reset()
+    static readonly BankswitchScheme Scheme = new()
     {
-        BankBaseAddr = GetBankBaseAddr(2);
-    }
-
-    public override byte this[ushort addr]
-    {
-        get
-        {
-            addr &= 0xfff;
-            if (addr is < 0x0200 and >= 0x0100)
-            {
-                return RAM[addr & 0xff];
-            }
-            UpdateBank(addr);
-            return ROM[BankBaseAddr + addr];
-        }
-        set
-        {
-            addr &= 0xfff;
-            if (addr < 0x0100)
-            {
-                RAM[addr & 0xff] = value;
-                return;
-            }
-            UpdateBank(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [2],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x1000, BankSource.Rom) { Register = 0 },
+            new(0x0100, 0x0100, BankSource.Ram, BankAccess.Read),
+            new(0x0000, 0x0100, BankSource.Ram, BankAccess.Write),
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xff8, 0xffa, 0),
+        ],
+    };
 
     public CartCBS12K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x3000);
-        BankBaseAddr = GetBankBaseAddr(2);
         RAM = new byte[0x100];
+        Configure(Scheme);
     }
 
-    void UpdateBank(ushort addr)
-    {
-        if (addr is >= 0xff8 and <= 0xffa)
-        {
-            BankBaseAddr = GetBankBaseAddr(addr - 0xff8);
-        }
-    }
-
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 12);  // Multiply by 4096
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[0];
 
     #region Serialization Members
 
@@ -74,8 +48,23 @@ public sealed class CartCBS12K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x3000), 0x3000);
-        RAM = input.ReadExpectedBytes(0x100);
-        BankBaseAddr = input.ReadUInt16();
+        RAM = new byte[0x100];
+        Configure(Scheme);
+        ReadState(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadState(input);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
+        input.ReadBytesInto(RAM);
+        SetBanks([input.ReadUInt16() >> 12]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -85,7 +74,7 @@ public sealed class CartCBS12K : Cart
         output.WriteVersion(1);
         output.Write(ROM);
         output.Write(RAM);
-        output.Write(BankBaseAddr);
+        output.Write((ushort)(Banks[0] << 12));
     }
 
     #endregion
@@ -3,7 +3,7 @@
 /// <summary>
 /// Activison's Robot Tank and Decathlon 8KB bankswitching cart.
 /// </summary>
-public sealed class CartDC8K : Cart
+public sealed class CartDC8K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -15,18 +15,22 @@ public sealed class CartDC8K : Cart
     // counter, I am unsure how the cart/hardware could utilize this.
     //
 
-    #region IDevice Members
-
-    public override byte this[ushort addr] {
-        get => (addr & 0x2000) == 0 ? ROM[addr & 0x0fff + 0x1000] : ROM[addr & 0x0fff];
-        set {}
-    }
-
-    #endregion
+    // With A13 clear all 8KB are addressable; with A13 set the first 4KB is mirrored.
+    static readonly BankswitchScheme Scheme = new()
+    {
+        AddressMask = 0x3fff,
+        Windows =
+        [
+            new(0x0000, 0x2000, BankSource.Rom),
+            new(0x2000, 0x1000, BankSource.Rom),
+            new(0x3000, 0x1000, BankSource.Rom),
+        ],
+    };
 
     public CartDC8K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x2000);
+        Configure(Scheme);
     }
 
     #region Serialization Members
@@ -35,6 +39,14 @@ public sealed class CartDC8K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x2000), 0x2000);
+        Configure(Scheme);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
     }
 
     public override void GetObjectData(SerializationContext output)
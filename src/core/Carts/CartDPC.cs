@@ -23,42 +23,39 @@ public sealed class CartDPC : Cart
     readonly byte[] Flags = new byte[8];
     readonly bool[] MusicMode = new bool[3];
 
-    ulong LastSystemClock;
-    double FractionalClocks;
+    readonly MusicGenerator _music;
+
+    byte ShiftRegister;
 
     //
     // Generate a sequence of pseudo-random numbers 255 numbers long
     // by emulating an 8-bit shift register with feedback taps at
     // bits 4, 3, 2, and 0.
-    byte ShiftRegister
+    byte NextRandomNumber()
     {
-        get
-        {
-            var a = field;
-            a &= 1 << 0;
+        var a = ShiftRegister;
+        a &= 1 << 0;
 
-            var x = field;
-            x &= 1 << 2;
-            x >>= 2;
-            a ^= x;
+        var x = ShiftRegister;
+        x &= 1 << 2;
+        x >>= 2;
+        a ^= x;
 
-            x = field;
-            x &= 1 << 3;
-            x >>= 3;
-            a ^= x;
+        x = ShiftRegister;
+        x &= 1 << 3;
+        x >>= 3;
+        a ^= x;
 
-            x = field;
-            x &= 1 << 4;
-            x >>= 4;
-            a ^= x;
+        x = ShiftRegister;
+        x &= 1 << 4;
+        x >>= 4;
+        a ^= x;
 
-            a <<= 7;
-            field >>= 1;
-            field |= a;
+        a <<= 7;
+        ShiftRegister >>= 1;
+        ShiftRegister |= a;
 
-            return field;
-        }
-        set => field = value;
+        return ShiftRegister;
     }
 
     #region IDevice Members
@@ -66,8 +63,7 @@ public sealed class CartDPC : Cart
     public override void Reset()
     {
         BankBaseAddr = GetBankBaseAddr(1);
-        LastSystemClock = 3*M.CPU.Clock;
-        FractionalClocks = 0.0;
+        _music.Reset();
         ShiftRegister = 1;
     }
 
@@ -99,10 +95,26 @@ public sealed class CartDPC : Cart
 
     #endregion
 
+    public override void Attach(MachineBase m)
+    {
+        base.Attach(m);
+        _music.Attach(m);
+    }
+
+    public override void StartFrame()
+        => _music.StartFrame();
+
+    public override void EndFrame()
+        => _music.EndFrame();
+
+    protected internal override DPCMusic Music
+        => _music;
+
     public CartDPC(byte[] romBytes)
     {
         LoadRom(romBytes, 0x2800);
         BankBaseAddr = GetBankBaseAddr(1);
+        _music = new(this);
     }
 
     void UpdateBank(ushort addr)
@@ -123,6 +135,12 @@ public sealed class CartDPC : Cart
         var i = addr & 0x07;
         var fn = (addr >> 3) & 0x07;
 
+        // The music mode data fetchers are clocked by the oscillator
+        if (i >= 5)
+        {
+            _music.Sync();
+        }
+
         // Update flag register for selected data fetcher
         if ((Counters[i] & 0x00ff) == Tops[i])
         {
@@ -139,26 +157,11 @@ public sealed class CartDPC : Cart
                 if (i < 4)
                 {
                     // This is a random number read
-                    result = ShiftRegister;
+                    result = NextRandomNumber();
                     break;
                 }
                 // Its a music read
-                UpdateMusicModeDataFetchers();
-
-                byte j = 0;
-                if (MusicMode[0] && Flags[5] != 0)
-                {
-                    j |= 0x01;
-                }
-                if (MusicMode[1] && Flags[6] != 0)
-                {
-                    j |= 0x02;
-                }
-                if (MusicMode[2] && Flags[7] != 0)
-                {
-                    j |= 0x04;
-                }
-                result = MusicAmplitudes[j];
+                result = _music.ReadAmplitude();
                 break;
                 // DFx display data read
             case 0x01:
@@ -188,20 +191,8 @@ public sealed class CartDPC : Cart
         return result;
     }
 
-    void UpdateMusicModeDataFetchers()
+    void ClockMusicModeDataFetchers(int wholeClocks)
     {
-        var sysClockDelta = 3*M.CPU.Clock - LastSystemClock;
-        LastSystemClock = 3*M.CPU.Clock;
-
-        var OSCclocks = 15750.0 * sysClockDelta / 1193191.66666667 + FractionalClocks;
-
-        var wholeClocks = (int)OSCclocks;
-        FractionalClocks = OSCclocks - wholeClocks;
-        if (wholeClocks <= 0)
-        {
-            return;
-        }
-
         for (var i=0; i < 3; i++)
         {
             var r = i + 5;
@@ -236,11 +227,34 @@ public sealed class CartDPC : Cart
         }
     }
 
+    byte GetMusicAmplitude()
+    {
+        byte j = 0;
+        if (MusicMode[0] && Flags[5] != 0)
+        {
+            j |= 0x01;
+        }
+        if (MusicMode[1] && Flags[6] != 0)
+        {
+            j |= 0x02;
+        }
+        if (MusicMode[2] && Flags[7] != 0)
+        {
+            j |= 0x04;
+        }
+        return MusicAmplitudes[j];
+    }
+
     void WritePitfall2Reg(ushort addr, byte val)
     {
         var i = addr & 0x07;
         var fn = (addr >> 3) & 0x07;
 
+        if (i >= 5)
+        {
+            _music.Sync();
+        }
+
         switch (fn)
         {
                 // DFx top count
@@ -289,28 +303,91 @@ public sealed class CartDPC : Cart
         }
     }
 
+    public override byte GetBankNo(ushort addr)
+        => (byte)(BankBaseAddr >> 12);
+
+    /// <summary>
+    /// Data fetchers 5-7 in music mode, clocked by the 15.75 kHz oscillator.
+    /// </summary>
+    sealed class MusicGenerator : DPCMusic
+    {
+        const double OscillatorHz = 15750.0;
+
+        readonly CartDPC _cart;
+
+        protected override void ClockOscillators(int clocks)
+            => _cart.ClockMusicModeDataFetchers(clocks);
+
+        protected override byte ComputeAmplitude()
+            => _cart.GetMusicAmplitude();
+
+        public MusicGenerator(CartDPC cart) : base(OscillatorHz)
+            => _cart = cart;
+
+        public MusicGenerator(CartDPC cart, DeserializationContext input) : base(input, OscillatorHz)
+            => _cart = cart;
+    }
+
     #region Serialization Members
 
     public CartDPC(DeserializationContext input) : base(input)
     {
-        input.CheckVersion(1);
+        var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadExpectedBytes(0x28FF), 0x2800);
-        BankBaseAddr = input.ReadUInt16();
-        Tops = input.ReadExpectedBytes(8);
-        Bots = input.ReadExpectedBytes(8);
-        Counters = input.ReadUnsignedShorts(8);
-        Flags = input.ReadExpectedBytes(8);
-        MusicMode = input.ReadBooleans(3);
-        LastSystemClock = input.ReadUInt64();
-        FractionalClocks = input.ReadDouble();
+        ReadRegisters(input);
+        if (version == 1)
+        {
+            SkipOscillatorState(input);
+            _music = new(this);
+        }
+        else
+        {
+            _music = new(this, input);
+        }
+        ShiftRegister = input.ReadByte();
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        ReadRegisters(input);
+        if (version == 1)
+        {
+            SkipOscillatorState(input);
+            _music.Reset();
+        }
+        else
+        {
+            _music.Restore(input);
+        }
         ShiftRegister = input.ReadByte();
     }
 
+    void ReadRegisters(DeserializationContext input)
+    {
+        BankBaseAddr = input.ReadUInt16();
+        input.ReadBytesInto(Tops);
+        input.ReadBytesInto(Bots);
+        input.ReadUnsignedShortsInto(Counters);
+        input.ReadBytesInto(Flags);
+        input.ReadBooleansInto(MusicMode);
+    }
+
+    // The system clock and fraction of an oscillator clock last synchronized at;
+    // the fraction is under 64us of phase, so the oscillator starts over.
+    static void SkipOscillatorState(DeserializationContext input)
+    {
+        input.ReadUInt64();
+        input.ReadDouble();
+    }
+
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
 
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(ROM);
         output.Write(BankBaseAddr);
         output.Write(Tops);
@@ -318,8 +395,7 @@ public sealed class CartDPC : Cart
         output.Write(Counters);
         output.Write(Flags);
         output.Write(MusicMode);
-        output.Write(LastSystemClock);
-        output.Write(FractionalClocks);
+        _music.GetObjectData(output);
         output.Write(ShiftRegister);
     }
 
@@ -1,4 +1,6 @@
-﻿namespace EMU7800.Core;
+﻿using System;
+
+namespace EMU7800.Core;
 
 /// <summary>
 /// Another DPC cart supporting the bankswitching scheme of the Harmony cart.
@@ -32,16 +34,14 @@ public sealed class CartDPC2 : Cart
     readonly ushort[] _musicWaveforms = new ushort[3];
     byte _parameterPointer;
     bool _fastFetch, _ldaImmediate;
-    ulong _lastSystemClock;
-    double _fractionalClocks;
     uint _randomNumber;
+    readonly MusicGenerator _music;
 
     #region IDevice Members
 
     public override void Reset()
     {
-        _lastSystemClock = 3 * M.CPU.Clock;
-        _fractionalClocks = 0.0;
+        _music.Reset();
 
         for (var i = 0; i < _ram.Length; i++)
         {
@@ -120,8 +120,24 @@ public sealed class CartDPC2 : Cart
             System.Diagnostics.Debugger.Break();
         LoadRom(romBytes, MinimumSize);
         _bankBaseAddr = GetBankBaseAddr(5);
+        _music = new(this);
+    }
+
+    public override void Attach(MachineBase m)
+    {
+        base.Attach(m);
+        _music.Attach(m);
     }
 
+    public override void StartFrame()
+        => _music.StartFrame();
+
+    public override void EndFrame()
+        => _music.EndFrame();
+
+    protected internal override DPCMusic Music
+        => _music;
+
     void UpdateBank(ushort addr)
     {
         if (addr is >= 0xff6 and <= 0xffb)
@@ -163,11 +179,7 @@ public sealed class CartDPC2 : Cart
                         result = (byte)(_randomNumber >> 24);
                         break;
                     case 0x05: // AMPLITUDE
-                        UpdateMusicModeDataFetchers();
-                        var amp = _ram[DisplayBaseAddr + (_musicWaveforms[0] << 5) + (_musicCounters[0] >> 27)]
-                                + _ram[DisplayBaseAddr + (_musicWaveforms[1] << 5) + (_musicCounters[1] >> 27)]
-                                + _ram[DisplayBaseAddr + (_musicWaveforms[2] << 5) + (_musicCounters[2] >> 27)];
-                        result = (byte)amp;
+                        result = _music.ReadAmplitude();
                         break;
                 }
                 break;
@@ -273,6 +285,7 @@ public sealed class CartDPC2 : Cart
                     case 0x05: // WAVEFORM0
                     case 0x06: // WAVEFORM1
                     case 0x07: // WAVEFORM2
+                        _music.Sync();
                         _musicWaveforms[i - 5] = (ushort)(val & 0x7f);
                         break;
                 }
@@ -310,6 +323,7 @@ public sealed class CartDPC2 : Cart
                     case 0x05: // NOTE0
                     case 0x06: // NOTE1
                     case 0x07: // NOTE2
+                        _music.Sync();
                         var ri = FrequencyBaseAddr + (val << 2);
                         _musicFrequencies[i - 5] =
                            (uint)(_ram[ri]
@@ -347,26 +361,22 @@ public sealed class CartDPC2 : Cart
         _randomNumber = a1 != 0 ? a4 | a5 : a2 | a3;
     }
 
-    void UpdateMusicModeDataFetchers()
+    void ClockMusicCounters(int wholeClocks)
     {
-        var sysClockDelta = 3 * M.CPU.Clock - _lastSystemClock;
-        _lastSystemClock = 3 * M.CPU.Clock;
-
-        var OSCclocks = ((20000.0 * sysClockDelta) / 1193191.66666667) + _fractionalClocks;
-
-        var wholeClocks = (int)OSCclocks;
-        _fractionalClocks = OSCclocks - wholeClocks;
-        if (wholeClocks <= 0)
-        {
-            return;
-        }
-
         for (var i = 0; i < 3; i++)
         {
-            _musicCounters[i] += _musicFrequencies[i];
+            _musicCounters[i] += _musicFrequencies[i] * (uint)wholeClocks;
         }
     }
 
+    byte GetMusicAmplitude()
+    {
+        var amp = _ram[DisplayBaseAddr + (_musicWaveforms[0] << 5) + (_musicCounters[0] >> 27)]
+                + _ram[DisplayBaseAddr + (_musicWaveforms[1] << 5) + (_musicCounters[1] >> 27)]
+                + _ram[DisplayBaseAddr + (_musicWaveforms[2] << 5) + (_musicCounters[2] >> 27)];
+        return (byte)amp;
+    }
+
     byte GetFlag(int i)
     {
         var a1 = (_tops[i] - (_counters[i] & 0x00ff)) & 0xff;
@@ -375,20 +385,61 @@ public sealed class CartDPC2 : Cart
         return flag;
     }
 
+    public override byte GetBankNo(ushort addr)
+        => (byte)(_bankBaseAddr >> 12);
+
+    public override ReadOnlySpan<byte> RAMContents
+        => _ram;
+
+    /// <summary>
+    /// Three 32-bit phase accumulators clocked at 20 kHz, each indexing a 32-byte waveform in display RAM.
+    /// </summary>
+    sealed class MusicGenerator : DPCMusic
+    {
+        const double OscillatorHz = 20000.0;
+
+        readonly CartDPC2 _cart;
+
+        protected override void ClockOscillators(int clocks)
+            => _cart.ClockMusicCounters(clocks);
+
+        protected override byte ComputeAmplitude()
+            => _cart.GetMusicAmplitude();
+
+        public MusicGenerator(CartDPC2 cart) : base(OscillatorHz)
+            => _cart = cart;
+
+        public MusicGenerator(CartDPC2 cart, DeserializationContext input) : base(input, OscillatorHz)
+            => _cart = cart;
+    }
+
     #region Serialization Members
 
     public CartDPC2(DeserializationContext input) : base(input)
     {
-        input.CheckVersion(1);
+        var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadExpectedBytes(MinimumSize), MinimumSize);
+        _music = version == 1 ? new(this) : new(this, input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        if (version == 1)
+            _music.Reset();
+        else
+            _music.Restore(input);
     }
 
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
 
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(ROM);
+        _music.GetObjectData(output);
     }
 
     #endregion
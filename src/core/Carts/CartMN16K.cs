@@ -3,7 +3,7 @@
 /// <summary>
 /// M-Network 16KB bankswitched carts with 2KB RAM.
 /// </summary>
-public sealed class CartMN16K : Cart
+public sealed class CartMN16K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -24,85 +24,37 @@ public sealed class CartMN16K : Cart
     //                            0x1800-0x18ff write port
     //                            0x1900-0x19ff read port
     //
-    ushort BankBaseAddr, BankBaseRAMAddr;
-    bool RAMBankOn;
-    readonly byte[] RAM;
 
-    #region IDevice Members
-
-    public override void Reset()
-    {
-        ResetBanks();
-    }
-
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            addr &= 0x0fff;
-            UpdateBanks(addr);
-            if (RAMBankOn && addr is >= 0x0400 and < 0x0800)
-            {
-                return RAM[addr & 0x03ff];
-            }
-            if (addr is >= 0x0900 and < 0x0a00)
-            {
-                return RAM[0x400 + BankBaseRAMAddr + (addr & 0xff)];
-            }
-            return addr < 0x0800 ? ROM[BankBaseAddr + (addr & 0x07ff)] : ROM[0x3800 + (addr & 0x07ff)];
-        }
-        set
-        {
-            addr &= 0x0fff;
-            UpdateBanks(addr);
-            if (RAMBankOn && addr < 0x0400)
-            {
-                RAM[addr & 0x03ff] = value;
-            }
-            else if (addr is >= 0x0800 and < 0x0900)
-            {
-                RAM[0x400 + BankBaseRAMAddr + (addr & 0xff)] = value;
-            }
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [0, 0],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x0800, BankSource.Rom) { Register = 0 },
+            new(0x0800, 0x0800, BankSource.Rom) { Bank = 7 },
+            new(0x0400, 0x0400, BankSource.Ram, BankAccess.Read)  { ActiveRegister = 0, ActiveBank = 7 },
+            new(0x0000, 0x0400, BankSource.Ram, BankAccess.Write) { ActiveRegister = 0, ActiveBank = 7 },
+            new(0x0900, 0x0100, BankSource.Ram, BankAccess.Read)  { Register = 1, BankSize = 0x100, Offset = 0x400 },
+            new(0x0800, 0x0100, BankSource.Ram, BankAccess.Write) { Register = 1, BankSize = 0x100, Offset = 0x400 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xfe0, 0xfe7, 0),
+            new(HotspotTrigger.AddressOnAccess, 0xfe8, 0xfeb, 1),
+        ],
+    };
 
     public CartMN16K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x4000);
         RAM = new byte[0x800];
-        ResetBanks();
-    }
-
-    void UpdateBanks(ushort addr)
-    {
-        switch (addr)
-        {
-            case >= 0x0fe0 and < 0x0fe8:
-                var bankNo = addr & 7;
-                BankBaseAddr = GetBankBaseAddr(bankNo);
-                RAMBankOn = bankNo == 7;
-                break;
-            case >= 0x0fe8 and < 0x0fec:
-                var rambankNo = addr & 3;
-                BankBaseRAMAddr = GetBankBaseRAMAddr(rambankNo);
-                break;
-        }
-    }
-
-    void ResetBanks()
-    {
-        BankBaseAddr = 0;
-        BankBaseRAMAddr = 0;
-        RAMBankOn = false;
+        Configure(Scheme);
     }
 
-    static ushort GetBankBaseAddr(int bankNo)
-      => (ushort)(bankNo << 11);  // multiply by 2048
-
-    static ushort GetBankBaseRAMAddr(int bankNo)
-      => (ushort)(bankNo << 8);   // multiply by 256
+    public override byte GetBankNo(ushort addr)
+        => (byte)((addr & 0x0fff) < 0x0800 ? Banks[0] : 7);
 
     #region Serialization Members
 
@@ -110,10 +62,26 @@ public sealed class CartMN16K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x4000), 0x4000);
-        RAM = input.ReadExpectedBytes(0x800);
-        BankBaseAddr = input.ReadUInt16();
-        BankBaseRAMAddr = input.ReadUInt16();
-        RAMBankOn = input.ReadBoolean();
+        RAM = new byte[0x800];
+        Configure(Scheme);
+        ReadState(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadState(input);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
+        input.ReadBytesInto(RAM);
+        var bankBaseAddr = input.ReadUInt16();
+        var bankBaseRAMAddr = input.ReadUInt16();
+        input.ReadBoolean();  // RAM segment 1 on, implied by bank 7
+        SetBanks([bankBaseAddr >> 11, bankBaseRAMAddr >> 8]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -123,9 +91,9 @@ public sealed class CartMN16K : Cart
         output.WriteVersion(1);
         output.Write(ROM);
         output.Write(RAM);
-        output.Write(BankBaseAddr);
-        output.Write(BankBaseRAMAddr);
-        output.Write(RAMBankOn);
+        output.Write((ushort)(Banks[0] << 11));
+        output.Write((ushort)(Banks[1] << 8));
+        output.Write(Banks[0] == 7);
     }
 
     #endregion
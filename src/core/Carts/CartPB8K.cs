@@ -1,9 +1,11 @@
-﻿namespace EMU7800.Core;
+﻿using System;
+
+namespace EMU7800.Core;
 
 /// <summary>
 /// Parker Brothers 8KB bankswitched carts.
 /// </summary>
-public sealed class CartPB8K : Cart
+public sealed class CartPB8K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -16,66 +18,35 @@ public sealed class CartPB8K : Cart
     // Segment7: 0x1800:0x0400
     // Segment8: 0x1c00:0x0400
     //
-    readonly ushort[] SegmentBase;
-
-    #region IDevice Members
-
-    public override void Reset()
-    {
-        SegmentBase[0] = ComputeSegmentBase(4);
-        SegmentBase[1] = ComputeSegmentBase(5);
-        SegmentBase[2] = ComputeSegmentBase(6);
-    }
 
-    public override byte this[ushort addr]
+    static readonly BankswitchScheme Scheme = new()
     {
-        get
-        {
-            addr &= 0x0fff;
-            UpdateSegmentBases(addr);
-            return ROM[SegmentBase[addr >> 10] + (addr & 0x03ff)];
-        }
-        set
-        {
-            addr &= 0x0fff;
-            UpdateSegmentBases(addr);
-        }
-    }
-
-    #endregion
+        AddressMask  = 0x0fff,
+        InitialBanks = [4, 5, 6, 7],
+        ResetBanks   = true,
+        Windows =
+        [
+            new(0x0000, 0x0400, BankSource.Rom) { Register = 0 },
+            new(0x0400, 0x0400, BankSource.Rom) { Register = 1 },
+            new(0x0800, 0x0400, BankSource.Rom) { Register = 2 },
+            new(0x0c00, 0x0400, BankSource.Rom) { Register = 3 },
+        ],
+        Hotspots =
+        [
+            new(HotspotTrigger.AddressOnAccess, 0xfe0, 0xfe7, 0),
+            new(HotspotTrigger.AddressOnAccess, 0xfe8, 0xfef, 1),
+            new(HotspotTrigger.AddressOnAccess, 0xff0, 0xff7, 2),
+        ],
+    };
 
     public CartPB8K(byte[] romBytes)
     {
         LoadRom(romBytes, 0x2000);
-        SegmentBase = new ushort[4];
-        SegmentBase[0] = ComputeSegmentBase(4);
-        SegmentBase[1] = ComputeSegmentBase(5);
-        SegmentBase[2] = ComputeSegmentBase(6);
-        SegmentBase[3] = ComputeSegmentBase(7);
-    }
-
-    static ushort ComputeSegmentBase(int slice)
-    {
-        return (ushort)(slice << 10);  // multiply by 1024
+        Configure(Scheme);
     }
 
-    void UpdateSegmentBases(ushort addr)
-    {
-        switch (addr)
-        {
-            case < 0xfe0 or >= 0x0ff8:
-                break;
-            case >= 0x0fe0 and < 0x0fe8:
-                SegmentBase[0] = ComputeSegmentBase(addr & 0x07);
-                break;
-            case >= 0x0fe8 and < 0x0ff0:
-                SegmentBase[1] = ComputeSegmentBase(addr & 0x07);
-                break;
-            case >= 0x0ff0 and < 0x0ff8:
-                SegmentBase[2] = ComputeSegmentBase(addr & 0x07);
-                break;
-        }
-    }
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[(addr & 0x0fff) >> 10];
 
     #region Serialization Members
 
@@ -83,7 +54,16 @@ public sealed class CartPB8K : Cart
     {
         input.CheckVersion(1);
         LoadRom(input.ReadExpectedBytes(0x2000), 0x2000);
-        SegmentBase = input.ReadUnsignedShorts();
+        Configure(Scheme);
+        ReadSegmentBases(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadSegmentBases(input);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -92,7 +72,19 @@ public sealed class CartPB8K : Cart
 
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(SegmentBase);
+        Span<ushort> segmentBases = stackalloc ushort[4];
+        for (var i = 0; i < segmentBases.Length; i++)
+            segmentBases[i] = (ushort)(Banks[i] << 10);
+        output.Write(segmentBases);
+    }
+
+    void ReadSegmentBases(DeserializationContext input)
+    {
+        Span<ushort> segmentBases = stackalloc ushort[4];
+        input.ReadUnsignedShortsInto(segmentBases);
+        for (var i = 0; i < segmentBases.Length; i++)
+            Banks[i] = segmentBases[i] >> 10;
+        SetBanks(Banks);
     }
 
     #endregion
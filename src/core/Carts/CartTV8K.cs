@@ -3,7 +3,7 @@
 /// <summary>
 /// Tigervision 8KB bankswitched carts
 /// </summary>
-public sealed class CartTV8K : Cart
+public sealed class CartTV8K : BankswitchedCart
 {
     //
     // Cart Format                Mapping to ROM Address Space
@@ -12,60 +12,65 @@ public sealed class CartTV8K : Cart
     // Segment3: 0x1000:0x0800
     // Segment4: 0x1800:0x0800
     //
-    ushort BankBaseAddr;
-    readonly ushort LastBankBaseAddr;
 
-    byte Bank
-    {
-        set
-        {
-            BankBaseAddr = (ushort)(0x0800 * value);
-            BankBaseAddr %= (ushort)ROM.Length;
-        }
-    }
+    static readonly BankswitchScheme Scheme8K = CreateScheme(0x2000);
 
     protected internal override bool RequestSnooping => true;
 
-    #region IDevice Members
-
-    public override void Reset()
+    public CartTV8K(byte[] romBytes)
     {
-        Bank = 0;
+        LoadRom(romBytes, 0x1000);
+        Configure(ROM.Length == 0x2000 ? Scheme8K : CreateScheme(ROM.Length));
     }
 
-    public override byte this[ushort addr]
+    // The cart decodes only A0-A11 for reads, so the two segments repeat every 4KB, and it snoops
+    // writes to 0x0000-0x003f for the bank number, which wraps at the ROM's bank count.
+    static BankswitchScheme CreateScheme(int romLength)
     {
-        get
+        var windows = new BankWindow[32];
+        for (var i = 0; i < 16; i++)
         {
-            addr &= 0x0fff;
-            return addr < 0x0800 ? ROM[BankBaseAddr + (addr & 0x07ff)] : ROM[LastBankBaseAddr + (addr & 0x07ff)];
+            windows[2 * i]     = new(i << 12, 0x0800, BankSource.Rom) { Register = 0 };
+            windows[2 * i + 1] = new((i << 12) + 0x0800, 0x0800, BankSource.Rom) { Register = 1 };
         }
-        set
+        return new()
         {
-            if (addr <= 0x003f)
-            {
-                Bank = value;
-            }
-        }
+            InitialBanks = [0, (romLength >> 11) - 1],
+            ResetBanks   = true,
+            Windows      = windows,
+            Hotspots =
+            [
+                new(HotspotTrigger.ValueOnWrite, 0x0000, 0x003f, 0) { Modulo = romLength >> 11 },
+            ],
+        };
     }
 
-    #endregion
-
-    public CartTV8K(byte[] romBytes)
-    {
-        LoadRom(romBytes, 0x1000);
-        Bank = 0;
-        LastBankBaseAddr = (ushort)(ROM.Length - 0x0800);
-    }
+    public override byte GetBankNo(ushort addr)
+        => (byte)Banks[(addr & 0x0fff) < 0x0800 ? 0 : 1];
 
     #region Serialization Members
 
     public CartTV8K(DeserializationContext input) : base(input)
     {
         input.CheckVersion(1);
-        LoadRom(input.ReadExpectedBytes(0x1000), 0x1000);
-        BankBaseAddr = input.ReadUInt16();
-        LastBankBaseAddr = input.ReadUInt16();
+        LoadRom(input.ReadBytes(), 0x1000);
+        Configure(ROM.Length == 0x2000 ? Scheme8K : CreateScheme(ROM.Length));
+        ReadState(input);
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        ReadState(input);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
+        var bankBaseAddr = input.ReadUInt16();
+        var lastBankBaseAddr = input.ReadUInt16();
+        SetBanks([bankBaseAddr >> 11, lastBankBaseAddr >> 11]);
     }
 
     public override void GetObjectData(SerializationContext output)
@@ -74,8 +79,8 @@ public sealed class CartTV8K : Cart
 
         output.WriteVersion(1);
         output.Write(ROM);
-        output.Write(BankBaseAddr);
-        output.Write(LastBankBaseAddr);
+        output.Write((ushort)(Banks[0] << 11));
+        output.Write((ushort)(Banks[1] << 11));
     }
 
     #endregion
@@ -0,0 +1,189 @@
+/*
+ * DPCMusic.cs
+ *
+ * The music generator of the DPC and DPC+ chips. The oscillator clock is derived from the CPU clock
+ * in 32.32 fixed point, and the oscillators are advanced one sample at a time as the frame's sound
+ * buffer is rendered, the way TIASound renders, rather than each time the game polls the amplitude.
+ *
+ * Games copy the amplitude into a volume-only TIA channel. When TIASound sees such a store it hands
+ * the channel to the generator, so the music follows the oscillators at the sample rate instead of
+ * the rate at which the game happens to poll.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System.Numerics;
+using System.Runtime.Serialization;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public abstract class DPCMusic
+{
+    #region Fields
+
+    // Two samples per scanline, as TIASound renders on the 2600.
+    const int CpuClocksPerSample = 76 / 2;
+
+    // The oscillators have always been clocked from the system clock, three per CPU clock, against
+    // this rate; games are tuned to the pitch that gives, so keep it.
+    const int SystemClocksPerCpuClock = 3;
+    const double SystemClockHz = 1193191.66666667;
+
+    // An amplitude is relayed when the instruction right after the one reading it stores it to a TIA volume register:
+    // the store starts where the read's instruction ended, and takes no more than this many CPU clocks.
+    const int MaxStoreCpuClocks = 6;
+
+    MachineBase M = MachineBase.Default;
+
+    readonly ulong _oscStepPerSample;
+    ulong _oscPhase;
+
+    ulong _lastUpdateCpuClock, _lastAmplitudeCpuClock;
+    ushort _lastAmplitudeNextPC;
+    int _bufferIndex, _relayChannels;
+    byte _lastAmplitude;
+
+    #endregion
+
+    public void Attach(MachineBase m)
+    {
+        M = m;
+        // A deserialized generator has no frame in progress; render from the machine's current clock.
+        _lastUpdateCpuClock = m.CPU.Clock;
+    }
+
+    public void Reset()
+    {
+        _oscPhase = 0;
+        _relayChannels = 0;
+        _lastUpdateCpuClock = M.CPU.Clock;
+    }
+
+    public void StartFrame()
+    {
+        _lastUpdateCpuClock = M.CPU.Clock;
+        _bufferIndex = 0;
+    }
+
+    public void EndFrame()
+        => RenderSamples(M.FrameBuffer.SoundBuffer.Length - _bufferIndex);
+
+    /// <summary>
+    /// Advances the oscillators to the current CPU clock. Call before reading or changing their state.
+    /// </summary>
+    public void Sync()
+    {
+        if (M.CPU.Clock <= _lastUpdateCpuClock)
+            return;
+        var samples = (int)((M.CPU.Clock - _lastUpdateCpuClock) / CpuClocksPerSample);
+        RenderSamples(samples);
+        _lastUpdateCpuClock += (ulong)(samples * CpuClocksPerSample);
+    }
+
+    public byte ReadAmplitude()
+    {
+        Sync();
+        _lastAmplitude = ComputeAmplitude();
+        _lastAmplitudeCpuClock = M.CPU.Clock;
+        _lastAmplitudeNextPC = M.CPU.PC;
+        return _lastAmplitude;
+    }
+
+    /// <summary>
+    /// Whether a value stored to a TIA volume register is the amplitude read by the instruction just before.
+    /// </summary>
+    internal bool IsRelayedAmplitude(byte data)
+        => ((data ^ _lastAmplitude) & 0x0f) == 0
+            && M.CPU.Clock - _lastAmplitudeCpuClock <= MaxStoreCpuClocks
+            && (ushort)(M.CPU.PC - _lastAmplitudeNextPC) is 2 or 3;
+
+    /// <summary>
+    /// Starts or stops rendering through the specified TIA channel, which is silent while relayed.
+    /// </summary>
+    internal void SetRelay(int chan, bool relayed)
+    {
+        Sync();
+        if (relayed)
+            _relayChannels |= 1 << chan;
+        else
+            _relayChannels &= ~(1 << chan);
+    }
+
+    /// <summary>
+    /// Advances the oscillators by the specified number of oscillator clocks.
+    /// </summary>
+    protected abstract void ClockOscillators(int clocks);
+
+    protected abstract byte ComputeAmplitude();
+
+    #region Constructors
+
+    protected DPCMusic(double oscillatorHz)
+    {
+        _oscStepPerSample = (ulong)(oscillatorHz * SystemClocksPerCpuClock * CpuClocksPerSample / SystemClockHz * (1UL << 32));
+    }
+
+    #endregion
+
+    #region Serialization Members
+
+    protected DPCMusic(DeserializationContext input, double oscillatorHz) : this(oscillatorHz)
+        => ReadState(input);
+
+    public void Restore(DeserializationContext input)
+    {
+        ReadState(input);
+        _lastUpdateCpuClock = M.CPU.Clock;
+        _bufferIndex = 0;
+    }
+
+    public void GetObjectData(SerializationContext output)
+    {
+        output.WriteVersion(3);
+        output.Write(_oscPhase);
+        output.Write(_relayChannels);
+        output.Write(_lastAmplitude);
+        output.Write(_lastAmplitudeCpuClock);
+        output.Write(_lastAmplitudeNextPC);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
+        var version = input.CheckVersion(1, 3);
+        _oscPhase = input.ReadUInt64();
+        SerializationException.ThrowIf(_oscPhase >> 32 != 0, "Oscillator phase out of range");
+        _relayChannels = version >= 2 ? input.ReadInt32() : 0;
+        SerializationException.ThrowIf((_relayChannels & ~3) != 0, "Relayed channels out of range");
+        _lastAmplitude = version >= 2 ? input.ReadByte() : (byte)0;
+        _lastAmplitudeCpuClock = version >= 2 ? input.ReadUInt64() : 0;
+        _lastAmplitudeNextPC = version >= 3 ? input.ReadUInt16() : (ushort)0;
+    }
+
+    #endregion
+
+    #region Helpers
+
+    void RenderSamples(int count)
+    {
+        var buffer = M.FrameBuffer.SoundBuffer.Span;
+        for (; count > 0; count--)
+        {
+            _oscPhase += _oscStepPerSample;
+            var clocks = (int)(_oscPhase >> 32);
+            if (clocks > 0)
+            {
+                _oscPhase &= uint.MaxValue;
+                ClockOscillators(clocks);
+            }
+
+            if (_bufferIndex >= buffer.Length)
+                continue;
+            if (_relayChannels != 0)
+                buffer[_bufferIndex] += (byte)((ComputeAmplitude() & 0x0f) * BitOperations.PopCount((uint)_relayChannels));
+            _bufferIndex++;
+        }
+    }
+
+    #endregion
+}
@@ -81,6 +81,9 @@ public sealed class HSC7800 : Cart
 
     #endregion
 
+    public override byte GetBankNo(ushort addr)
+        => Cart.GetBankNo(addr);
+
     #region Serialization Members
 
     public HSC7800(DeserializationContext input) : this()
@@ -91,6 +94,14 @@ public sealed class HSC7800 : Cart
         Cart = input.ReadCart(M);
     }
 
+    public override void Restore(DeserializationContext input)
+    {
+        input.CheckVersion(1);
+        input.ReadBytesInto(ROM);
+        NVRAM.Restore(input);
+        input.RestoreCart(Cart);
+    }
+
     public override void GetObjectData(SerializationContext output)
     {
         output.WriteVersion(1);
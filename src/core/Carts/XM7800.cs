@@ -12,6 +12,8 @@
  *   RAM        $4000-$7FFF  16KB bank size
  *
  */
+using System;
+
 namespace EMU7800.Core;
 
 public sealed class XM7800 : Cart
@@ -108,9 +110,11 @@ public sealed class XM7800 : Cart
     {
         base.Attach(m);
         Cart.Attach(m);
-        _pokeySound = new(m);
+        if (_pokeySound == PokeySound.Default)
+            _pokeySound = new(m);
         //_pokeySound2 = new(m);
-        _ym2151 = new(m);
+        if (_ym2151 == YM2151.Default)
+            _ym2151 = new(m);
     }
 
     public override void StartFrame()
@@ -168,11 +172,17 @@ public sealed class XM7800 : Cart
 
     #endregion
 
+    public override byte GetBankNo(ushort addr)
+        => Cart.GetBankNo(addr);
+
+    public override ReadOnlySpan<byte> RAMContents
+        => RAM;
+
     #region Serialization Members
 
     public XM7800(DeserializationContext input, MachineBase m) : this()
     {
-        input.CheckVersion(1);
+        var version = input.CheckVersion(1, 2);
         LoadRom(input.ReadBytes());
         RAM = input.ReadBytes();
         NVRAM = input.ReadNVRAM2k();
@@ -180,11 +190,26 @@ public sealed class XM7800 : Cart
         _pokeySound = input.ReadOptionalPokeySound(m);
         //_pokeySound2 = input.ReadOptionalPokeySound(m);
         _ym2151 = input.ReadOptionalYM2151(m);
+        if (version > 1)
+            XCTRL = input.ReadByte();
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(ROM);
+        input.ReadBytesInto(RAM);
+        NVRAM.Restore(input);
+        input.RestoreCart(Cart);
+        input.RestoreOptional(_pokeySound);
+        //input.RestoreOptional(_pokeySound2);
+        input.RestoreOptional(_ym2151);
+        XCTRL = version > 1 ? input.ReadByte() : (byte)0;
     }
 
     public override void GetObjectData(SerializationContext output)
     {
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(ROM);
         output.Write(RAM);
         output.Write(NVRAM);
@@ -192,6 +217,7 @@ public sealed class XM7800 : Cart
         output.WriteOptional(_pokeySound);
         //output.WriteOptional(_pokeySound2);
         output.WriteOptional(_ym2151);
+        output.Write(XCTRL);
     }
 
     #endregion
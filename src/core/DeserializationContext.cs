@@ -1,7 +1,9 @@
 ﻿using System;
 using System.IO;
 using System.Linq;
+using System.Runtime.InteropServices;
 using System.Runtime.Serialization;
+using System.Text;
 using EMU7800.Core.Extensions;
 
 namespace EMU7800.Core;
@@ -98,12 +100,73 @@ public class DeserializationContext
         return booleans;
     }
 
-    public int CheckVersion(params int[] validVersions)
+    /// <summary>
+    /// Reads a byte array into the specified destination, which must be exactly its length.
+    /// </summary>
+    public void ReadBytesInto(Span<byte> destination)
+    {
+        var count = _binaryReader.ReadInt32();
+        SerializationException.ThrowIf(count != destination.Length, "Byte array length incorrect");
+        _binaryReader.BaseStream.ReadExactly(destination);
+    }
+
+    public void ReadOptionalBytesInto(Span<byte> destination)
+    {
+        var hasBytes = _binaryReader.ReadBoolean();
+        SerializationException.ThrowIf(hasBytes != destination.Length > 0, "Optional byte array presence incorrect");
+        if (hasBytes)
+            ReadBytesInto(destination);
+    }
+
+    public void ReadUnsignedShortsInto(Span<ushort> destination)
+        => ReadBytesInto(MemoryMarshal.AsBytes(destination));
+
+    public void ReadIntegersInto(Span<int> destination)
+        => ReadBytesInto(MemoryMarshal.AsBytes(destination));
+
+    public void ReadUnsignedIntegersInto(Span<uint> destination)
+        => ReadBytesInto(MemoryMarshal.AsBytes(destination));
+
+    public void ReadBooleansInto(Span<bool> destination)
+    {
+        var count = _binaryReader.ReadInt32();
+        SerializationException.ThrowIf(count != destination.Length, "Byte array length incorrect");
+        for (var i = 0; i < destination.Length; i++)
+            destination[i] = _binaryReader.ReadByte() != 0;
+    }
+
+    /// <summary>
+    /// Reads a string, throwing unless it is the expected one. Unlike <see cref="ReadString"/>, does not allocate.
+    /// </summary>
+    public void ReadExpectedString(string expected)
+    {
+        Span<byte> expectedBytes = stackalloc byte[0x100];
+        Span<byte> actualBytes = stackalloc byte[0x100];
+        SerializationException.ThrowIf(!Encoding.UTF8.TryGetBytes(expected, expectedBytes, out var expectedCount), "Expected string too long");
+        var count = _binaryReader.Read7BitEncodedInt();
+        SerializationException.ThrowIf(count != expectedCount, "Unexpected string found");
+        _binaryReader.BaseStream.ReadExactly(actualBytes[..count]);
+        SerializationException.ThrowIf(!actualBytes[..count].SequenceEqual(expectedBytes[..count]), "Unexpected string found");
+    }
+
+    public int CheckVersion(int validVersion)
+    {
+        var magicNumber = _binaryReader.ReadInt32();
+        SerializationException.ThrowIf(magicNumber != 0x78000087, "Magic number not found");
+        var version = _binaryReader.ReadInt32();
+        SerializationException.ThrowIf(version != validVersion, "Invalid version number found");
+        return version;
+    }
+
+    /// <summary>
+    /// Reads the version, throwing unless it is one of <paramref name="oldestVersion"/> through <paramref name="currentVersion"/>.
+    /// </summary>
+    public int CheckVersion(int oldestVersion, int currentVersion)
     {
         var magicNumber = _binaryReader.ReadInt32();
         SerializationException.ThrowIf(magicNumber != 0x78000087, "Magic number not found");
         var version = _binaryReader.ReadInt32();
-        SerializationException.ThrowIf(validVersions.All(t => t != version), "Invalid version number found");
+        SerializationException.ThrowIf(version < oldestVersion || version > currentVersion, "Invalid version number found");
         return version;
     }
 
@@ -120,6 +183,16 @@ public class DeserializationContext
         _ => throw new SerializationException($"Unable to resolve type name: '{typeName}'")
     };
 
+    /// <summary>
+    /// Restores the state of the specified machine in place from a machine of the same type, as written by
+    /// <see cref="SerializationContext.Write(MachineBase)"/>.
+    /// </summary>
+    public void RestoreMachine(MachineBase m)
+    {
+        ReadExpectedString(m.ToString() ?? string.Empty);
+        m.Restore(this);
+    }
+
     public AddressSpace ReadAddressSpace(MachineBase m, int addrSpaceShift, int pageShift)
         => new(this, m, addrSpaceShift, pageShift);
 
@@ -153,12 +226,36 @@ public class DeserializationContext
     public YM2151 ReadOptionalYM2151(MachineBase m)
         => ReadBoolean() ? new YM2151(this, m) : YM2151.Default;
 
+    public void RestoreOptional(Bios7800 bios7800)
+    {
+        if (ReadOptionalPresence(bios7800 != Bios7800.Default))
+            bios7800.Restore(this);
+    }
+
+    public void RestoreOptional(PokeySound pokeySound)
+    {
+        if (ReadOptionalPresence(pokeySound != PokeySound.Default))
+            pokeySound.Restore(this);
+    }
+
+    public void RestoreOptional(YM2151 ym2151)
+    {
+        if (ReadOptionalPresence(ym2151 != YM2151.Default))
+            ym2151.Restore(this);
+    }
+
     public NVRAM2k ReadNVRAM2k()
         => new(this);
 
     public Cart ReadCart(MachineBase m)
         => CreateCart(m, _binaryReader.ReadString());
 
+    public void RestoreCart(Cart cart)
+    {
+        ReadExpectedString(cart.ToString() ?? string.Empty);
+        cart.Restore(this);
+    }
+
     public Cart CreateCart(MachineBase m, string typeName)
         => typeName.Split('.')[^1] switch
         {
@@ -205,6 +302,13 @@ public class DeserializationContext
             _ => throw new SerializationException($"Unable to resolve type name: '{typeName}'")
         };
 
+    bool ReadOptionalPresence(bool exists)
+    {
+        var written = _binaryReader.ReadBoolean();
+        SerializationException.ThrowIf(written != exists, "Optional component presence incorrect");
+        return written;
+    }
+
     #region Constructors
 
     /// <summary>
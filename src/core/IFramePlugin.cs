@@ -0,0 +1,23 @@
+/*
+ * IFramePlugin.cs
+ *
+ * Defines interface for automation run at machine frame boundaries, e.g. test scripts and bots.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+namespace EMU7800.Core;
+
+public interface IFramePlugin
+{
+    /// <summary>
+    /// Called before the frame's input is captured; input raised on <see cref="MachineBase.InputState"/> here
+    /// applies to the frame.
+    /// </summary>
+    void FrameStarting(MachineBase m);
+
+    /// <summary>
+    /// Called once the frame is computed, when its video, sound and RAM can be read.
+    /// </summary>
+    void FrameComputed(MachineBase m);
+}
\ No newline at end of file
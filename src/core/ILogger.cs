@@ -1,7 +1,20 @@
-﻿namespace EMU7800.Core;
+﻿using System.Runtime.CompilerServices;
+
+namespace EMU7800.Core;
 
 public interface ILogger
 {
     int Level {  get; set; }
     void Log(int level, string message);
+
+    /// <summary>
+    /// Interpolated messages are only formatted when the level is enabled.
+    /// </summary>
+    void Log(int level, [InterpolatedStringHandlerArgument("", "level")] ref LogInterpolatedStringHandler message)
+    {
+        if (message.IsEnabled)
+        {
+            Log(level, message.ToStringAndClear());
+        }
+    }
 }
\ No newline at end of file
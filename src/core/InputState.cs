@@ -8,6 +8,9 @@
  *
  */
 using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
 
 namespace EMU7800.Core;
 
@@ -28,9 +31,31 @@ public class InputState
     readonly byte[] _rotGrayCodes = [0x0f, 0x0d, 0x0c, 0x0e];
     readonly int[] _rotState = new int[2];
 
+    static readonly Action<int[]> NoInputHook = nis => {};
+
     readonly int[] _nextInputState = new int[InputStateSize];
     readonly int[] _inputState = new int[InputStateSize];
 
+    // Button and switch events in the order raised. Events that do not fit in the queue wait in order in the overflow,
+    // which the producer keeps using until the consumer empties it, so that no edge is lost.
+    SpscQueue<InputEvent>? _eventQueue;
+    readonly Queue<InputEvent> _overflowEvents = new();
+    volatile bool _hasOverflowEvents;
+    long _latchedInputTimestamp;
+
+    // Paddle and lightgun positions raised through the queue, of which only the latest matters. The producer sets the
+    // pending bit for a slot after storing it, and the earliest pending timestamp, and the consumer takes both.
+    readonly int[] _raisedOhms = new int[4];
+    readonly long[] _raisedLightgunPositions = new long[2];
+    int _pendingPositions;
+    long _pendingPositionsTimestamp;
+
+    // Console switches as of the last input applied by the consumer, with a count of toggles applied per switch in each
+    // of the upper bytes, so that the producer can tell which of its toggles are still in the queue.
+    int _publishedConsoleSwitches;
+    readonly byte[] _raisedToggles = new byte[3];
+    readonly byte[] _appliedToggles = new byte[3];
+
     #endregion
 
     #region Public Members
@@ -39,19 +64,115 @@ public class InputState
     /// Enables the incoming input state buffer to be populated prior to the start of the frame.
     /// Useful for input playback scenarios.
     /// </summary>
-    public Action<int[]> InputAdvancing { get; set; } = nis => {};
+    public Action<int[]> InputAdvancing { get; set; } = NoInputHook;
 
     /// <summary>
     /// Enables access to the input state buffer.
     /// Useful for input recording scenarios.
     /// </summary>
-    public Action<int[]> InputAdvanced { get; set; } = nis => {};
+    public Action<int[]> InputAdvanced { get; set; } = NoInputHook;
+
+    /// <summary>
+    /// Number of elements in an input state vector.
+    /// </summary>
+    public static int VectorLength => InputStateSize;
+
+    /// <summary>
+    /// Copies the incoming input state buffer, e.g., for transmission to a remote site.
+    /// </summary>
+    public void CopyNextInputStateTo(Span<int> destination)
+    {
+        DrainInputEvents();
+        _nextInputState.CopyTo(destination);
+    }
+
+    /// <summary>
+    /// Copies the elements of an input state vector that are driven by the controller plugged into the specified jack,
+    /// including the jack's controller type. Console switches are owned by the left jack.
+    /// </summary>
+    public static void MergeJackInput(ReadOnlySpan<int> source, Span<int> destination, int jackNo)
+    {
+        jackNo &= 1;
+        destination[LeftControllerJackIndex + jackNo] = source[LeftControllerJackIndex + jackNo];
+        if (jackNo == 0)
+        {
+            destination[ConsoleSwitchIndex] = source[ConsoleSwitchIndex];
+        }
+        if ((Controller)source[LeftControllerJackIndex + jackNo] == Controller.Paddles)
+        {
+            destination[ControllerActionStateIndex + (jackNo << 1)] = source[ControllerActionStateIndex + (jackNo << 1)];
+            destination[ControllerActionStateIndex + (jackNo << 1) + 1] = source[ControllerActionStateIndex + (jackNo << 1) + 1];
+        }
+        else
+        {
+            destination[ControllerActionStateIndex + jackNo] = source[ControllerActionStateIndex + jackNo];
+        }
+        // Paddle resistance and lightgun position share these elements
+        destination[OhmsIndex + (jackNo << 1)] = source[OhmsIndex + (jackNo << 1)];
+        destination[OhmsIndex + (jackNo << 1) + 1] = source[OhmsIndex + (jackNo << 1) + 1];
+    }
+
+    /// <summary>
+    /// Routes subsequent Raise* calls through a lock-free queue so that input can be raised from another thread
+    /// (e.g., UI) without tearing the state the machine is reading. Queued input is applied at the moment the machine
+    /// next samples a controller or console switch, rather than at the start of the following frame. While
+    /// <see cref="InputAdvancing"/> or <see cref="InputAdvanced"/> is set, queued input is applied only at the start of a
+    /// frame instead, so that a recording sees all the input the machine sampled and playback is not mixed with live input.
+    /// Once enabled, the Raise* methods and the Is*ConsoleSwitchSet properties must only be used from a single producer thread.
+    /// </summary>
+    public void EnableInputEventQueue(int capacity = 256)
+    {
+        if (_eventQueue is not null)
+            return;
+        _publishedConsoleSwitches = _nextInputState[ConsoleSwitchIndex];
+        _eventQueue = new(capacity);
+    }
+
+    /// <summary>
+    /// Applies queued input to the incoming input state buffer without capturing it, e.g., while the machine is paused,
+    /// so that input raised in the meantime does not back up. Call from the thread running the machine.
+    /// </summary>
+    public void DrainInputEvents()
+    {
+        if (_eventQueue is null)
+            return;
+        while (_eventQueue.TryDequeue(out var e))
+        {
+            ApplyInputEvent(e);
+        }
+        if (_hasOverflowEvents)
+        {
+            lock (_overflowEvents)
+            {
+                while (_overflowEvents.TryDequeue(out var e))
+                {
+                    ApplyInputEvent(e);
+                }
+                _hasOverflowEvents = false;
+            }
+        }
+        ApplyRaisedPositions();
+        PublishConsoleSwitches();
+    }
+
+    /// <summary>
+    /// Returns the <see cref="Stopwatch"/> timestamp at which the earliest queued input applied since the last call was raised,
+    /// or zero if none was applied. Useful for measuring input-to-photon latency.
+    /// </summary>
+    public long TakeLatchedInputTimestamp()
+    {
+        var timestamp = _latchedInputTimestamp;
+        _latchedInputTimestamp = 0;
+        return timestamp;
+    }
 
     public void CaptureInputState()
     {
+        DrainInputEvents();
         InputAdvancing(_nextInputState);
         Buffer.BlockCopy(_nextInputState, 0, _inputState, 0, InputStateSize * sizeof(int));
         InputAdvanced(_inputState);
+        PublishConsoleSwitches();
     }
 
     public Controller LeftControllerJack
@@ -67,15 +188,27 @@ public class InputState
     }
 
     public bool IsGameBWConsoleSwitchSet
-        => (_nextInputState[ConsoleSwitchIndex] & (1 << (int)ConsoleSwitch.GameBW)) != 0;
+        => IsToggledConsoleSwitchSet(ConsoleSwitch.GameBW);
 
     public bool IsLeftDifficultyAConsoleSwitchSet
-        => (_nextInputState[ConsoleSwitchIndex] & (1 << (int)ConsoleSwitch.LeftDifficultyA)) != 0;
+        => IsToggledConsoleSwitchSet(ConsoleSwitch.LeftDifficultyA);
 
     public bool IsRightDifficultyAConsoleSwitchSet
-        => (_nextInputState[ConsoleSwitchIndex] & (1 << (int)ConsoleSwitch.RightDifficultyA)) != 0;
+        => IsToggledConsoleSwitchSet(ConsoleSwitch.RightDifficultyA);
 
     public void RaiseInput(int playerNo, MachineInput input, bool down)
+    {
+        if (_eventQueue is not null)
+        {
+            if (down && ToToggleIndex(input) is var i and >= 0)
+                _raisedToggles[i]++;
+            EnqueueInputEvent(new(playerNo, input, down, Stopwatch.GetTimestamp()));
+            return;
+        }
+        ApplyInput(playerNo, input, down);
+    }
+
+    void ApplyInput(int playerNo, MachineInput input, bool down)
     {
         switch (input)
         {
@@ -183,6 +316,17 @@ public class InputState
     }
 
     public void RaisePaddleInput(int playerNo, int ohms)
+    {
+        if (_eventQueue is not null)
+        {
+            Volatile.Write(ref _raisedOhms[playerNo & 3], ohms);
+            SetPendingPosition(playerNo & 3);
+            return;
+        }
+        ApplyPaddleInput(playerNo, ohms);
+    }
+
+    void ApplyPaddleInput(int playerNo, int ohms)
     {
         if (ohms is >= 0 and < 1000000)
         {
@@ -191,6 +335,17 @@ public class InputState
     }
 
     public void RaiseLightgunPos(int playerNo, int scanline, int hpos)
+    {
+        if (_eventQueue is not null)
+        {
+            Volatile.Write(ref _raisedLightgunPositions[playerNo & 1], (long)scanline << 32 | (uint)hpos);
+            SetPendingPosition(4 + (playerNo & 1));
+            return;
+        }
+        ApplyLightgunPos(playerNo, scanline, hpos);
+    }
+
+    void ApplyLightgunPos(int playerNo, int scanline, int hpos)
     {
         var i = LightgunPositionIndex + ((playerNo & 1) << 1);
         _nextInputState[i++] = scanline;
@@ -247,11 +402,14 @@ public class InputState
     }
 
     public InputState(DeserializationContext input)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
         input.CheckVersion(1);
-        _rotState = input.ReadIntegers(2);
-        _nextInputState = input.ReadIntegers(InputStateSize);
-        _inputState = input.ReadIntegers(InputStateSize);
+        input.ReadIntegersInto(_rotState);
+        input.ReadIntegersInto(_nextInputState);
+        input.ReadIntegersInto(_inputState);
     }
 
     public void GetObjectData(SerializationContext output)
@@ -267,19 +425,20 @@ public class InputState
     #region Internal Members
 
     internal bool SampleCapturedConsoleSwitchState(ConsoleSwitch consoleSwitch)
-        => (_inputState[ConsoleSwitchIndex] & (1 << (int)consoleSwitch)) != 0;
+        => (LatchedInputState()[ConsoleSwitchIndex] & (1 << (int)consoleSwitch)) != 0;
 
     internal bool SampleCapturedControllerActionState(int playerno, ControllerAction action)
-        => (_inputState[ControllerActionStateIndex + (playerno & 3)] & (1 << (int)action)) != 0;
+        => (LatchedInputState()[ControllerActionStateIndex + (playerno & 3)] & (1 << (int)action)) != 0;
 
     internal int SampleCapturedOhmState(int playerNo)
-        => _inputState[OhmsIndex + (playerNo & 3)];
+        => LatchedInputState()[OhmsIndex + (playerNo & 3)];
 
     internal void SampleCapturedLightGunPosition(int playerNo, out int scanline, out int hpos)
     {
         var i = LightgunPositionIndex + ((playerNo & 1) << 1);
-        scanline = _inputState[i++];
-        hpos = _inputState[i];
+        var inputState = LatchedInputState();
+        scanline = inputState[i++];
+        hpos = inputState[i];
     }
 
     internal byte SampleCapturedDrivingState(int playerNo)
@@ -299,6 +458,100 @@ public class InputState
 
     #region Helpers
 
+    /// <summary>
+    /// Returns the captured input state, first applying any input queued since, as the machine is sampling it mid-frame.
+    /// Input hooks only see the state captured at the start of a frame, so nothing is applied mid-frame while one is set.
+    /// </summary>
+    int[] LatchedInputState()
+    {
+        if (_eventQueue is not null && InputAdvancing == NoInputHook && InputAdvanced == NoInputHook
+            && (!_eventQueue.IsEmpty || _hasOverflowEvents || Volatile.Read(ref _pendingPositions) != 0))
+        {
+            DrainInputEvents();
+            Buffer.BlockCopy(_nextInputState, 0, _inputState, 0, InputStateSize * sizeof(int));
+        }
+        return _inputState;
+    }
+
+    void EnqueueInputEvent(in InputEvent e)
+    {
+        if (!_hasOverflowEvents && _eventQueue!.TryEnqueue(e))
+            return;
+        lock (_overflowEvents)
+        {
+            _overflowEvents.Enqueue(e);
+            _hasOverflowEvents = true;
+        }
+    }
+
+    void ApplyInputEvent(in InputEvent e)
+    {
+        ApplyInput(e.PlayerNo, e.Input, e.Down);
+        if (e.Down && ToToggleIndex(e.Input) is var i and >= 0)
+            _appliedToggles[i]++;
+        if (_latchedInputTimestamp == 0)
+            _latchedInputTimestamp = e.Timestamp;
+    }
+
+    void SetPendingPosition(int slot)
+    {
+        Interlocked.CompareExchange(ref _pendingPositionsTimestamp, Stopwatch.GetTimestamp(), 0);
+        Interlocked.Or(ref _pendingPositions, 1 << slot);
+    }
+
+    void ApplyRaisedPositions()
+    {
+        var pending = Interlocked.Exchange(ref _pendingPositions, 0);
+        if (pending == 0)
+            return;
+        for (var slot = 0; slot < 4; slot++)
+        {
+            if ((pending & (1 << slot)) != 0)
+                ApplyPaddleInput(slot, Volatile.Read(ref _raisedOhms[slot]));
+        }
+        for (var jackNo = 0; jackNo < 2; jackNo++)
+        {
+            if ((pending & (1 << (4 + jackNo))) == 0)
+                continue;
+            var position = Volatile.Read(ref _raisedLightgunPositions[jackNo]);
+            ApplyLightgunPos(jackNo, (int)(position >> 32), (int)position);
+        }
+        var timestamp = Interlocked.Exchange(ref _pendingPositionsTimestamp, 0);
+        if (_latchedInputTimestamp == 0)
+            _latchedInputTimestamp = timestamp;
+    }
+
+    void PublishConsoleSwitches()
+    {
+        if (_eventQueue is null)
+            return;
+        var published = _nextInputState[ConsoleSwitchIndex] & 0xff;
+        for (var i = 0; i < _appliedToggles.Length; i++)
+            published |= _appliedToggles[i] << (8 * (i + 1));
+        Volatile.Write(ref _publishedConsoleSwitches, published);
+    }
+
+    /// <summary>
+    /// Reports the state of a toggled console switch, including toggles still in the queue when it is enabled.
+    /// </summary>
+    bool IsToggledConsoleSwitchSet(ConsoleSwitch consoleSwitch)
+    {
+        if (_eventQueue is null)
+            return (_nextInputState[ConsoleSwitchIndex] & (1 << (int)consoleSwitch)) != 0;
+        var published = Volatile.Read(ref _publishedConsoleSwitches);
+        var i = consoleSwitch - ConsoleSwitch.GameBW;
+        var pendingToggles = _raisedToggles[i] - (byte)(published >> (8 * (i + 1)));
+        return (((published >> (int)consoleSwitch) ^ pendingToggles) & 1) != 0;
+    }
+
+    static int ToToggleIndex(MachineInput input) => input switch
+    {
+        MachineInput.Color           => ConsoleSwitch.GameBW - ConsoleSwitch.GameBW,
+        MachineInput.LeftDifficulty  => ConsoleSwitch.LeftDifficultyA - ConsoleSwitch.GameBW,
+        MachineInput.RightDifficulty => ConsoleSwitch.RightDifficultyA - ConsoleSwitch.GameBW,
+        _                            => -1
+    };
+
     void SetControllerActionState(int playerNo, ControllerAction action, bool value)
     {
         if (value)
@@ -330,4 +583,6 @@ public class InputState
     }
 
     #endregion
-}
\ No newline at end of file
+}
+
+readonly record struct InputEvent(int PlayerNo, MachineInput Input, bool Down, long Timestamp);
\ No newline at end of file
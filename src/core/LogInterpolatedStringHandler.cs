@@ -0,0 +1,72 @@
+/*
+ * LogInterpolatedStringHandler.cs
+ *
+ * Defers formatting of interpolated log messages until the logger level is known to enable them.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Runtime.CompilerServices;
+
+namespace EMU7800.Core;
+
+[InterpolatedStringHandler]
+public ref struct LogInterpolatedStringHandler
+{
+    DefaultInterpolatedStringHandler _builder;
+
+    public bool IsEnabled { get; }
+
+    public void AppendLiteral(string value)
+    {
+        if (IsEnabled)
+            _builder.AppendLiteral(value);
+    }
+
+    public void AppendFormatted<T>(T value)
+    {
+        if (IsEnabled)
+            _builder.AppendFormatted(value);
+    }
+
+    public void AppendFormatted<T>(T value, string? format)
+    {
+        if (IsEnabled)
+            _builder.AppendFormatted(value, format);
+    }
+
+    public void AppendFormatted<T>(T value, int alignment)
+    {
+        if (IsEnabled)
+            _builder.AppendFormatted(value, alignment);
+    }
+
+    public void AppendFormatted<T>(T value, int alignment, string? format)
+    {
+        if (IsEnabled)
+            _builder.AppendFormatted(value, alignment, format);
+    }
+
+    public void AppendFormatted(ReadOnlySpan<char> value)
+    {
+        if (IsEnabled)
+            _builder.AppendFormatted(value);
+    }
+
+    public string ToStringAndClear()
+        => IsEnabled ? _builder.ToStringAndClear() : string.Empty;
+
+    #region Constructors
+
+    public LogInterpolatedStringHandler(int literalLength, int formattedCount, ILogger logger, int level, out bool isEnabled)
+    {
+        IsEnabled = isEnabled = level <= logger.Level;
+        if (isEnabled)
+        {
+            _builder = new DefaultInterpolatedStringHandler(literalLength, formattedCount);
+        }
+    }
+
+    #endregion
+}
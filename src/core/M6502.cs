@@ -7,6 +7,7 @@
  *
  */
 using System;
+using System.Runtime.Serialization;
 using EMU7800.Core.Extensions;
 
 #pragma warning disable IDE1006 // Naming Styles
@@ -17,8 +18,6 @@ public sealed class M6502
 {
     public static readonly M6502 Default = new(MachineBase.Default, 1);
 
-    readonly Action[] Opcodes = new Action[0x100];
-
     const ushort
         // non-maskable interrupt vector
         NMI_VEC = 0xfffa,
@@ -35,6 +34,35 @@ public sealed class M6502
     public int RunClocks { get; set; }
     public int RunClocksMultiple { get; }
 
+    /// <summary>
+    /// When set, a record is written to the trace recorder for each executed instruction.
+    /// </summary>
+    public TraceRecorder? Tracer
+    {
+        get => field;
+        set
+        {
+            field = value;
+            Instrumented = Tracer is not null || Profiler is not null;
+            Mem.TracingAddressBus = Tracer is not null;
+        }
+    }
+
+    /// <summary>
+    /// When set, the executed instruction counts and cycles are accumulated by the profiler.
+    /// </summary>
+    public M6502Profiler? Profiler
+    {
+        get => field;
+        set
+        {
+            field = value;
+            Instrumented = Tracer is not null || Profiler is not null;
+        }
+    }
+
+    bool Instrumented;
+
     public bool EmulatorPreemptRequest { get; set; }
     public bool Jammed { get; set; }
     public bool IRQInterruptRequest { get; set; }
@@ -70,7 +98,7 @@ public sealed class M6502
 
         clk(6);
 
-        Log($"{this} (PC:${PC:x4}) reset");
+        M.Logger.Log(4, $"{this} (PC:${PC:x4}) reset");
     }
 
     public void Execute()
@@ -83,23 +111,84 @@ public sealed class M6502
             {
                 InterruptNMI();
                 NMIInterruptRequest = false;
+                Profiler?.Call(M.Cart.GetBankNo(PC), PC);
             }
             else if (IRQInterruptRequest)
             {
+                var taken = !fI;
                 InterruptIRQ();
                 IRQInterruptRequest = false;
+                if (taken)
+                    Profiler?.Call(M.Cart.GetBankNo(PC), PC);
+            }
+            else if (!Instrumented)
+            {
+                ExecuteOpcode(Mem[PC++]);
             }
             else
             {
-                Opcodes[Mem[PC++]]();
+                ExecuteInstrumented();
             }
         }
     }
 
-    private M6502()
+    void ExecuteInstrumented()
     {
-        InstallOpcodes();
+        var record = new TraceRecord
+        {
+            Clock = Clock,
+            PC    = PC,
+            A     = A,
+            X     = X,
+            Y     = Y,
+            S     = S,
+            P     = P,
+            Bank  = M.Cart.GetBankNo(PC),
+        };
+
+        var opCode = Mem[PC++];
+        FetchedOperands = 0;
+
+        ExecuteOpcode(opCode);
+
+        if (Profiler is not null)
+        {
+            Profiler.Charge(record.Bank, record.PC, (int)(Clock - record.Clock));
+            switch (opCode)
+            {
+                case 0x00: // BRK
+                case 0x20: // JSR
+                    Profiler.Call(M.Cart.GetBankNo(PC), PC);
+                    break;
+                case 0x40: // RTI
+                case 0x60: // RTS
+                    Profiler.Return();
+                    break;
+            }
+        }
+
+        if (Tracer is null)
+            return;
+
+        record.OpCode = opCode;
+        switch (M6502DASM.GetInstructionLength(opCode))
+        {
+            case 2:
+                record.Operand1 = (byte)FetchedOperands;
+                break;
+            case 3:
+                record.Operand1 = (byte)(FetchedOperands >> 8);
+                record.Operand2 = (byte)FetchedOperands;
+                break;
+        }
+        record.BusAddress = Mem.AddressBusState;
+        record.BusData    = Mem.DataBusState;
 
+        Tracer.Record(in record);
+    }
+
+    private M6502()
+    {
         Clock = 0;
         RunClocks = 0;
         RunClocksMultiple = 1;
@@ -116,6 +205,17 @@ public sealed class M6502
         RunClocksMultiple = runClocksMultiple;
     }
 
+    // the most recently fetched operand bytes, retained only while a trace recorder is attached
+    ushort FetchedOperands;
+
+    byte fetch()
+    {
+        var data = Mem[PC++];
+        if (Tracer is not null)
+            FetchedOperands = (ushort)(FetchedOperands << 8 | data);
+        return data;
+    }
+
     static byte MSB(ushort u16)
         => (byte)(u16 >> 8);
 
@@ -249,28 +349,27 @@ public sealed class M6502
     // Relative: Bxx $aa  (branch instructions only)
     ushort aREL()
     {
-        var bo = (sbyte)Mem[PC];
-        PC++;
+        var bo = (sbyte)fetch();
         return (ushort)(PC + bo);
     }
 
     // Zero Page: $aa
     ushort aZPG()
-        => WORD(Mem[PC++], 0x00);
+        => WORD(fetch(), 0x00);
 
     // Zero Page Indexed,X: $aa,X
     ushort aZPX()
-        => WORD((byte)(Mem[PC++] + X), 0x00);
+        => WORD((byte)(fetch() + X), 0x00);
 
     // Zero Page Indexed,Y: $aa,Y
     ushort aZPY()
-        => WORD((byte)(Mem[PC++] + Y), 0x00);
+        => WORD((byte)(fetch() + Y), 0x00);
 
     // Absolute: $aaaa
     ushort aABS()
     {
-        var lsb = Mem[PC++];
-        var msb = Mem[PC++];
+        var lsb = fetch();
+        var msb = fetch();
         return WORD(lsb, msb);
     }
 
@@ -299,7 +398,7 @@ public sealed class M6502
     // Indexed Indirect: ($aa,X)
     ushort aIDX()
     {
-        var zpa = (byte)(Mem[PC++] + X);
+        var zpa = (byte)(fetch() + X);
         var lsb = Mem[zpa++];
         var msb = Mem[zpa];
         return WORD(lsb, msb);
@@ -308,7 +407,7 @@ public sealed class M6502
     // Indirect Indexed: ($aa),Y
     ushort aIDY(int eclk)
     {
-        var zpa = Mem[PC++];
+        var zpa = fetch();
         var lsb = Mem[zpa++];
         var msb = Mem[zpa];
         if (lsb + Y > 0xff)
@@ -537,7 +636,7 @@ public sealed class M6502
     {
         if (M.NOPRegisterDumping)
         {
-            Log("NOP: " + M6502DASM.GetRegisters(this));
+            M.Logger.Log(4, $"NOP: {M6502DASM.GetRegisters(this)}");
         }
     }
 
@@ -715,7 +814,7 @@ public sealed class M6502
     void iKIL()
     {
         Jammed = true;
-        Log($"{this}: Processor jammed!");
+        M.Logger.Log(4, $"{this}: Processor jammed!");
     }
 
     // LAX: Load accumulator and index x
@@ -764,259 +863,261 @@ public sealed class M6502
         fC = (A & 0x80) != 0;
     }
 
-    void InstallOpcodes()
+    void ExecuteOpcode(byte opCode)
     {
         ushort EA;
 
-        Opcodes[0x65] = () => { EA = aZPG();  clk(3); iADC(Mem[EA]); };
-        Opcodes[0x75] = () => { EA = aZPX();  clk(4); iADC(Mem[EA]); };
-        Opcodes[0x61] = () => { EA = aIDX();  clk(6); iADC(Mem[EA]); };
-        Opcodes[0x71] = () => { EA = aIDY(1); clk(5); iADC(Mem[EA]); };
-        Opcodes[0x79] = () => { EA = aABY(1); clk(4); iADC(Mem[EA]); };
-        Opcodes[0x6d] = () => { EA = aABS();  clk(4); iADC(Mem[EA]); };
-        Opcodes[0x7d] = () => { EA = aABX(1); clk(4); iADC(Mem[EA]); };
-        Opcodes[0x69] = () => { /*aIMM*/      clk(2); iADC(Mem[PC++]); };
-
-        Opcodes[0x25] = () => { EA = aZPG();  clk(3); iAND(Mem[EA]); }; // may be 2 clk
-        Opcodes[0x35] = () => { EA = aZPX();  clk(4); iAND(Mem[EA]); }; // may be 3 clk
-        Opcodes[0x21] = () => { EA = aIDX();  clk(6); iAND(Mem[EA]); };
-        Opcodes[0x31] = () => { EA = aIDY(1); clk(5); iAND(Mem[EA]); };
-        Opcodes[0x2d] = () => { EA = aABS();  clk(4); iAND(Mem[EA]); };
-        Opcodes[0x39] = () => { EA = aABY(1); clk(4); iAND(Mem[EA]); };
-        Opcodes[0x3d] = () => { EA = aABX(1); clk(4); iAND(Mem[EA]); };
-        Opcodes[0x29] = () => {    /*aIMM*/   clk(2); iAND(Mem[PC++]); };
-
-        Opcodes[0x06] = () => { EA = aZPG();  clk(5); Mem[EA] = iASL(Mem[EA]); };
-        Opcodes[0x16] = () => { EA = aZPX();  clk(6); Mem[EA] = iASL(Mem[EA]); };
-        Opcodes[0x0e] = () => { EA = aABS();  clk(6); Mem[EA] = iASL(Mem[EA]); };
-        Opcodes[0x1e] = () => { EA = aABX(0); clk(7); Mem[EA] = iASL(Mem[EA]); };
-        Opcodes[0x0a] = () => {    /*aACC*/   clk(2);       A = iASL(A); };
-
-        Opcodes[0x24] = () => { EA = aZPG();  clk(3); iBIT(Mem[EA]); };
-        Opcodes[0x2c] = () => { EA = aABS();  clk(4); iBIT(Mem[EA]); };
-
-        Opcodes[0x10] = () => { EA = aREL();  clk(2); br(!fN, EA); /* BPL */ };
-        Opcodes[0x30] = () => { EA = aREL();  clk(2); br( fN, EA); /* BMI */ };
-        Opcodes[0x50] = () => { EA = aREL();  clk(2); br(!fV, EA); /* BVC */ };
-        Opcodes[0x70] = () => { EA = aREL();  clk(2); br( fV, EA); /* BVS */ };
-        Opcodes[0x90] = () => { EA = aREL();  clk(2); br(!fC, EA); /* BCC */ };
-        Opcodes[0xb0] = () => { EA = aREL();  clk(2); br( fC, EA); /* BCS */ };
-        Opcodes[0xd0] = () => { EA = aREL();  clk(2); br(!fZ, EA); /* BNE */ };
-        Opcodes[0xf0] = () => { EA = aREL();  clk(2); br( fZ, EA); /* BEQ */ };
-
-        Opcodes[0x00] = () => {    /*aIMP*/   clk(7); iBRK(); };
-
-        Opcodes[0x18] = () => {    /*aIMP*/   clk(2); iCLC(); };
-
-        Opcodes[0xd8] = () => {    /*aIMP*/   clk(2); iCLD(); };
-
-        Opcodes[0x58] = () => {    /*aIMP*/   clk(2); iCLI(); };
-
-        Opcodes[0xb8] = () => {    /*aIMP*/   clk(2); iCLV(); };
-
-        Opcodes[0xc5] = () => { EA = aZPG();  clk(3); iCMP(Mem[EA]); };
-        Opcodes[0xd5] = () => { EA = aZPX();  clk(4); iCMP(Mem[EA]); };
-        Opcodes[0xc1] = () => { EA = aIDX();  clk(6); iCMP(Mem[EA]); };
-        Opcodes[0xd1] = () => { EA = aIDY(1); clk(5); iCMP(Mem[EA]); };
-        Opcodes[0xcd] = () => { EA = aABS();  clk(4); iCMP(Mem[EA]); };
-        Opcodes[0xdd] = () => { EA = aABX(1); clk(4); iCMP(Mem[EA]); };
-        Opcodes[0xd9] = () => { EA = aABY(1); clk(4); iCMP(Mem[EA]); };
-        Opcodes[0xc9] = () => { /*aIMM*/      clk(2); iCMP(Mem[PC++]); };
-
-        Opcodes[0xe4] = () => { EA = aZPG();  clk(3); iCPX(Mem[EA]); };
-        Opcodes[0xec] = () => { EA = aABS();  clk(4); iCPX(Mem[EA]); };
-        Opcodes[0xe0] = () => { /*aIMM*/      clk(2); iCPX(Mem[PC++]); };
-
-        Opcodes[0xc4] = () => { EA = aZPG();  clk(3); iCPY(Mem[EA]); };
-        Opcodes[0xcc] = () => { EA = aABS();  clk(4); iCPY(Mem[EA]); };
-        Opcodes[0xc0] = () => { /*aIMM*/      clk(2); iCPY(Mem[PC++]); };
-
-        Opcodes[0xc6] = () => { EA = aZPG();  clk(5); Mem[EA] = iDEC(Mem[EA]); };
-        Opcodes[0xd6] = () => { EA = aZPX();  clk(6); Mem[EA] = iDEC(Mem[EA]); };
-        Opcodes[0xce] = () => { EA = aABS();  clk(6); Mem[EA] = iDEC(Mem[EA]); };
-        Opcodes[0xde] = () => { EA = aABX(0); clk(7); Mem[EA] = iDEC(Mem[EA]); };
-
-        Opcodes[0xca] = () => {    /*aIMP*/   clk(2); iDEX(); };
-
-        Opcodes[0x88] = () => {    /*aIMP*/   clk(2); iDEY(); };
-
-        Opcodes[0x45] = () => { EA = aZPG();  clk(3); iEOR(Mem[EA]); };
-        Opcodes[0x55] = () => { EA = aZPX();  clk(4); iEOR(Mem[EA]); };
-        Opcodes[0x41] = () => { EA = aIDX();  clk(6); iEOR(Mem[EA]); };
-        Opcodes[0x51] = () => { EA = aIDY(1); clk(5); iEOR(Mem[EA]); };
-        Opcodes[0x4d] = () => { EA = aABS();  clk(4); iEOR(Mem[EA]); };
-        Opcodes[0x5d] = () => { EA = aABX(1); clk(4); iEOR(Mem[EA]); };
-        Opcodes[0x59] = () => { EA = aABY(1); clk(4); iEOR(Mem[EA]); };
-        Opcodes[0x49] = () => {    /*aIMM*/   clk(2); iEOR(Mem[PC++]); };
-
-        Opcodes[0xe6] = () => { EA = aZPG();  clk(5); Mem[EA] = iINC(Mem[EA]); };
-        Opcodes[0xf6] = () => { EA = aZPX();  clk(6); Mem[EA] = iINC(Mem[EA]); };
-        Opcodes[0xee] = () => { EA = aABS();  clk(6); Mem[EA] = iINC(Mem[EA]); };
-        Opcodes[0xfe] = () => { EA = aABX(0); clk(7); Mem[EA] = iINC(Mem[EA]); };
-
-        Opcodes[0xe8] = () => {    /*aIMP*/   clk(2); iINX(); };
-
-        Opcodes[0xc8] = () => {    /*aIMP*/   clk(2); iINY(); };
-
-        Opcodes[0xa5] = () => { EA = aZPG();  clk(3); iLDA(Mem[EA]); };
-        Opcodes[0xb5] = () => { EA = aZPX();  clk(4); iLDA(Mem[EA]); };
-        Opcodes[0xa1] = () => { EA = aIDX();  clk(6); iLDA(Mem[EA]); };
-        Opcodes[0xb1] = () => { EA = aIDY(1); clk(5); iLDA(Mem[EA]); };
-        Opcodes[0xad] = () => { EA = aABS();  clk(4); iLDA(Mem[EA]); };
-        Opcodes[0xbd] = () => { EA = aABX(1); clk(4); iLDA(Mem[EA]); };
-        Opcodes[0xb9] = () => { EA = aABY(1); clk(4); iLDA(Mem[EA]); };
-        Opcodes[0xa9] = () => {    /*aIMM*/   clk(2); iLDA(Mem[PC++]); };
-
-        Opcodes[0xa6] = () => { EA = aZPG();  clk(3); iLDX(Mem[EA]); };
-        Opcodes[0xb6] = () => { EA = aZPY();  clk(4); iLDX(Mem[EA]); };
-        Opcodes[0xae] = () => { EA = aABS();  clk(4); iLDX(Mem[EA]); };
-        Opcodes[0xbe] = () => { EA = aABY(1); clk(4); iLDX(Mem[EA]); };
-        Opcodes[0xa2] = () => {    /*aIMM*/   clk(2); iLDX(Mem[PC++]); };
-
-        Opcodes[0xa4] = () => { EA = aZPG();  clk(3); iLDY(Mem[EA]); };
-        Opcodes[0xb4] = () => { EA = aZPX();  clk(4); iLDY(Mem[EA]); };
-        Opcodes[0xac] = () => { EA = aABS();  clk(4); iLDY(Mem[EA]); };
-        Opcodes[0xbc] = () => { EA = aABX(1); clk(4); iLDY(Mem[EA]); };
-        Opcodes[0xa0] = () => {    /*aIMM*/   clk(2); iLDY(Mem[PC++]); };
-
-        Opcodes[0x46] = () => { EA = aZPG();  clk(5); Mem[EA] = iLSR(Mem[EA]); };
-        Opcodes[0x56] = () => { EA = aZPX();  clk(6); Mem[EA] = iLSR(Mem[EA]); };
-        Opcodes[0x4e] = () => { EA = aABS();  clk(6); Mem[EA] = iLSR(Mem[EA]); };
-        Opcodes[0x5e] = () => { EA = aABX(0); clk(7); Mem[EA] = iLSR(Mem[EA]); };
-        Opcodes[0x4a] = () => {    /*aACC*/   clk(2);       A = iLSR(A); };
-
-        Opcodes[0x4c] = () => { EA = aABS();  clk(3); iJMP(EA); };
-        Opcodes[0x6c] = () => { EA = aIND();  clk(5); iJMP(EA); };
-
-        Opcodes[0x20] = () => { EA = aABS();  clk(6); iJSR(EA); };
-
-        Opcodes[0xea] = () => {    /*aIMP*/   clk(2); iNOP(); };
-
-        Opcodes[0x05] = () => { EA = aZPG();  clk(3); iORA(Mem[EA]); }; // may be 2 clk
-        Opcodes[0x15] = () => { EA = aZPX();  clk(4); iORA(Mem[EA]); }; // may be 3 clk
-        Opcodes[0x01] = () => { EA = aIDX();  clk(6); iORA(Mem[EA]); };
-        Opcodes[0x11] = () => { EA = aIDY(1); clk(5); iORA(Mem[EA]); };
-        Opcodes[0x0d] = () => { EA = aABS();  clk(4); iORA(Mem[EA]); };
-        Opcodes[0x1d] = () => { EA = aABX(1); clk(4); iORA(Mem[EA]); };
-        Opcodes[0x19] = () => { EA = aABY(1); clk(4); iORA(Mem[EA]); };
-        Opcodes[0x09] = () => {    /*aIMM*/   clk(2); iORA(Mem[PC++]); };
-
-        Opcodes[0x48] = () => {    /*aIMP*/   clk(3); iPHA(); };
-
-        Opcodes[0x68] = () => {    /*aIMP*/   clk(4); iPLA(); };
-
-        Opcodes[0x08] = () => {    /*aIMP*/   clk(3); iPHP(); };
-
-        Opcodes[0x28] = () => {    /*aIMP*/   clk(4); iPLP(); };
-
-        Opcodes[0x26] = () => { EA = aZPG();  clk(5); Mem[EA] = iROL(Mem[EA]); };
-        Opcodes[0x36] = () => { EA = aZPX();  clk(6); Mem[EA] = iROL(Mem[EA]); };
-        Opcodes[0x2e] = () => { EA = aABS();  clk(6); Mem[EA] = iROL(Mem[EA]); };
-        Opcodes[0x3e] = () => { EA = aABX(0); clk(7); Mem[EA] = iROL(Mem[EA]); };
-        Opcodes[0x2a] = () => {    /*aACC*/   clk(2);       A = iROL(A);       };
-
-        Opcodes[0x66] = () => { EA = aZPG();  clk(5); Mem[EA] = iROR(Mem[EA]); };
-        Opcodes[0x76] = () => { EA = aZPX();  clk(6); Mem[EA] = iROR(Mem[EA]); };
-        Opcodes[0x6e] = () => { EA = aABS();  clk(6); Mem[EA] = iROR(Mem[EA]); };
-        Opcodes[0x7e] = () => { EA = aABX(0); clk(7); Mem[EA] = iROR(Mem[EA]); };
-        Opcodes[0x6a] = () => {    /*aACC*/   clk(2);       A = iROR(A); };
-
-        Opcodes[0x40] = () => {    /*aIMP*/   clk(6); iRTI(); };
-
-        Opcodes[0x60] = () => {    /*aIMP*/   clk(6); iRTS(); };
-
-        Opcodes[0xe5] = () => { EA = aZPG();  clk(3); iSBC(Mem[EA]); };
-        Opcodes[0xf5] = () => { EA = aZPX();  clk(4); iSBC(Mem[EA]); };
-        Opcodes[0xe1] = () => { EA = aIDX();  clk(6); iSBC(Mem[EA]); };
-        Opcodes[0xf1] = () => { EA = aIDY(1); clk(5); iSBC(Mem[EA]); };
-        Opcodes[0xed] = () => { EA = aABS();  clk(4); iSBC(Mem[EA]); };
-        Opcodes[0xfd] = () => { EA = aABX(1); clk(4); iSBC(Mem[EA]); };
-        Opcodes[0xf9] = () => { EA = aABY(1); clk(4); iSBC(Mem[EA]); };
-        Opcodes[0xe9] = () => {    /*aIMM*/   clk(2); iSBC(Mem[PC++]); };
-
-        Opcodes[0x38] = () => {    /*aIMP*/   clk(2); iSEC(); };
-
-        Opcodes[0xf8] = () => {    /*aIMP*/   clk(2); iSED(); };
+        switch (opCode)
+        {
+            case 0x65: EA = aZPG();  clk(3); iADC(Mem[EA]); break;
+            case 0x75: EA = aZPX();  clk(4); iADC(Mem[EA]); break;
+            case 0x61: EA = aIDX();  clk(6); iADC(Mem[EA]); break;
+            case 0x71: EA = aIDY(1); clk(5); iADC(Mem[EA]); break;
+            case 0x79: EA = aABY(1); clk(4); iADC(Mem[EA]); break;
+            case 0x6d: EA = aABS();  clk(4); iADC(Mem[EA]); break;
+            case 0x7d: EA = aABX(1); clk(4); iADC(Mem[EA]); break;
+            case 0x69: /*aIMM*/      clk(2); iADC(fetch()); break;
+
+            case 0x25: EA = aZPG();  clk(3); iAND(Mem[EA]); break; // may be 2 clk
+            case 0x35: EA = aZPX();  clk(4); iAND(Mem[EA]); break; // may be 3 clk
+            case 0x21: EA = aIDX();  clk(6); iAND(Mem[EA]); break;
+            case 0x31: EA = aIDY(1); clk(5); iAND(Mem[EA]); break;
+            case 0x2d: EA = aABS();  clk(4); iAND(Mem[EA]); break;
+            case 0x39: EA = aABY(1); clk(4); iAND(Mem[EA]); break;
+            case 0x3d: EA = aABX(1); clk(4); iAND(Mem[EA]); break;
+            case 0x29: /*aIMM*/      clk(2); iAND(fetch()); break;
+
+            case 0x06: EA = aZPG();  clk(5); Mem[EA] = iASL(Mem[EA]); break;
+            case 0x16: EA = aZPX();  clk(6); Mem[EA] = iASL(Mem[EA]); break;
+            case 0x0e: EA = aABS();  clk(6); Mem[EA] = iASL(Mem[EA]); break;
+            case 0x1e: EA = aABX(0); clk(7); Mem[EA] = iASL(Mem[EA]); break;
+            case 0x0a: /*aACC*/      clk(2);       A = iASL(A); break;
+
+            case 0x24: EA = aZPG();  clk(3); iBIT(Mem[EA]); break;
+            case 0x2c: EA = aABS();  clk(4); iBIT(Mem[EA]); break;
+
+            case 0x10: EA = aREL();  clk(2); br(!fN, EA); /* BPL */ break;
+            case 0x30: EA = aREL();  clk(2); br( fN, EA); /* BMI */ break;
+            case 0x50: EA = aREL();  clk(2); br(!fV, EA); /* BVC */ break;
+            case 0x70: EA = aREL();  clk(2); br( fV, EA); /* BVS */ break;
+            case 0x90: EA = aREL();  clk(2); br(!fC, EA); /* BCC */ break;
+            case 0xb0: EA = aREL();  clk(2); br( fC, EA); /* BCS */ break;
+            case 0xd0: EA = aREL();  clk(2); br(!fZ, EA); /* BNE */ break;
+            case 0xf0: EA = aREL();  clk(2); br( fZ, EA); /* BEQ */ break;
+
+            case 0x00: /*aIMP*/      clk(7); iBRK(); break;
+
+            case 0x18: /*aIMP*/      clk(2); iCLC(); break;
+
+            case 0xd8: /*aIMP*/      clk(2); iCLD(); break;
+
+            case 0x58: /*aIMP*/      clk(2); iCLI(); break;
+
+            case 0xb8: /*aIMP*/      clk(2); iCLV(); break;
+
+            case 0xc5: EA = aZPG();  clk(3); iCMP(Mem[EA]); break;
+            case 0xd5: EA = aZPX();  clk(4); iCMP(Mem[EA]); break;
+            case 0xc1: EA = aIDX();  clk(6); iCMP(Mem[EA]); break;
+            case 0xd1: EA = aIDY(1); clk(5); iCMP(Mem[EA]); break;
+            case 0xcd: EA = aABS();  clk(4); iCMP(Mem[EA]); break;
+            case 0xdd: EA = aABX(1); clk(4); iCMP(Mem[EA]); break;
+            case 0xd9: EA = aABY(1); clk(4); iCMP(Mem[EA]); break;
+            case 0xc9: /*aIMM*/      clk(2); iCMP(fetch()); break;
+
+            case 0xe4: EA = aZPG();  clk(3); iCPX(Mem[EA]); break;
+            case 0xec: EA = aABS();  clk(4); iCPX(Mem[EA]); break;
+            case 0xe0: /*aIMM*/      clk(2); iCPX(fetch()); break;
+
+            case 0xc4: EA = aZPG();  clk(3); iCPY(Mem[EA]); break;
+            case 0xcc: EA = aABS();  clk(4); iCPY(Mem[EA]); break;
+            case 0xc0: /*aIMM*/      clk(2); iCPY(fetch()); break;
+
+            case 0xc6: EA = aZPG();  clk(5); Mem[EA] = iDEC(Mem[EA]); break;
+            case 0xd6: EA = aZPX();  clk(6); Mem[EA] = iDEC(Mem[EA]); break;
+            case 0xce: EA = aABS();  clk(6); Mem[EA] = iDEC(Mem[EA]); break;
+            case 0xde: EA = aABX(0); clk(7); Mem[EA] = iDEC(Mem[EA]); break;
+
+            case 0xca: /*aIMP*/      clk(2); iDEX(); break;
+
+            case 0x88: /*aIMP*/      clk(2); iDEY(); break;
+
+            case 0x45: EA = aZPG();  clk(3); iEOR(Mem[EA]); break;
+            case 0x55: EA = aZPX();  clk(4); iEOR(Mem[EA]); break;
+            case 0x41: EA = aIDX();  clk(6); iEOR(Mem[EA]); break;
+            case 0x51: EA = aIDY(1); clk(5); iEOR(Mem[EA]); break;
+            case 0x4d: EA = aABS();  clk(4); iEOR(Mem[EA]); break;
+            case 0x5d: EA = aABX(1); clk(4); iEOR(Mem[EA]); break;
+            case 0x59: EA = aABY(1); clk(4); iEOR(Mem[EA]); break;
+            case 0x49: /*aIMM*/      clk(2); iEOR(fetch()); break;
+
+            case 0xe6: EA = aZPG();  clk(5); Mem[EA] = iINC(Mem[EA]); break;
+            case 0xf6: EA = aZPX();  clk(6); Mem[EA] = iINC(Mem[EA]); break;
+            case 0xee: EA = aABS();  clk(6); Mem[EA] = iINC(Mem[EA]); break;
+            case 0xfe: EA = aABX(0); clk(7); Mem[EA] = iINC(Mem[EA]); break;
+
+            case 0xe8: /*aIMP*/      clk(2); iINX(); break;
+
+            case 0xc8: /*aIMP*/      clk(2); iINY(); break;
+
+            case 0xa5: EA = aZPG();  clk(3); iLDA(Mem[EA]); break;
+            case 0xb5: EA = aZPX();  clk(4); iLDA(Mem[EA]); break;
+            case 0xa1: EA = aIDX();  clk(6); iLDA(Mem[EA]); break;
+            case 0xb1: EA = aIDY(1); clk(5); iLDA(Mem[EA]); break;
+            case 0xad: EA = aABS();  clk(4); iLDA(Mem[EA]); break;
+            case 0xbd: EA = aABX(1); clk(4); iLDA(Mem[EA]); break;
+            case 0xb9: EA = aABY(1); clk(4); iLDA(Mem[EA]); break;
+            case 0xa9: /*aIMM*/      clk(2); iLDA(fetch()); break;
+
+            case 0xa6: EA = aZPG();  clk(3); iLDX(Mem[EA]); break;
+            case 0xb6: EA = aZPY();  clk(4); iLDX(Mem[EA]); break;
+            case 0xae: EA = aABS();  clk(4); iLDX(Mem[EA]); break;
+            case 0xbe: EA = aABY(1); clk(4); iLDX(Mem[EA]); break;
+            case 0xa2: /*aIMM*/      clk(2); iLDX(fetch()); break;
 
-        Opcodes[0x78] = () => {    /*aIMP*/   clk(2); iSEI(); };
+            case 0xa4: EA = aZPG();  clk(3); iLDY(Mem[EA]); break;
+            case 0xb4: EA = aZPX();  clk(4); iLDY(Mem[EA]); break;
+            case 0xac: EA = aABS();  clk(4); iLDY(Mem[EA]); break;
+            case 0xbc: EA = aABX(1); clk(4); iLDY(Mem[EA]); break;
+            case 0xa0: /*aIMM*/      clk(2); iLDY(fetch()); break;
 
-        Opcodes[0x85] = () => { EA = aZPG();  clk(3); Mem[EA] = iSTA(); };
-        Opcodes[0x95] = () => { EA = aZPX();  clk(4); Mem[EA] = iSTA(); };
-        Opcodes[0x81] = () => { EA = aIDX();  clk(6); Mem[EA] = iSTA(); };
-        Opcodes[0x91] = () => { EA = aIDY(0); clk(6); Mem[EA] = iSTA(); };
-        Opcodes[0x8d] = () => { EA = aABS();  clk(4); Mem[EA] = iSTA(); };
-        Opcodes[0x99] = () => { EA = aABY(0); clk(5); Mem[EA] = iSTA(); };
-        Opcodes[0x9d] = () => { EA = aABX(0); clk(5); Mem[EA] = iSTA(); };
+            case 0x46: EA = aZPG();  clk(5); Mem[EA] = iLSR(Mem[EA]); break;
+            case 0x56: EA = aZPX();  clk(6); Mem[EA] = iLSR(Mem[EA]); break;
+            case 0x4e: EA = aABS();  clk(6); Mem[EA] = iLSR(Mem[EA]); break;
+            case 0x5e: EA = aABX(0); clk(7); Mem[EA] = iLSR(Mem[EA]); break;
+            case 0x4a: /*aACC*/      clk(2);       A = iLSR(A); break;
 
-        Opcodes[0x86] = () => { EA = aZPG();  clk(3); Mem[EA] = iSTX(); };
-        Opcodes[0x96] = () => { EA = aZPY();  clk(4); Mem[EA] = iSTX(); };
-        Opcodes[0x8e] = () => { EA = aABS();  clk(4); Mem[EA] = iSTX(); };
+            case 0x4c: EA = aABS();  clk(3); iJMP(EA); break;
+            case 0x6c: EA = aIND();  clk(5); iJMP(EA); break;
 
-        Opcodes[0x84] = () => { EA = aZPG();  clk(3); Mem[EA] = iSTY(); };
-        Opcodes[0x94] = () => { EA = aZPX();  clk(4); Mem[EA] = iSTY(); };
-        Opcodes[0x8c] = () => { EA = aABS();  clk(4); Mem[EA] = iSTY(); };
+            case 0x20: EA = aABS();  clk(6); iJSR(EA); break;
 
-        Opcodes[0xaa] = () => {    /*aIMP*/   clk(2); iTAX(); };
+            case 0xea: /*aIMP*/      clk(2); iNOP(); break;
 
-        Opcodes[0xa8] = () => {    /*aIMP*/   clk(2); iTAY(); };
+            case 0x05: EA = aZPG();  clk(3); iORA(Mem[EA]); break; // may be 2 clk
+            case 0x15: EA = aZPX();  clk(4); iORA(Mem[EA]); break; // may be 3 clk
+            case 0x01: EA = aIDX();  clk(6); iORA(Mem[EA]); break;
+            case 0x11: EA = aIDY(1); clk(5); iORA(Mem[EA]); break;
+            case 0x0d: EA = aABS();  clk(4); iORA(Mem[EA]); break;
+            case 0x1d: EA = aABX(1); clk(4); iORA(Mem[EA]); break;
+            case 0x19: EA = aABY(1); clk(4); iORA(Mem[EA]); break;
+            case 0x09: /*aIMM*/      clk(2); iORA(fetch()); break;
 
-        Opcodes[0xba] = () => {    /*aIMP*/   clk(2); iTSX(); };
+            case 0x48: /*aIMP*/      clk(3); iPHA(); break;
 
-        Opcodes[0x8a] = () => {    /*aIMP*/   clk(2); iTXA(); };
+            case 0x68: /*aIMP*/      clk(4); iPLA(); break;
 
-        Opcodes[0x9a] = () => {    /*aIMP*/   clk(2); iTXS(); };
+            case 0x08: /*aIMP*/      clk(3); iPHP(); break;
+
+            case 0x28: /*aIMP*/      clk(4); iPLP(); break;
+
+            case 0x26: EA = aZPG();  clk(5); Mem[EA] = iROL(Mem[EA]); break;
+            case 0x36: EA = aZPX();  clk(6); Mem[EA] = iROL(Mem[EA]); break;
+            case 0x2e: EA = aABS();  clk(6); Mem[EA] = iROL(Mem[EA]); break;
+            case 0x3e: EA = aABX(0); clk(7); Mem[EA] = iROL(Mem[EA]); break;
+            case 0x2a: /*aACC*/      clk(2);       A = iROL(A); break;
+
+            case 0x66: EA = aZPG();  clk(5); Mem[EA] = iROR(Mem[EA]); break;
+            case 0x76: EA = aZPX();  clk(6); Mem[EA] = iROR(Mem[EA]); break;
+            case 0x6e: EA = aABS();  clk(6); Mem[EA] = iROR(Mem[EA]); break;
+            case 0x7e: EA = aABX(0); clk(7); Mem[EA] = iROR(Mem[EA]); break;
+            case 0x6a: /*aACC*/      clk(2);       A = iROR(A); break;
+
+            case 0x40: /*aIMP*/      clk(6); iRTI(); break;
+
+            case 0x60: /*aIMP*/      clk(6); iRTS(); break;
+
+            case 0xe5: EA = aZPG();  clk(3); iSBC(Mem[EA]); break;
+            case 0xf5: EA = aZPX();  clk(4); iSBC(Mem[EA]); break;
+            case 0xe1: EA = aIDX();  clk(6); iSBC(Mem[EA]); break;
+            case 0xf1: EA = aIDY(1); clk(5); iSBC(Mem[EA]); break;
+            case 0xed: EA = aABS();  clk(4); iSBC(Mem[EA]); break;
+            case 0xfd: EA = aABX(1); clk(4); iSBC(Mem[EA]); break;
+            case 0xf9: EA = aABY(1); clk(4); iSBC(Mem[EA]); break;
+            case 0xe9: /*aIMM*/      clk(2); iSBC(fetch()); break;
+
+            case 0x38: /*aIMP*/      clk(2); iSEC(); break;
+
+            case 0xf8: /*aIMP*/      clk(2); iSED(); break;
+
+            case 0x78: /*aIMP*/      clk(2); iSEI(); break;
+
+            case 0x85: EA = aZPG();  clk(3); Mem[EA] = iSTA(); break;
+            case 0x95: EA = aZPX();  clk(4); Mem[EA] = iSTA(); break;
+            case 0x81: EA = aIDX();  clk(6); Mem[EA] = iSTA(); break;
+            case 0x91: EA = aIDY(0); clk(6); Mem[EA] = iSTA(); break;
+            case 0x8d: EA = aABS();  clk(4); Mem[EA] = iSTA(); break;
+            case 0x99: EA = aABY(0); clk(5); Mem[EA] = iSTA(); break;
+            case 0x9d: EA = aABX(0); clk(5); Mem[EA] = iSTA(); break;
+
+            case 0x86: EA = aZPG();  clk(3); Mem[EA] = iSTX(); break;
+            case 0x96: EA = aZPY();  clk(4); Mem[EA] = iSTX(); break;
+            case 0x8e: EA = aABS();  clk(4); Mem[EA] = iSTX(); break;
+
+            case 0x84: EA = aZPG();  clk(3); Mem[EA] = iSTY(); break;
+            case 0x94: EA = aZPX();  clk(4); Mem[EA] = iSTY(); break;
+            case 0x8c: EA = aABS();  clk(4); Mem[EA] = iSTY(); break;
+
+            case 0xaa: /*aIMP*/      clk(2); iTAX(); break;
+
+            case 0xa8: /*aIMP*/      clk(2); iTAY(); break;
+
+            case 0xba: /*aIMP*/      clk(2); iTSX(); break;
+
+            case 0x8a: /*aIMP*/      clk(2); iTXA(); break;
+
+            case 0x9a: /*aIMP*/      clk(2); iTXS(); break;
 
-        Opcodes[0x98] = () => {    /*aIMP*/   clk(2); iTYA(); };
+            case 0x98: /*aIMP*/      clk(2); iTYA(); break;
+
+            // Illegal opcodes
 
-        // Illegal opcodes
+            // DOP (SKB) - no operation, double NOP, skip byte - required for Medieval Mayhem
+            case 0x04: clk(3); fetch(); iNOP(); break;
 
-        // DOP (SKB) - no operation, double NOP, skip byte - required for Medieval Mayhem
-        Opcodes[0x04] = () => { clk(3); PC++; iNOP(); };
+            // ALR (ASR) - required for Popeye and Ghost n' Goblins
+            case 0x4b: /*aIMM*/      clk(2); iALR(fetch()); break;
 
-        // ALR (ASR) - required for Popeye and Ghost n' Goblins
-        Opcodes[0x4b] = () => {    /*aIMM*/   clk(2); iALR(Mem[PC++]); };
+            // ANC - required for Popeye and Ghost n' Goblins
+            case 0x0b:
+            case 0x2b: /*aIMM*/      clk(2); iANC(fetch()); break;
 
-        // ANC - required for Popeye and Ghost n' Goblins
-        Opcodes[0x0b] = () => {    /*aIMM*/   clk(2); iANC(Mem[PC++]); };
-        Opcodes[0x2b] = Opcodes[0x0b];
+            case 0x02: case 0x12: case 0x22: case 0x32: case 0x42: case 0x52:
+            case 0x62: case 0x72: case 0x92: case 0xb2: case 0xd2: case 0xf2:
+                clk(2); iKIL(); break;
+            case 0x3f: EA = aABX(0); clk(4); iRLA(Mem[EA]); break;
+            case 0xa7: EA = aZPX();  clk(3); iLAX(Mem[EA]); break;
+            case 0xb3: EA = aIDY(0); clk(6); iLAX(Mem[EA]); break;
+            case 0xef: EA = aABS();  clk(6); iISB(Mem[EA]); break;
+            case 0x0c: EA = aABS();  clk(2); iNOP(); break;
+            case 0x1c: case 0x3c: case 0x5c: case 0x7c: case 0x9c: case 0xdc: case 0xfc:
+                EA = aABX(0); clk(2); iNOP(); break;
+            case 0x83: EA = aIDX();  clk(6); Mem[EA] = iSAX(); break;
+            case 0x87: EA = aZPG();  clk(3); Mem[EA] = iSAX(); break;
+            case 0x8f: EA = aABS();  clk(4); Mem[EA] = iSAX(); break;
+            case 0x97: EA = aZPY();  clk(4); Mem[EA] = iSAX(); break;
+            case 0xa3: EA = aIDX();  clk(6); iLAX(Mem[EA]); break;
+            case 0xb7: EA = aZPY();  clk(4); iLAX(Mem[EA]); break;
+            case 0xaf: EA = aABS();  clk(5); iLAX(Mem[EA]); break;
+            case 0xbf: EA = aABY(0); clk(6); iLAX(Mem[EA]); break;
+            case 0xff: EA = aABX(0); clk(7); iISB(Mem[EA]); break;
 
-        foreach (var opCode in new ushort[] { 0x02, 0x12, 0x22, 0x32, 0x42, 0x52, 0x62, 0x72, 0x92, 0xb2, 0xd2, 0xf2 })
-        {
-            Opcodes[opCode] = () => { clk(2); iKIL(); };
-        }
-        Opcodes[0x3f] = () => { EA = aABX(0); clk(4); iRLA(Mem[EA]); };
-        Opcodes[0xa7] = () => { EA = aZPX();  clk(3); iLAX(Mem[EA]); };
-        Opcodes[0xb3] = () => { EA = aIDY(0); clk(6); iLAX(Mem[EA]); };
-        Opcodes[0xef] = () => { EA = aABS();  clk(6); iISB(Mem[EA]); };
-        Opcodes[0x0c] = () => { EA = aABS();  clk(2); iNOP(); };
-        foreach (var opCode in new ushort[] { 0x1c, 0x3c, 0x5c, 0x7c, 0x9c, 0xdc, 0xfc })
-        {
-            Opcodes[opCode] = () => { EA = aABX(0); clk(2); iNOP(); };
-        }
-        Opcodes[0x83] = () => { EA = aIDX();  clk(6); Mem[EA] = iSAX(); };
-        Opcodes[0x87] = () => { EA = aZPG();  clk(3); Mem[EA] = iSAX(); };
-        Opcodes[0x8f] = () => { EA = aABS();  clk(4); Mem[EA] = iSAX(); };
-        Opcodes[0x97] = () => { EA = aZPY();  clk(4); Mem[EA] = iSAX(); };
-        Opcodes[0xa3] = () => { EA = aIDX();  clk(6); iLAX(Mem[EA]); };
-        Opcodes[0xb7] = () => { EA = aZPY();  clk(4); iLAX(Mem[EA]); };
-        Opcodes[0xaf] = () => { EA = aABS();  clk(5); iLAX(Mem[EA]); };
-        Opcodes[0xbf] = () => { EA = aABY(0); clk(6); iLAX(Mem[EA]); };
-        Opcodes[0xff] = () => { EA = aABX(0); clk(7); iISB(Mem[EA]); };
-
-        for (var i=0; i < Opcodes.Length; i++)
-        {
-            Opcodes[i] ??= () => Log($"{this}:**UNKNOWN OPCODE: ${Mem[(ushort)(PC - 1)]:x2} at ${PC - 1:x4}\n");
+            default:
+                M.Logger.Log(4, $"{this}:**UNKNOWN OPCODE: ${Mem[(ushort)(PC - 1)]:x2} at ${PC - 1:x4}\n");
+                break;
         }
     }
 
     #region Serialization Members
 
     public M6502(DeserializationContext input, MachineBase m, int runClocksMultiple) : this(m, runClocksMultiple)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
         input.CheckVersion(1);
         Clock = input.ReadUInt64();
         RunClocks = input.ReadInt32();
-        RunClocksMultiple = input.ReadInt32();
+        SerializationException.ThrowIf(input.ReadInt32() != RunClocksMultiple, "RunClocksMultiple incorrect");
         EmulatorPreemptRequest = input.ReadBoolean();
         Jammed = input.ReadBoolean();
         IRQInterruptRequest = input.ReadBoolean();
@@ -1048,11 +1149,4 @@ public sealed class M6502
     }
 
     #endregion
-
-    #region Helpers
-
-    void Log(string message)
-        => M.Logger.Log(4, message);
-
-    #endregion
 }
\ No newline at end of file
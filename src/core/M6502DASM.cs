@@ -99,15 +99,21 @@ public static class M6502DASM
 ];
 
     public static string GetRegisters(M6502 cpu)
+        => GetRegisters(cpu.PC, cpu.A, cpu.X, cpu.Y, cpu.S, cpu.P);
+
+    public static string GetRegisters(in TraceRecord record)
+        => GetRegisters(record.PC, record.A, record.X, record.Y, record.S, record.P);
+
+    static string GetRegisters(ushort pc, byte a, byte x, byte y, byte s, byte p)
     {
         var dSB = new StringBuilder();
-        dSB.Append($"PC:{cpu.PC:x4} A:{cpu.A:x2} X:{cpu.X:x2} Y:{cpu.Y:x2} S:{cpu.S:x2} P:");
+        dSB.Append($"PC:{pc:x4} A:{a:x2} X:{x:x2} Y:{y:x2} S:{s:x2} P:");
 
         const string flags = "nv0bdizcNV1BDIZC";
 
         for (var i = 0; i < 8; i++)
         {
-            dSB.Append((cpu.P & (1 << (7 - i))) == 0 ? flags[i] : flags[i + 8]);
+            dSB.Append((p & (1 << (7 - i))) == 0 ? flags[i] : flags[i + 8]);
         }
         return dSB.ToString();
     }
@@ -184,14 +190,37 @@ public static class M6502DASM
         return $"{MnemonicMatrix[addrSpace[PC]]} {addrmodeStr}";
     }
 
-    static int GetInstructionLength(AddressSpace addrSpace, ushort PC)
-        => AddressingModeMatrix[addrSpace[PC]] switch
+    public static string RenderOpCode(ushort PC, byte opCode, byte operand1, byte operand2)
+    {
+        var num_operands = GetInstructionLength(opCode) - 1;
+        var ea = (ushort)(operand1 | (num_operands == 2 ? operand2 << 8 : 0));
+        var eaStr = num_operands == 1 ? $"${ea:x2}" : $"${ea:x4}";
+        var addrmodeStr = AddressingModeMatrix[opCode] switch
+        {
+            A.REL          => $"${(ushort)(PC + (sbyte)operand1 + 2):x4}",
+            A.ZPG or A.ABS => eaStr,
+            A.ZPX or A.ABX => eaStr + ",X",
+            A.ZPY or A.ABY => eaStr + ",Y",
+            A.IDX          => "(" + eaStr + ",X)",
+            A.IDY          => "(" + eaStr + "),Y",
+            A.IND          => "(" + eaStr + ")",
+            A.IMM          => "#" + eaStr,
+            _              => string.Empty // a.IMP, a.ACC
+        };
+        return $"{MnemonicMatrix[opCode]} {addrmodeStr}";
+    }
+
+    public static int GetInstructionLength(byte opCode)
+        => AddressingModeMatrix[opCode] switch
         {
             A.ACC or A.IMP => 1,
             A.REL or A.ZPG or A.ZPX or A.ZPY or A.IDX or A.IDY or A.IMM => 2,
             _ => 3
         };
 
+    static int GetInstructionLength(AddressSpace addrSpace, ushort PC)
+        => GetInstructionLength(addrSpace[PC]);
+
     static string RenderEA(AddressSpace addrSpace, ushort PC, int bytes)
     {
         var lsb = addrSpace[PC];
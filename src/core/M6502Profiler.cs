@@ -0,0 +1,223 @@
+/*
+ * M6502Profiler.cs
+ *
+ * Exact instruction-level profiler for the 6502 CPU.
+ *
+ * Instruction counts and cycles are accumulated per (bank, PC) in flat preallocated arrays.
+ * Cycles the CPU spends stalled on behalf of an instruction (TIA WSYNC, Maria WSYNC and DMA)
+ * are charged to the instruction that was executing when the stall began.
+ *
+ * Cycles are also accumulated per call stack, tracked from JSR, BRK and interrupts to the matching
+ * RTS or RTI, for export as folded stacks. Code that returns through RTS without a matching call,
+ * e.g. an RTS used as an indirect jump, is charged to the caller's stack.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class M6502Profiler
+{
+    const int DefaultBankBits = 4, MaxCallDepth = 64;
+
+    readonly uint[] _instructions;
+    readonly ulong[] _cycles;
+    readonly ulong[] _stallCycles;
+    readonly int _bankMask;
+
+    int _lastIndex;
+
+    // Call stacks form a tree; node 0 is the root, and each other node is a call from its parent to a (bank, address).
+    readonly List<(int Parent, int Frame)> _nodes = [(-1, -1)];
+    readonly Dictionary<(int Parent, int Frame), int> _children = [];
+    ulong[] _nodeCycles = new ulong[0x100];
+    ulong[] _nodeStallCycles = new ulong[0x100];
+    readonly int[] _callStack = new int[MaxCallDepth];
+    int _callDepth, _untrackedCalls, _node, _lastNode;
+
+    /// <summary>
+    /// Total number of instructions profiled.
+    /// </summary>
+    public ulong TotalInstructions { get; private set; }
+
+    /// <summary>
+    /// Total number of CPU cycles spent executing profiled instructions.
+    /// </summary>
+    public ulong TotalCycles { get; private set; }
+
+    /// <summary>
+    /// Total number of CPU cycles lost to WSYNC and DMA stalls.
+    /// </summary>
+    public ulong TotalStallCycles { get; private set; }
+
+    /// <summary>
+    /// Number of distinct banks tracked; higher bank numbers share slots modulo this value.
+    /// </summary>
+    public int Banks => _bankMask + 1;
+
+    public void Charge(byte bank, ushort pc, int cycles)
+    {
+        var i = (bank & _bankMask) << 16 | pc;
+        _instructions[i]++;
+        _cycles[i] += (ulong)cycles;
+        _lastIndex = i;
+        _nodeCycles[_node] += (ulong)cycles;
+        _lastNode = _node;
+        TotalInstructions++;
+        TotalCycles += (ulong)cycles;
+    }
+
+    /// <summary>
+    /// Enters the routine at the specified location, following a JSR, BRK or interrupt.
+    /// </summary>
+    public void Call(byte bank, ushort pc)
+    {
+        if (_callDepth == MaxCallDepth)
+        {
+            _untrackedCalls++;
+            return;
+        }
+
+        var frame = (bank & _bankMask) << 16 | pc;
+        if (!_children.TryGetValue((_node, frame), out var child))
+        {
+            child = _nodes.Count;
+            _nodes.Add((_node, frame));
+            _children.Add((_node, frame), child);
+            if (child == _nodeCycles.Length)
+            {
+                Array.Resize(ref _nodeCycles, 2 * child);
+                Array.Resize(ref _nodeStallCycles, 2 * child);
+            }
+        }
+
+        _callStack[_callDepth++] = _node;
+        _node = child;
+    }
+
+    /// <summary>
+    /// Leaves the current routine, following an RTS or RTI.
+    /// </summary>
+    public void Return()
+    {
+        if (_untrackedCalls > 0)
+            _untrackedCalls--;
+        else if (_callDepth > 0)
+            _node = _callStack[--_callDepth];
+    }
+
+    /// <summary>
+    /// Charges stalled CPU cycles to the most recently executed instruction.
+    /// </summary>
+    public void ChargeStall(int cycles)
+    {
+        if (cycles <= 0)
+            return;
+        _stallCycles[_lastIndex] += (ulong)cycles;
+        _nodeStallCycles[_lastNode] += (ulong)cycles;
+        TotalStallCycles += (ulong)cycles;
+    }
+
+    public void Clear()
+    {
+        Array.Clear(_instructions);
+        Array.Clear(_cycles);
+        Array.Clear(_stallCycles);
+        _lastIndex = 0;
+        _nodes.RemoveRange(1, _nodes.Count - 1);
+        _children.Clear();
+        Array.Clear(_nodeCycles);
+        Array.Clear(_nodeStallCycles);
+        _callDepth = _untrackedCalls = _node = _lastNode = 0;
+        TotalInstructions = TotalCycles = TotalStallCycles = 0;
+    }
+
+    /// <summary>
+    /// Returns the profiled locations ordered by descending total (execution + stall) cycles.
+    /// </summary>
+    public IEnumerable<M6502ProfileEntry> GetEntries()
+    {
+        var entries = new List<M6502ProfileEntry>();
+        for (var i = 0; i < _instructions.Length; i++)
+        {
+            if (_instructions[i] == 0)
+                continue;
+            entries.Add(new((byte)(i >> 16), (ushort)i, _instructions[i], _cycles[i], _stallCycles[i]));
+        }
+        return entries.OrderByDescending(e => e.Cycles + e.StallCycles);
+    }
+
+    /// <summary>
+    /// Writes the profile in folded-stack format suitable for flame graph tools.
+    /// Each line is <c>[root];caller;...;callee cycles</c>, where each frame is the symbol at the routine's entry, if any,
+    /// else its bank and address. Stall cycles are written as a <c>[stall]</c> frame below the routine they were charged to.
+    /// </summary>
+    public void WriteFoldedStacks(TextWriter writer, M6502SymbolTable? symbols = null)
+    {
+        var paths = new string[_nodes.Count];
+        paths[0] = "[root]";
+        for (var node = 1; node < _nodes.Count; node++)
+        {
+            // Parents are always created before their children.
+            var (parent, frame) = _nodes[node];
+            var bank = (byte)(frame >> 16);
+            var pc = (ushort)frame;
+            paths[node] = $"{paths[parent]};{symbols?.Lookup(bank, pc) ?? $"bank{bank}:${pc:x4}"}";
+        }
+
+        for (var node = 0; node < _nodes.Count; node++)
+        {
+            if (_nodeCycles[node] > 0)
+            {
+                writer.Write($"{paths[node]} {_nodeCycles[node]}\n");
+            }
+            if (_nodeStallCycles[node] > 0)
+            {
+                writer.Write($"{paths[node]};[stall] {_nodeStallCycles[node]}\n");
+            }
+        }
+    }
+
+    /// <summary>
+    /// Writes a human readable summary of the hottest locations.
+    /// </summary>
+    public void WriteReport(TextWriter writer, int maxEntries, M6502SymbolTable? symbols = null)
+    {
+        var total = Math.Max(1UL, TotalCycles + TotalStallCycles);
+        writer.WriteLine($"{TotalInstructions} instructions, {TotalCycles} cycles, {TotalStallCycles} stall cycles");
+        writer.WriteLine("  bank:addr       count       cycles        stall      %  label");
+        foreach (var e in GetEntries().Take(maxEntries))
+        {
+            var pct = 100.0 * (e.Cycles + e.StallCycles) / total;
+            writer.WriteLine($"  {e.Bank,4}:{e.PC:x4} {e.Instructions,10} {e.Cycles,12} {e.StallCycles,12} {pct,6:0.00}  {symbols?.Lookup(e.Bank, e.PC)}");
+        }
+    }
+
+    #region Constructors
+
+    public M6502Profiler() : this(DefaultBankBits)
+    {
+    }
+
+    /// <param name="bankBits">Number of bank number bits to track, between 0 and 8.</param>
+    public M6502Profiler(int bankBits)
+    {
+        ArgumentException.ThrowIf(bankBits is < 0 or > 8, "must be between 0 and 8", nameof(bankBits));
+
+        _bankMask = (1 << bankBits) - 1;
+        var size = 1 << (16 + bankBits);
+        _instructions = new uint[size];
+        _cycles = new ulong[size];
+        _stallCycles = new ulong[size];
+    }
+
+    #endregion
+}
+
+public readonly record struct M6502ProfileEntry(byte Bank, ushort PC, uint Instructions, ulong Cycles, ulong StallCycles);
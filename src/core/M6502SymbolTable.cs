@@ -0,0 +1,151 @@
+/*
+ * M6502SymbolTable.cs
+ *
+ * Maps code addresses to labels loaded from assembler symbol files.
+ *
+ * Recognized line formats:
+ *   DASM .sym:      name   f00a   (flags)
+ *   VICE/ca65:      al 00f00a .name
+ *   Equates:        name = $f00a, name EQU $f00a
+ *
+ * An address wider than 16 bits carries the bank in its upper bits, e.g. al 03f00a; symbols without a
+ * bank apply to every bank.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+
+namespace EMU7800.Core;
+
+public sealed class M6502SymbolTable
+{
+    const int AnyBank = -1;
+
+    static readonly char[] Separators = [' ', '\t'];
+
+    // Symbols by bank, with those that apply to every bank under AnyBank.
+    readonly Dictionary<int, List<(ushort Address, string Name)>> _symbols = [];
+    bool _sorted = true;
+
+    public int Count { get; private set; }
+
+    public void Add(ushort address, string name)
+        => Add(AnyBank, address, name);
+
+    public void Add(byte bank, ushort address, string name)
+        => Add((int)bank, address, name);
+
+    /// <summary>
+    /// Returns the nearest label at or below the specified address in the specified bank, with an offset suffix when inexact.
+    /// </summary>
+    public string? Lookup(byte bank, ushort address)
+    {
+        if (!_sorted)
+        {
+            foreach (var symbols in _symbols.Values)
+                symbols.Sort((a, b) => a.Address.CompareTo(b.Address));
+            _sorted = true;
+        }
+
+        var found = Find(bank, address);
+        var any = Find(AnyBank, address);
+        if (found is null || any is { } a && a.Address > found.Value.Address)
+            found = any;
+
+        if (found is not var (symbolAddress, name))
+            return null;
+        return symbolAddress == address ? name : $"{name}+{address - symbolAddress}";
+    }
+
+    public static M6502SymbolTable Load(string fileName)
+    {
+        var table = new M6502SymbolTable();
+        foreach (var line in File.ReadLines(fileName))
+        {
+            if (TryParse(line, out var bank, out var address, out var name))
+            {
+                table.Add(bank, address, name);
+            }
+        }
+        return table;
+    }
+
+    #region Helpers
+
+    void Add(int bank, ushort address, string name)
+    {
+        if (!_symbols.TryGetValue(bank, out var symbols))
+            _symbols.Add(bank, symbols = []);
+        symbols.Add((address, name));
+        Count++;
+        _sorted = false;
+    }
+
+    (ushort Address, string Name)? Find(int bank, ushort address)
+    {
+        if (!_symbols.TryGetValue(bank, out var symbols))
+            return null;
+
+        int lo = 0, hi = symbols.Count - 1, found = -1;
+        while (lo <= hi)
+        {
+            var mid = (lo + hi) >> 1;
+            if (symbols[mid].Address <= address)
+            {
+                found = mid;
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        return found < 0 ? null : symbols[found];
+    }
+
+    static bool TryParse(string line, out int bank, out ushort address, out string name)
+    {
+        bank = AnyBank;
+        address = 0;
+        name = string.Empty;
+
+        var tokens = line.Split(Separators, StringSplitOptions.RemoveEmptyEntries);
+        if (tokens.Length < 2 || tokens[0].StartsWith("---", StringComparison.Ordinal))
+            return false;
+
+        // VICE: al C:f00a .name
+        if (tokens.Length >= 3 && tokens[0].Equals("al", StringComparison.OrdinalIgnoreCase))
+        {
+            name = tokens[2].TrimStart('.');
+            return TryParseHex(tokens[1].AsSpan(tokens[1].IndexOf(':') + 1), out bank, out address) && name.Length > 0;
+        }
+
+        // Equates: name = $f00a, name EQU $f00a
+        if (tokens.Length >= 3 && (tokens[1] == "=" || tokens[1].Equals("equ", StringComparison.OrdinalIgnoreCase)))
+        {
+            name = tokens[0];
+            return TryParseHex(tokens[2], out bank, out address);
+        }
+
+        // DASM: name f00a
+        name = tokens[0];
+        return TryParseHex(tokens[1], out bank, out address);
+    }
+
+    static bool TryParseHex(ReadOnlySpan<char> text, out int bank, out ushort value)
+    {
+        text = text.TrimStart('$');
+        if (text.StartsWith("0x", StringComparison.OrdinalIgnoreCase))
+            text = text[2..];
+        var ok = uint.TryParse(text, NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var v) && v <= 0xffffff;
+        value = (ushort)v;
+        bank = v > 0xffff ? (int)(v >> 16) : AnyBank;
+        return ok;
+    }
+
+    #endregion
+}
@@ -26,10 +26,10 @@ public class Machine2600 : MachineBase
         CPU.Reset();
     }
 
-    public override void ComputeNextFrame()
+    protected override void ComputeFrame()
     {
-        base.ComputeNextFrame();
         TIA.StartFrame();
+        Cart.StartFrame();
         CPU.RunClocks = (FrameBuffer.Scanlines + 3) * 76;
         while (CPU is { RunClocks: > 0, Jammed: false })
         {
@@ -37,6 +37,7 @@ public class Machine2600 : MachineBase
             {
                 CPU.Clock += (ulong)TIA.WSYNCDelayClocks / 3;
                 CPU.RunClocks -= TIA.WSYNCDelayClocks / 3;
+                CPU.Profiler?.ChargeStall(TIA.WSYNCDelayClocks / 3);
                 TIA.WSYNCDelayClocks = 0;
             }
             if (TIA.EndOfFrame)
@@ -45,9 +46,27 @@ public class Machine2600 : MachineBase
             }
             CPU.Execute();
         }
+        Cart.EndFrame();
         TIA.EndFrame();
     }
 
+    public override int GetRAMAddresses(int offset, Span<ushort> addresses)
+    {
+        var count = 0;
+        if (offset is >= 0 and < 0x80)
+        {
+            // PIA RAM is mirrored wherever A9 is clear, including on the stack page
+            for (var basea = 0x0080; basea < 0x1000; basea += 0x0100)
+            {
+                if ((basea & 0x0200) == 0)
+                {
+                    AddRAMAddress(addresses, ref count, basea + offset, PIA);
+                }
+            }
+        }
+        return count;
+    }
+
     public Machine2600(Cart cart, ILogger logger, int slines, int startl, int fHZ, int sRate, ReadOnlyMemory<uint> p)
          : base(logger, slines, startl, fHZ, sRate, p, 160)
     {
@@ -101,6 +120,17 @@ public class Machine2600 : MachineBase
         Mem.Map(0x1000, 0x1000, Cart);
     }
 
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+        Mem.Restore(input);
+        CPU.Restore(input);
+        TIA.Restore(input);
+        PIA.Restore(input);
+        input.RestoreCart(Cart);
+    }
+
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
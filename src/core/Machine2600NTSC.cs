@@ -14,6 +14,12 @@ public sealed class Machine2600NTSC : Machine2600
         input.CheckVersion(1);
     }
 
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+        input.CheckVersion(1);
+    }
+
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
@@ -19,6 +19,9 @@ public class Machine7800 : MachineBase
     protected RAM6116 RAM1 { get; }
     protected Bios7800 BIOS { get; }
 
+    // Whether the BIOS is mapped over the top of the cart
+    bool _biosSwappedIn;
+
     #endregion
 
     public void SwapInBIOS()
@@ -26,6 +29,7 @@ public class Machine7800 : MachineBase
         if (BIOS != Bios7800.Default)
         {
             Mem.Map((ushort)(0x10000 - BIOS.Size), BIOS.Size, BIOS);
+            _biosSwappedIn = true;
         }
     }
 
@@ -34,6 +38,7 @@ public class Machine7800 : MachineBase
         if (BIOS != Bios7800.Default)
         {
             Mem.Map((ushort)(0x10000 - BIOS.Size), BIOS.Size, Cart);
+            _biosSwappedIn = false;
         }
     }
 
@@ -47,10 +52,46 @@ public class Machine7800 : MachineBase
         CPU.Reset();
     }
 
-    public override void ComputeNextFrame()
+    public override int RAMSize
+        => RAM0.RAMContents.Length + RAM1.RAMContents.Length + base.RAMSize;
+
+    public override void CopyRAM(Span<byte> destination)
+    {
+        RAM0.RAMContents.CopyTo(destination);
+        RAM1.RAMContents.CopyTo(destination[RAM0.RAMContents.Length..]);
+        base.CopyRAM(destination[(RAM0.RAMContents.Length + RAM1.RAMContents.Length)..]);
+    }
+
+    public override int GetRAMAddresses(int offset, Span<ushort> addresses)
     {
-        base.ComputeNextFrame();
+        var count = 0;
+        switch (offset)
+        {
+            case >= 0 and < 0x0800:
+                AddRAMAddress(addresses, ref count, 0x1800 + offset, RAM0);
+                break;
+            case >= 0x0800 and < 0x1000:
+                // RAM1 also shows through on zero page and the stack, which games use rather than $2040-$21ff
+                var ram1 = offset - 0x0800;
+                if (ram1 is >= 0x0040 and < 0x0100 or >= 0x0140 and < 0x0200)
+                {
+                    AddRAMAddress(addresses, ref count, ram1, RAM1);
+                }
+                for (var basea = 0x2000; basea < 0x4000; basea += 0x0800)
+                {
+                    AddRAMAddress(addresses, ref count, basea + ram1, RAM1);
+                }
+                break;
+            case >= 0x1000 and < 0x1080:
+                AddRAMAddress(addresses, ref count, 0x0480 + offset - 0x1000, PIA);
+                AddRAMAddress(addresses, ref count, 0x0580 + offset - 0x1000, PIA);
+                break;
+        }
+        return count;
+    }
 
+    protected override void ComputeFrame()
+    {
         AssertDebug(!CPU.Jammed);
         AssertDebug(CPU.RunClocks <= 0 && CPU.RunClocks % CPU.RunClocksMultiple == 0);
         AssertDebug((CPU.Clock + (ulong)(CPU.RunClocks / CPU.RunClocksMultiple)) % (114 * (ulong)FrameBuffer.Scanlines) == 0);
@@ -78,6 +119,7 @@ public class Machine7800 : MachineBase
                 Maria.DoDMAProcessing();
                 var remainingCpuClocks = 114 - (CPU.Clock - startOfScanlineCpuClock);
                 CPU.Clock += remainingCpuClocks;
+                CPU.Profiler?.ChargeStall((int)remainingCpuClocks);
                 CPU.RunClocks = 0;
                 continue;
             }
@@ -109,6 +151,7 @@ public class Machine7800 : MachineBase
 
             CPU.Clock += (ulong)(dmaClocks / CPU.RunClocksMultiple);
             CPU.RunClocks -= dmaClocks;
+            CPU.Profiler?.ChargeStall(dmaClocks / CPU.RunClocksMultiple);
 
             CPU.RunClocks += remainingRunClocks;
 
@@ -119,6 +162,7 @@ public class Machine7800 : MachineBase
             {
                 var remainingCpuClocks = 114 - (CPU.Clock - startOfScanlineCpuClock);
                 CPU.Clock += remainingCpuClocks;
+                CPU.Profiler?.ChargeStall((int)remainingCpuClocks);
                 CPU.RunClocks = 0;
             }
         }
@@ -171,7 +215,7 @@ public class Machine7800 : MachineBase
 
     public Machine7800(DeserializationContext input, ReadOnlyMemory<uint> palette, int scanlines) : base(input, palette)
     {
-        input.CheckVersion(1);
+        var version = input.CheckVersion(1, 2);
 
         Mem = input.ReadAddressSpace(this, 16, 6);  // 7800: 16bit, 64byte pages
 
@@ -203,19 +247,49 @@ public class Machine7800 : MachineBase
         Mem.Map(0x3800, 0x0800, RAM1);
 
         BIOS = input.ReadOptionalBios7800();
+        var biosSwappedIn = version > 1 && input.ReadBoolean();
         Cart = input.ReadCart(this);
 
         if (!Mem.Map(Cart))
         {
             Mem.Map(0x4000, 0xc000, Cart);
         }
+        if (biosSwappedIn)
+        {
+            SwapInBIOS();
+        }
+    }
+
+    public override void Restore(DeserializationContext input)
+    {
+        base.Restore(input);
+
+        var version = input.CheckVersion(1, 2);
+        Mem.Restore(input);
+        CPU.Restore(input);
+        Maria.Restore(input);
+        PIA.Restore(input);
+        RAM0.Restore(input);
+        RAM1.Restore(input);
+        input.RestoreOptional(BIOS);
+        var biosSwappedIn = version > 1 && input.ReadBoolean();
+        input.RestoreCart(Cart);
+
+        if (biosSwappedIn)
+        {
+            SwapInBIOS();
+        }
+        else
+        {
+            SwapOutBIOS();
+        }
     }
 
     public override void GetObjectData(SerializationContext output)
     {
         base.GetObjectData(output);
 
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(Mem);
         output.Write(CPU);
         output.Write(Maria);
@@ -223,6 +297,7 @@ public class Machine7800 : MachineBase
         output.Write(RAM0);
         output.Write(RAM1);
         output.WriteOptional(BIOS);
+        output.Write(_biosSwappedIn);
         output.Write(Cart);
     }
 
@@ -10,6 +10,7 @@
 using System;
 using System.IO;
 using System.Reflection;
+using System.Runtime.Serialization;
 using EMU7800.Core.Extensions;
 
 namespace EMU7800.Core;
@@ -22,6 +23,8 @@ public abstract class MachineBase
 
     readonly int _VisiblePitch, _Scanlines;
 
+    IFramePlugin[] _framePlugins = [];
+
     #endregion
 
     #region Public Properties
@@ -137,6 +140,10 @@ public abstract class MachineBase
     /// <summary>
     /// Deserialize a <see cref="MachineBase"/> from the specified stream.
     /// </summary>
+    /// <remarks>
+    /// Patches, watches and frame plugins are not part of the saved state, so the new machine has none; add them
+    /// again, or use <see cref="Restore(BinaryReader)"/> to keep those of an existing machine.
+    /// </remarks>
     /// <param name="binaryReader"/>
     /// <exception cref="SerializationException"/>
     public static MachineBase Deserialize(BinaryReader binaryReader)
@@ -145,6 +152,19 @@ public abstract class MachineBase
         return context.ReadMachine();
     }
 
+    /// <summary>
+    /// Restores the state of the machine in place from the specified stream, which must hold a machine of the same
+    /// type and configuration, e.g., one written earlier by <see cref="Serialize"/>. Unlike <see cref="Deserialize"/>,
+    /// the machine is reused, so the logger, patches, watches and frame plugins remain in place.
+    /// </summary>
+    /// <param name="binaryReader"/>
+    /// <exception cref="SerializationException"/>
+    public void Restore(BinaryReader binaryReader)
+    {
+        var context = new DeserializationContext(binaryReader);
+        context.RestoreMachine(this);
+    }
+
     /// <summary>
     /// Resets the state of the machine.
     /// </summary>
@@ -159,18 +179,40 @@ public abstract class MachineBase
     /// <summary>
     /// Computes the next machine frame.
     /// </summary>
-    public virtual void ComputeNextFrame()
+    public void ComputeNextFrame()
     {
         if (MachineHalt)
             return;
 
+        var plugins = _framePlugins;
+        foreach (var plugin in plugins)
+            plugin.FrameStarting(this);
+
         InputState.CaptureInputState();
 
         FrameNumber++;
 
         FrameBuffer.SoundBuffer.Span.Clear();
+
+        ComputeFrame();
+
+        foreach (var plugin in plugins)
+            plugin.FrameComputed(this);
     }
 
+    /// <summary>
+    /// Adds a plugin called around each subsequent <see cref="ComputeNextFrame"/>, after those already added.
+    /// Plugins are not saved with the machine, so one returned by <see cref="Deserialize"/> starts without any.
+    /// </summary>
+    public void AddFramePlugin(IFramePlugin plugin)
+        => _framePlugins = [.. _framePlugins, plugin];
+
+    /// <summary>
+    /// Removes a plugin; a plugin may remove itself from within its callbacks.
+    /// </summary>
+    public void RemoveFramePlugin(IFramePlugin plugin)
+        => _framePlugins = Array.FindAll(_framePlugins, p => p != plugin);
+
     /// <summary>
     /// Serialize the state of the machine to the specified stream.
     /// </summary>
@@ -182,8 +224,88 @@ public abstract class MachineBase
         context.Write(this);
     }
 
+    /// <summary>
+    /// Number of bytes written by <see cref="CopyRAM"/>.
+    /// </summary>
+    public virtual int RAMSize
+        => PIA.RAMContents.Length + Cart.RAMContents.Length;
+
+    /// <summary>
+    /// Copies the contents of system RAM, followed by any cart RAM, to the specified destination.
+    /// </summary>
+    public virtual void CopyRAM(Span<byte> destination)
+    {
+        PIA.RAMContents.CopyTo(destination);
+        Cart.RAMContents.CopyTo(destination[PIA.RAMContents.Length..]);
+    }
+
+    /// <summary>
+    /// Most CPU addresses any byte of RAM is mirrored to, the size <see cref="GetRAMAddresses"/> expects.
+    /// </summary>
+    public const int MaxRAMAddresses = 8;
+
+    /// <summary>
+    /// Translates an offset into the RAM written by <see cref="CopyRAM"/> to each CPU address it is read from,
+    /// the address games normally use first, e.g. zero page ahead of its mirrors.
+    /// </summary>
+    /// <returns>The number of addresses, or 0 when the RAM has no fixed CPU address, e.g. banked cart RAM.</returns>
+    public virtual int GetRAMAddresses(int offset, Span<ushort> addresses)
+        => 0;
+
+    /// <summary>
+    /// Translates an offset into the RAM written by <see cref="CopyRAM"/> to the CPU address games normally read it from.
+    /// </summary>
+    /// <returns>The address, or -1 when the RAM has no fixed CPU address, e.g. banked cart RAM.</returns>
+    public int GetRAMAddress(int offset)
+    {
+        Span<ushort> addresses = stackalloc ushort[MaxRAMAddresses];
+        return GetRAMAddresses(offset, addresses) > 0 ? addresses[0] : -1;
+    }
+
+    /// <summary>
+    /// Patches the RAM at an offset into the RAM written by <see cref="CopyRAM"/> at each CPU address it is read from,
+    /// so that reads through a mirror also see the value.
+    /// </summary>
+    /// <returns>false when the RAM has no fixed CPU address, e.g. banked cart RAM.</returns>
+    public bool PatchRAM(int offset, byte value)
+    {
+        Span<ushort> addresses = stackalloc ushort[MaxRAMAddresses];
+        var count = GetRAMAddresses(offset, addresses);
+        foreach (var addr in addresses[..count])
+        {
+            Mem.Patch(addr, value);
+        }
+        return count > 0;
+    }
+
+    public void UnpatchRAM(int offset)
+    {
+        Span<ushort> addresses = stackalloc ushort[MaxRAMAddresses];
+        var count = GetRAMAddresses(offset, addresses);
+        foreach (var addr in addresses[..count])
+        {
+            Mem.Unpatch(addr);
+        }
+    }
+
+    /// <summary>
+    /// Adds an address for <see cref="GetRAMAddresses"/> unless another device, e.g. a cart, is mapped over it.
+    /// </summary>
+    protected void AddRAMAddress(Span<ushort> addresses, ref int count, int addr, IDevice device)
+    {
+        if (Mem.IsMapped((ushort)addr, device))
+        {
+            addresses[count++] = (ushort)addr;
+        }
+    }
+
     #endregion
 
+    /// <summary>
+    /// Runs the machine for a frame, once input is captured and the sound buffer cleared.
+    /// </summary>
+    protected abstract void ComputeFrame();
+
     #region Constructors
 
     protected MachineBase(ILogger logger, int scanLines, int firstScanline, int fHZ, int soundSampleFreq, ReadOnlyMemory<uint> palette, int vPitch)
@@ -222,6 +344,22 @@ public abstract class MachineBase
         FrameBuffer = new(_VisiblePitch, _Scanlines);
     }
 
+    /// <summary>
+    /// Reads back into this machine what <see cref="GetObjectData"/> wrote, leaving everything else as deserialization would.
+    /// </summary>
+    public virtual void Restore(DeserializationContext input)
+    {
+        input.CheckVersion(1);
+        MachineHalt = input.ReadBoolean();
+        FrameHZ = input.ReadInt32();
+        SerializationException.ThrowIf(input.ReadInt32() != _VisiblePitch
+            || input.ReadInt32() != _Scanlines
+            || input.ReadInt32() != FirstScanline
+            || input.ReadInt32() != SoundSampleFrequency, "Machine configuration incorrect");
+        NOPRegisterDumping = input.ReadBoolean();
+        InputState.Restore(input);
+    }
+
     public virtual void GetObjectData(SerializationContext output)
     {
         output.WriteVersion(1);
@@ -239,5 +377,6 @@ public abstract class MachineBase
 
     class MachineUnknown() : MachineBase(NullLogger.Default, 100, 1, 1, 1, ReadOnlyMemory<uint>.Empty, 1)
     {
+        protected override void ComputeFrame() {}
     }
 }
\ No newline at end of file
@@ -132,7 +132,7 @@ public sealed class Maria : IDevice
 
         TIASound.Reset();
 
-        Log($"{this} reset");
+        M.Logger.Log(4, $"{this} reset");
     }
 
     public byte this[ushort addr]
@@ -783,7 +783,7 @@ public sealed class Maria : IDevice
             case INPTCTRL:
                 if (CtrlLock)
                 {
-                    Log($"Maria: INPTCTRL: LOCKED: Ignoring: ${data:x2}, PC=${M.CPU.PC:x4}");
+                    M.Logger.Log(4, $"Maria: INPTCTRL: LOCKED: Ignoring: ${data:x2}, PC=${M.CPU.PC:x4}");
                     break;
                 }
 
@@ -792,7 +792,7 @@ public sealed class Maria : IDevice
                 var biosDisable = (data & (1 << 2)) != 0;
                 var tiaopEnable = (data & (1 << 3)) != 0;
 
-                Log($"Maria: INPTCTRL: ${data:x2}, PC=${M.CPU.PC:x4}, lockMode={CtrlLock}, mariaEnable={mariaEnable} biosDisable={biosDisable} tiaOutput={tiaopEnable}");
+                M.Logger.Log(4, $"Maria: INPTCTRL: ${data:x2}, PC=${M.CPU.PC:x4}, lockMode={CtrlLock}, mariaEnable={mariaEnable} biosDisable={biosDisable} tiaOutput={tiaopEnable}");
 
                 if (biosDisable)
                 {
@@ -858,7 +858,7 @@ public sealed class Maria : IDevice
                 TIASound.Update(addr, data);
                 break;
             case OFFSET:
-                Log($"Maria: OFFSET: ROM wrote ${data:x2}, PC=${M.CPU.PC:x4} (reserved for future expansion)");
+                M.Logger.Log(4, $"Maria: OFFSET: ROM wrote ${data:x2}, PC=${M.CPU.PC:x4} (reserved for future expansion)");
                 break;
             default:
                 Registers[addr] = data;
@@ -949,28 +949,33 @@ public sealed class Maria : IDevice
         M = m;
         InitializeVisibleScanlineValues(scanlines);
         TIASound = new TIASound(input, M, CPU_TICKS_PER_AUDIO_SAMPLE);
+        ReadState(input);
+    }
+
+    public void Restore(DeserializationContext input)
+    {
+        TIASound.Restore(input);
+        ReadState(input);
+    }
 
+    void ReadState(DeserializationContext input)
+    {
         var version = input.CheckVersion(1, 2);
-        LineRAM = input.ReadExpectedBytes(512);
+        input.ReadBytesInto(LineRAM);
         if (version == 1)
         {
             // formerly persisted values, MariaPalette[8,4]
             for (var i = 0; i < 32; i++)
                 input.ReadByte();
         }
-        Registers = input.ReadExpectedBytes(0x40);
+        input.ReadBytesInto(Registers);
         if (version == 1)
         {
             // formerly persisted value, Scanline
             input.ReadInt32();
         }
 
-        WM = version switch
-        {
-            1 => input.ReadByte() != 0,
-            2 => input.ReadBoolean(),
-            _ => WM
-        };
+        WM = version == 1 ? input.ReadByte() != 0 : input.ReadBoolean();
         DLL = input.ReadUInt16();
         DL = input.ReadUInt16();
         Offset = input.ReadInt32();
@@ -1064,9 +1069,6 @@ public sealed class Maria : IDevice
         _isPal = scanlines == 312;
     }
 
-    void Log(string message)
-        => M.Logger.Log(4, message);
-
     // convenience overload
     static ushort WORD(int lsb, int msb)
     {
@@ -46,6 +46,8 @@ public sealed class NVRAM2k : IDevice
 
     public void Reset()
     {
+        // Load now rather than on the game's first access, which would allocate mid-frame.
+        _ = NVRAM;
     }
 
     #endregion
@@ -67,6 +69,15 @@ public sealed class NVRAM2k : IDevice
         _fileName = input.ReadString();
     }
 
+    /// <remarks>
+    /// The contents persist outside the machine state, so they are left as they are.
+    /// </remarks>
+    public void Restore(DeserializationContext input)
+    {
+        input.CheckVersion(1);
+        input.ReadExpectedString(_fileName);
+    }
+
     public void GetObjectData(SerializationContext output)
     {
         output.WriteVersion(1);
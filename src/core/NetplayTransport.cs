@@ -0,0 +1,86 @@
+/*
+ * NetplayTransport.cs
+ *
+ * Connectionless UDP datagram exchange with a single remote netplay site.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Net;
+using System.Net.Sockets;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class NetplayTransport : IDisposable
+{
+    readonly Socket _socket;
+    readonly SocketAddress _remoteAddress;
+    readonly SocketAddress _receivedAddress;
+
+    public IPEndPoint RemoteEndPoint { get; }
+
+    public int LocalPort => ((IPEndPoint)_socket.LocalEndPoint!).Port;
+
+    public void Send(ReadOnlySpan<byte> datagram)
+    {
+        try
+        {
+            _socket.SendTo(datagram, SocketFlags.None, _remoteAddress);
+        }
+        catch (SocketException)
+        {
+            // Datagrams are best effort; the session protocol resends until acknowledged.
+        }
+    }
+
+    /// <summary>
+    /// Receives the next pending datagram from the remote site without blocking.
+    /// Datagrams from any other address are discarded.
+    /// </summary>
+    /// <returns>Length of the datagram, or zero when none is pending.</returns>
+    public int Receive(Span<byte> buffer)
+    {
+        while (_socket.Available > 0)
+        {
+            int length;
+            try
+            {
+                length = _socket.ReceiveFrom(buffer, SocketFlags.None, _receivedAddress);
+            }
+            catch (SocketException ex) when (ex.SocketErrorCode is SocketError.ConnectionReset or SocketError.MessageSize)
+            {
+                // ICMP port unreachable (remote not yet listening) and oversized datagrams are not fatal
+                continue;
+            }
+            catch (SocketException ex) when (ex.SocketErrorCode == SocketError.WouldBlock)
+            {
+                return 0;
+            }
+            if (length > 0 && _receivedAddress.Equals(_remoteAddress))
+                return length;
+        }
+        return 0;
+    }
+
+    public void Dispose()
+        => _socket.Dispose();
+
+    #region Constructors
+
+    public NetplayTransport(int localPort, IPEndPoint remoteEndPoint)
+    {
+        ArgumentException.ThrowIf(localPort is < 0 or > 0xffff, "must be a valid UDP port number", nameof(localPort));
+
+        RemoteEndPoint = remoteEndPoint;
+        _remoteAddress = remoteEndPoint.Serialize();
+        _receivedAddress = new(remoteEndPoint.AddressFamily, _remoteAddress.Size);
+
+        _socket = new(remoteEndPoint.AddressFamily, SocketType.Dgram, ProtocolType.Udp) { Blocking = false };
+        var localAddress = remoteEndPoint.AddressFamily == AddressFamily.InterNetworkV6 ? IPAddress.IPv6Any : IPAddress.Any;
+        _socket.Bind(new IPEndPoint(localAddress, localPort));
+    }
+
+    #endregion
+}
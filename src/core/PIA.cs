@@ -7,6 +7,8 @@
  * Copyright © 2003, 2004, 2012 Mike Murphy
  *
  */
+using System;
+
 namespace EMU7800.Core;
 
 public sealed class PIA(MachineBase m) : IDevice
@@ -25,6 +27,8 @@ public sealed class PIA(MachineBase m) : IDevice
     public byte WrittenPortA { get; private set; }
     public byte WrittenPortB { get; private set; }
 
+    public ReadOnlySpan<byte> RAMContents => RAM;
+
     #region IDevice Members
 
     public void Reset()
@@ -38,7 +42,7 @@ public sealed class PIA(MachineBase m) : IDevice
 
         DDRA = 0;
 
-        Log($"{this} reset");
+        m.Logger.Log(4, $"{this} reset");
     }
 
     public byte this[ushort addr]
@@ -73,7 +77,7 @@ public sealed class PIA(MachineBase m) : IDevice
             case 7:
                 return ReadInterruptFlag();
             default:
-                LogDebug($"PIA: Unhandled peek ${addr:x4}, PC=${m.CPU.PC:x4}");
+                m.Logger.Log(5, $"PIA: Unhandled peek ${addr:x4}, PC=${m.CPU.PC:x4}");
                 return 0;
         }
     }
@@ -96,7 +100,7 @@ public sealed class PIA(MachineBase m) : IDevice
             }
             else
             {
-                LogDebug($"PIA: Timer: Unhandled poke ${addr:x4} w/${data:x2}, PC=${m.CPU.PC:x4}");
+                m.Logger.Log(5, $"PIA: Timer: Unhandled poke ${addr:x4} w/${data:x2}, PC=${m.CPU.PC:x4}");
             }
         }
         else
@@ -261,20 +265,20 @@ public sealed class PIA(MachineBase m) : IDevice
     #region Serialization Members
 
     public PIA(DeserializationContext input, MachineBase m) : this(m)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
         var version = input.CheckVersion(1, 2);
-        RAM = input.ReadExpectedBytes(0x80);
+        input.ReadBytesInto(RAM);
         TimerTarget = input.ReadUInt64();
         TimerShift = input.ReadInt32();
         IRQEnabled = input.ReadBoolean();
         IRQTriggered = input.ReadBoolean();
         DDRA = input.ReadByte();
         WrittenPortA = input.ReadByte();
-        if (version > 1)
-        {
-            DDRB = input.ReadByte();
-            WrittenPortB = input.ReadByte();
-        }
+        DDRB = version > 1 ? input.ReadByte() : (byte)0;
+        WrittenPortB = version > 1 ? input.ReadByte() : (byte)0;
     }
 
     public void GetObjectData(SerializationContext output)
@@ -292,14 +296,4 @@ public sealed class PIA(MachineBase m) : IDevice
     }
 
     #endregion
-
-    #region Helpers
-
-    void Log(string message)
-        => m.Logger.Log(4, message);
-
-    void LogDebug(string message)
-        => m.Logger.Log(5, message);
-
-    #endregion
 }
\ No newline at end of file
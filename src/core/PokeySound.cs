@@ -8,7 +8,8 @@
  * Copyright © 2012 Mike Murphy
  *
  */
-using System;
+using System.Runtime.Serialization;
+using EMU7800.Core.Extensions;
 
 namespace EMU7800.Core;
 
@@ -62,7 +63,9 @@ public sealed class PokeySound
     readonly byte[] _poly05 = [0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 1];
     readonly byte[] _poly17 = new byte[POLY9_SIZE]; // should be POLY17_SIZE, but instead wrapping around to conserve storage
 
-    readonly Random _random = new();
+    // RANDOM reads 8 bits of the poly counter, indexed by POKEY clock
+    static readonly byte[] _random9  = BuildRandomTable(9, 5);   // x^9 + x^5 + 1
+    static readonly byte[] _random17 = BuildRandomTable(17, 14); // x^17 + x^14 + 1
 
     #endregion
 
@@ -130,7 +133,7 @@ public sealed class PokeySound
         {
             // If the 2 least significant bits of SKCTL are 0, the random number generator is disabled (return all 1s.)
             // Ballblazer music relies on this.
-            RANDOM => (_skctl & SKCTL_RESET) == 0 ? (byte)0xff : (byte)_random.Next(0xff),
+            RANDOM => (_skctl & SKCTL_RESET) == 0 ? (byte)0xff : SampleRandom(),
             _      => 0
         };
     }
@@ -208,9 +211,13 @@ public sealed class PokeySound
     {
         M = m;
 
-        _random.NextBytes(_poly17);
+        // x^9 + x^5 + 1
+        var lfsr = 0x1ff;
         for (var i = 0; i < _poly17.Length; i++)
-            _poly17[i] &= 0x01;
+        {
+            _poly17[i] = (byte)(lfsr & 1);
+            lfsr = (lfsr >> 1) | (((lfsr ^ (lfsr >> 4)) & 1) << 8);
+        }
 
         // Add 8-bits of fractional representation to reduce distortion on output
         _pokeyTicksPerSample = (POKEY_FREQ << 8) / M.SoundSampleFrequency;
@@ -223,25 +230,35 @@ public sealed class PokeySound
     #region Serialization Members
 
     public PokeySound(DeserializationContext input, MachineBase m) : this(m)
+        => _pokeyTicksPerSample = ReadState(input);
+
+    public void Restore(DeserializationContext input)
+        => SerializationException.ThrowIf(ReadState(input) != _pokeyTicksPerSample, "POKEY ticks per sample incorrect");
+
+    /// <summary>
+    /// Reads back the state, returning the saved POKEY ticks per sample, which is fixed once deserialized.
+    /// </summary>
+    int ReadState(DeserializationContext input)
     {
         input.CheckVersion(1);
         _lastUpdateCpuClock = input.ReadUInt64();
         _bufferIndex = input.ReadInt32();
-        _audf = input.ReadBytes();
-        _audc = input.ReadBytes();
+        input.ReadBytesInto(_audf);
+        input.ReadBytesInto(_audc);
         _audctl = input.ReadByte();
         _skctl = input.ReadByte();
-        _output = input.ReadBytes();
-        _outvol = input.ReadBytes();
-        _divideMax = input.ReadIntegers(4);
-        _divideCount = input.ReadIntegers(4);
+        input.ReadBytesInto(_output);
+        input.ReadBytesInto(_outvol);
+        input.ReadIntegersInto(_divideMax);
+        input.ReadIntegersInto(_divideCount);
         _pokeyTicks = input.ReadInt32();
-        _pokeyTicksPerSample = input.ReadInt32();
+        var pokeyTicksPerSample = input.ReadInt32();
         _baseMultiplier = input.ReadInt32();
         _poly04Counter = input.ReadInt32();
         _poly05Counter = input.ReadInt32();
         _poly17Counter = input.ReadInt32();
         _poly17Size = input.ReadInt32();
+        return pokeyTicksPerSample;
     }
 
     public void GetObjectData(SerializationContext output)
@@ -402,6 +419,24 @@ public sealed class PokeySound
         UpdateVolumeSettingsForChannel(3);
     }
 
+    // The poly counter free runs at the POKEY clock, which on the 7800 is also the CPU clock.
+    byte SampleRandom()
+        => (_audctl & AUDCTL_POLY9) != 0
+            ? _random9[(int)(M.CPU.Clock % POLY9_SIZE)]
+            : _random17[(int)(M.CPU.Clock % POLY17_SIZE)];
+
+    static byte[] BuildRandomTable(int bits, int tap)
+    {
+        var table = new byte[(1 << bits) - 1];
+        var lfsr = (1 << bits) - 1;
+        for (var i = 0; i < table.Length; i++)
+        {
+            table[i] = (byte)lfsr;
+            lfsr = (lfsr >> 1) | (((lfsr ^ (lfsr >> (bits - tap))) & 1) << (bits - 1));
+        }
+        return table;
+    }
+
     void UpdateVolumeSettingsForChannel(int ch)
     {
         if ((_audc[ch] & AUDC_VOLUME_ONLY) != 0 || (_audc[ch] & AUDC_VOLUME_MASK) == 0 || _divideMax[ch] < _pokeyTicksPerSample >> 8)
@@ -6,6 +6,8 @@
  * Copyright © 2004 Mike Murphy
  *
  */
+using System;
+
 namespace EMU7800.Core;
 
 public sealed class RAM6116 : IDevice
@@ -14,6 +16,8 @@ public sealed class RAM6116 : IDevice
 
     readonly byte[] RAM = new byte[ROM_SIZE];
 
+    public ReadOnlySpan<byte> RAMContents => RAM;
+
     #region IDevice Members
 
     public void Reset() {}
@@ -43,9 +47,12 @@ public sealed class RAM6116 : IDevice
     #region Serialization Members
 
     public RAM6116(DeserializationContext input)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
         input.CheckVersion(1);
-        RAM = input.ReadExpectedBytes(ROM_SIZE);
+        input.ReadBytesInto(RAM);
     }
 
     public void GetObjectData(SerializationContext output)
@@ -0,0 +1,208 @@
+/*
+ * RAMSearch.cs
+ *
+ * Records machine RAM every frame and narrows down which bytes hold game variables
+ * such as scores and lives, in the manner of a cheat finder.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Numerics;
+using System.Runtime.InteropServices;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public enum RAMSearchFilter
+{
+    Equal,
+    Changed,
+    Increased,
+    Decreased,
+}
+
+public sealed class RAMSearch
+{
+    // Snapshots and the candidate mask are padded to whole vectors; the padding is never a candidate.
+    readonly int _stride;
+    readonly byte[] _history;
+    readonly byte[] _candidates;
+
+    public int RAMSize { get; }
+
+    /// <summary>
+    /// Maximum number of snapshots held; older snapshots are overwritten.
+    /// </summary>
+    public int Capacity { get; }
+
+    /// <summary>
+    /// Number of snapshots captured so far. Snapshots are numbered from zero in capture order.
+    /// </summary>
+    public long Captured { get; private set; }
+
+    /// <summary>
+    /// Number of the oldest snapshot still held.
+    /// </summary>
+    public long Oldest => Math.Max(0, Captured - Capacity);
+
+    /// <summary>
+    /// Records the machine's RAM as the next snapshot; intended to be called once per computed frame.
+    /// </summary>
+    public void Capture(MachineBase m)
+    {
+        ArgumentException.ThrowIf(m.RAMSize != RAMSize, "RAM size differs from the one searched", nameof(m));
+
+        m.CopyRAM(_history.AsSpan((int)(Captured % Capacity) * _stride, RAMSize));
+        Captured++;
+    }
+
+    public ReadOnlySpan<byte> GetSnapshot(long n)
+        => Snapshot(n)[..RAMSize];
+
+    /// <summary>
+    /// Makes every RAM offset a candidate again.
+    /// </summary>
+    public void ResetCandidates()
+    {
+        _candidates.AsSpan(0, RAMSize).Fill(0xff);
+        _candidates.AsSpan(RAMSize).Clear();
+    }
+
+    public int CandidateCount
+    {
+        get
+        {
+            var count = 0;
+            foreach (var bits in MemoryMarshal.Cast<byte, ulong>(_candidates))
+            {
+                count += BitOperations.PopCount(bits);
+            }
+            return count >> 3;  // candidate bytes are all ones
+        }
+    }
+
+    public bool IsCandidate(int offset)
+        => offset >= 0 && offset < RAMSize && _candidates[offset] != 0;
+
+    public void Exclude(int offset)
+    {
+        ArgumentException.ThrowIf(offset < 0 || offset >= RAMSize, "out of range", nameof(offset));
+        _candidates[offset] = 0;
+    }
+
+    /// <summary>
+    /// Copies the RAM offsets of the remaining candidates, in ascending order.
+    /// </summary>
+    /// <returns>Number of offsets copied.</returns>
+    public int CopyCandidates(Span<int> destination)
+    {
+        var count = 0;
+        for (var i = 0; i < RAMSize && count < destination.Length; i++)
+        {
+            if (_candidates[i] != 0)
+            {
+                destination[count++] = i;
+            }
+        }
+        return count;
+    }
+
+    /// <summary>
+    /// Keeps the candidates whose value in snapshot <paramref name="to"/> compares to their value in
+    /// snapshot <paramref name="from"/> as specified, e.g. Increased between the two.
+    /// </summary>
+    public void Filter(RAMSearchFilter filter, long from, long to)
+        => Filter(filter, Snapshot(from), Snapshot(to));
+
+    /// <summary>
+    /// Keeps the candidates satisfying the comparison between every pair of consecutive snapshots from
+    /// <paramref name="from"/> through <paramref name="to"/>, e.g. Equal keeps the bytes that never changed.
+    /// </summary>
+    public void FilterEveryFrame(RAMSearchFilter filter, long from, long to)
+    {
+        ArgumentException.ThrowIf(from > to, "must not follow the last snapshot", nameof(from));
+
+        var prior = Snapshot(from);
+        for (var n = from + 1; n <= to; n++)
+        {
+            var next = Snapshot(n);
+            if (!Filter(filter, prior, next))
+                break;
+            prior = next;
+        }
+    }
+
+    /// <summary>
+    /// Keeps the candidates holding the specified value in snapshot <paramref name="n"/>.
+    /// </summary>
+    public void FilterValue(byte value, long n)
+    {
+        var snapshot = Vectors(Snapshot(n));
+        var candidates = Vectors(_candidates.AsSpan());
+        var v = new Vector<byte>(value);
+        for (var i = 0; i < candidates.Length; i++)
+        {
+            candidates[i] &= Vector.Equals(snapshot[i], v);
+        }
+    }
+
+    #region Constructors
+
+    /// <param name="ramSize">Size of the RAM captured, see <see cref="MachineBase.RAMSize"/>.</param>
+    /// <param name="capacity">Number of snapshots to hold.</param>
+    public RAMSearch(int ramSize, int capacity)
+    {
+        ArgumentException.ThrowIf(ramSize <= 0, "must be a positive integer", nameof(ramSize));
+        ArgumentException.ThrowIf(capacity <= 0, "must be a positive integer", nameof(capacity));
+
+        RAMSize = ramSize;
+        Capacity = capacity;
+        _stride = (ramSize + Vector<byte>.Count - 1) / Vector<byte>.Count * Vector<byte>.Count;
+        ArgumentException.ThrowIf((long)_stride * capacity > Array.MaxLength, "history would exceed the maximum array size", nameof(capacity));
+        _history = new byte[_stride * capacity];
+        _candidates = new byte[_stride];
+        ResetCandidates();
+    }
+
+    #endregion
+
+    #region Helpers
+
+    /// <returns>false when no candidates remain.</returns>
+    bool Filter(RAMSearchFilter filter, ReadOnlySpan<byte> from, ReadOnlySpan<byte> to)
+    {
+        var a = Vectors(from);
+        var b = Vectors(to);
+        var candidates = Vectors(_candidates.AsSpan());
+        var any = Vector<byte>.Zero;
+        for (var i = 0; i < candidates.Length; i++)
+        {
+            var keep = filter switch
+            {
+                RAMSearchFilter.Equal     => Vector.Equals(b[i], a[i]),
+                RAMSearchFilter.Changed   => ~Vector.Equals(b[i], a[i]),
+                RAMSearchFilter.Increased => Vector.GreaterThan(b[i], a[i]),
+                RAMSearchFilter.Decreased => Vector.LessThan(b[i], a[i]),
+                _                         => Vector<byte>.Zero
+            };
+            candidates[i] &= keep;
+            any |= candidates[i];
+        }
+        return any != Vector<byte>.Zero;
+    }
+
+    ReadOnlySpan<byte> Snapshot(long n)
+    {
+        ArgumentException.ThrowIf(n < Oldest || n >= Captured, "snapshot no longer or not yet recorded", nameof(n));
+        return _history.AsSpan((int)(n % Capacity) * _stride, _stride);
+    }
+
+    static Span<Vector<byte>> Vectors(Span<byte> bytes)
+        => MemoryMarshal.Cast<byte, Vector<byte>>(bytes);
+
+    static ReadOnlySpan<Vector<byte>> Vectors(ReadOnlySpan<byte> bytes)
+        => MemoryMarshal.Cast<byte, Vector<byte>>(bytes);
+
+    #endregion
+}
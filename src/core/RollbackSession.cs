@@ -0,0 +1,584 @@
+/*
+ * RollbackSession.cs
+ *
+ * Two-site rollback netplay: each site drives one controller jack, input vectors are exchanged
+ * every frame, and the remote site's input is predicted until it arrives. When a prediction proves
+ * wrong, the machine is restored from an in-memory snapshot and the missed frames are re-simulated
+ * in a single burst.
+ *
+ * Both sites must start from identical machine state; this is verified during synchronization
+ * and periodically afterwards by comparing state checksums.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Buffers.Binary;
+using System.Diagnostics;
+using System.IO;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public enum NetplayState
+{
+    Synchronizing,
+    Running,
+    Disconnected,
+    Failed
+}
+
+public sealed class RollbackSession : IDisposable
+{
+    #region Fields
+
+    public const int DefaultMaxPredictionFrames = 8;
+
+    const int
+        InputRingSize       = 64,
+        MaxInputsPerPacket  = 16,
+        CheckpointInterval  = 60,
+        CheckRingSize       = 8,
+        SyncIntervalFrames  = 15;
+
+    const uint PacketMagic = 0x504e3745; // "E7NP"
+
+    const byte
+        PacketTypeSync  = 1,
+        PacketTypeInput = 2;
+
+    const int
+        SyncPacketSize  = 4 + 1 + 1 + 1 + 8,
+        InputHeaderSize = 4 + 1 + 4 + 4 + 4 + 4 + 1 + 4 + 8;
+
+    static readonly TimeSpan DisconnectTimeout = TimeSpan.FromSeconds(5);
+
+    readonly NetplayTransport _transport;
+    readonly ILogger _logger;
+    readonly int _localJack, _remoteJack, _maxPredictionFrames;
+
+    readonly int _vectorLength = InputState.VectorLength;
+    readonly int[] _localInputs, _remoteInputs, _initialRemoteInput, _frameInput, _scratchInput, _maskedInput;
+    readonly Action<int[]> _inputAdvancing;
+
+    // Each snapshot stream keeps its writer and reader, so saving and restoring a snapshot does not allocate.
+    readonly MemoryStream[] _snapshots;
+    readonly BinaryWriter[] _snapshotWriters;
+    readonly SerializationContext[] _snapshotOutputs;
+    readonly DeserializationContext[] _snapshotInputs;
+    readonly BinaryReader[] _snapshotReaders;
+    readonly int[] _snapshotFrames;
+
+    readonly (int Frame, ulong Hash)[] _localChecks = new (int, ulong)[CheckRingSize];
+    int _localCheckCount, _nextCheckFrame;
+    (int Frame, ulong Hash) _remoteCheck = (-1, 0);
+
+    readonly byte[] _sendBuffer = new byte[InputHeaderSize + MaxInputsPerPacket * InputState.VectorLength * sizeof(int)];
+    readonly byte[] _receiveBuffer = new byte[0x800];
+
+    readonly ulong _initialStateHash;
+
+    int _frame, _lastConfirmedRemoteFrame = -1, _firstIncorrectFrame = -1;
+    int _remoteAckFrame = -1, _remoteFrame, _remoteAdvantage;
+    int _syncCountdown;
+    bool _peerSeen, _peerSawUs;
+    long _lastReceiveTimestamp;
+
+    #endregion
+
+    #region Public Members
+
+    /// <summary>
+    /// The machine being driven; rolling back restores its state in place.
+    /// </summary>
+    public MachineBase Machine { get; }
+
+    /// <summary>
+    /// Input from local controllers is raised here rather than on the machine.
+    /// Only the elements owned by <see cref="LocalJack"/> are transmitted and used.
+    /// </summary>
+    public InputState LocalInputState { get; } = new();
+
+    public NetplayState State { get; private set; } = NetplayState.Synchronizing;
+
+    public string FailureReason { get; private set; } = string.Empty;
+
+    public int LocalJack => _localJack;
+
+    /// <summary>
+    /// Number of frames simulated so far.
+    /// </summary>
+    public int Frame => _frame;
+
+    /// <summary>
+    /// Estimated number of frames this site is running ahead of the remote site.
+    /// A positive value means the local frame pacing should be relaxed.
+    /// </summary>
+    public float FrameAdvantage => ((_frame - _remoteFrame) - _remoteAdvantage) / 2f;
+
+    public long Rollbacks { get; private set; }
+
+    public int LastRollbackDepth { get; private set; }
+
+    public int MaxRollbackDepth { get; private set; }
+
+    public long TotalRollbackFrames { get; private set; }
+
+    public TimeSpan LastResimulationTime { get; private set; }
+
+    public TimeSpan MaxResimulationTime { get; private set; }
+
+    /// <summary>
+    /// Number of frames not simulated because the remote site fell too far behind.
+    /// </summary>
+    public long Stalls { get; private set; }
+
+    /// <summary>
+    /// Reports whether a state checksum exchanged with the remote site failed to match.
+    /// </summary>
+    public bool Desynced { get; private set; }
+
+    /// <summary>
+    /// Exchanges input with the remote site and, when possible, simulates the next frame.
+    /// Call once per frame period.
+    /// </summary>
+    /// <returns>True if a new frame was computed.</returns>
+    public bool AdvanceFrame()
+    {
+        Poll();
+
+        switch (State)
+        {
+            case NetplayState.Synchronizing:
+            case NetplayState.Failed:
+                // Keep announcing so that a mismatched remote site also detects the failure.
+                SendSync();
+                return false;
+            case NetplayState.Disconnected:
+                // Carry on locally, holding the remote input at its last known value.
+                CaptureLocalInput(_frame);
+                SimulateFrame(_frame++, false);
+                return true;
+        }
+
+        if (Stopwatch.GetElapsedTime(_lastReceiveTimestamp) > DisconnectTimeout)
+        {
+            _logger.Log(1, $"Netplay: no response from {_transport.RemoteEndPoint} for {DisconnectTimeout.TotalSeconds}s, continuing locally");
+            State = NetplayState.Disconnected;
+            _firstIncorrectFrame = -1;
+            return false;
+        }
+
+        if (_firstIncorrectFrame >= 0)
+        {
+            Rollback();
+        }
+
+        UpdateLocalCheck();
+
+        if (_frame - _lastConfirmedRemoteFrame > _maxPredictionFrames)
+        {
+            Stalls++;
+            SendInput();
+            return false;
+        }
+
+        CaptureLocalInput(_frame);
+        SimulateFrame(_frame++, true);
+        SendInput();
+        return true;
+    }
+
+    public override string ToString()
+        => $"Netplay {State}: frame {_frame}, {Rollbacks} rollbacks ({TotalRollbackFrames} frames re-simulated, max depth {MaxRollbackDepth}, max {MaxResimulationTime.TotalMilliseconds:0.00}ms), {Stalls} stalls{(Desynced ? ", DESYNCED" : string.Empty)}";
+
+    public void Dispose()
+    {
+        _transport.Dispose();
+        foreach (var writer in _snapshotWriters)
+        {
+            writer.Dispose();
+        }
+        foreach (var reader in _snapshotReaders)
+        {
+            reader.Dispose();
+        }
+    }
+
+    #endregion
+
+    #region Constructors
+
+    /// <param name="machine">Freshly created machine; the remote site must start from identical state.</param>
+    /// <param name="transport">Datagram channel to the remote site; owned by the session.</param>
+    /// <param name="localJack">Controller jack driven from this site, 0 (left) or 1 (right).</param>
+    /// <param name="maxPredictionFrames">Number of frames the session may run ahead of confirmed remote input.</param>
+    /// <param name="logger"></param>
+    public RollbackSession(MachineBase machine, NetplayTransport transport, int localJack, int maxPredictionFrames, ILogger logger)
+    {
+        ArgumentException.ThrowIf(localJack is < 0 or > 1, "must be 0 or 1", nameof(localJack));
+        ArgumentException.ThrowIf(maxPredictionFrames is < 1 or > MaxInputsPerPacket, "must be between 1 and 16", nameof(maxPredictionFrames));
+
+        Machine = machine;
+        _transport = transport;
+        _logger = logger;
+        _localJack = localJack;
+        _remoteJack = localJack ^ 1;
+        _maxPredictionFrames = maxPredictionFrames;
+
+        _localInputs = new int[InputRingSize * _vectorLength];
+        _remoteInputs = new int[InputRingSize * _vectorLength];
+        _initialRemoteInput = new int[_vectorLength];
+        _frameInput = new int[_vectorLength];
+        _scratchInput = new int[_vectorLength];
+        _maskedInput = new int[_vectorLength];
+        _inputAdvancing = nis => _frameInput.CopyTo(nis, 0);
+
+        LocalInputState.LeftControllerJack = machine.InputState.LeftControllerJack;
+        LocalInputState.RightControllerJack = machine.InputState.RightControllerJack;
+
+        // Until the first remote input arrives, predict whatever the machine starts with.
+        machine.InputState.CopyNextInputStateTo(_scratchInput);
+        InputState.MergeJackInput(_scratchInput, _initialRemoteInput, _remoteJack);
+
+        var snapshotCount = maxPredictionFrames + 2;
+        _snapshots = new MemoryStream[snapshotCount];
+        _snapshotWriters = new BinaryWriter[snapshotCount];
+        _snapshotOutputs = new SerializationContext[snapshotCount];
+        _snapshotReaders = new BinaryReader[snapshotCount];
+        _snapshotInputs = new DeserializationContext[snapshotCount];
+        _snapshotFrames = new int[snapshotCount];
+        for (var i = 0; i < snapshotCount; i++)
+        {
+            _snapshots[i] = new();
+            _snapshotWriters[i] = new(_snapshots[i]);
+            _snapshotOutputs[i] = new(_snapshotWriters[i]);
+            _snapshotReaders[i] = new(_snapshots[i]);
+            _snapshotInputs[i] = new(_snapshotReaders[i]);
+            _snapshotFrames[i] = -1;
+        }
+
+        Array.Fill(_localChecks, (-1, 0UL));
+
+        machine.InputState.InputAdvancing = _inputAdvancing;
+
+        SaveSnapshot(0);
+        _initialStateHash = HashSnapshot(0);
+        _lastReceiveTimestamp = Stopwatch.GetTimestamp();
+    }
+
+    #endregion
+
+    #region Helpers
+
+    Span<int> LocalInput(int frame)
+        => _localInputs.AsSpan((frame & (InputRingSize - 1)) * _vectorLength, _vectorLength);
+
+    Span<int> RemoteInput(int frame)
+        => frame < 0 ? _initialRemoteInput : _remoteInputs.AsSpan((frame & (InputRingSize - 1)) * _vectorLength, _vectorLength);
+
+    void CaptureLocalInput(int frame)
+    {
+        LocalInputState.CopyNextInputStateTo(_scratchInput);
+        var input = LocalInput(frame);
+        input.Clear();
+        InputState.MergeJackInput(_scratchInput, input, _localJack);
+    }
+
+    void SimulateFrame(int frame, bool saveSnapshots)
+    {
+        var predicted = frame > _lastConfirmedRemoteFrame;
+        if (saveSnapshots && (predicted || frame % CheckpointInterval == 0))
+        {
+            SaveSnapshot(frame);
+        }
+        if (predicted)
+        {
+            // Predict that the remote site is still doing what it was last seen doing.
+            RemoteInput(_lastConfirmedRemoteFrame).CopyTo(RemoteInput(frame));
+        }
+
+        Array.Clear(_frameInput);
+        InputState.MergeJackInput(LocalInput(frame), _frameInput, _localJack);
+        InputState.MergeJackInput(RemoteInput(frame), _frameInput, _remoteJack);
+
+        Machine.ComputeNextFrame();
+    }
+
+    void Rollback()
+    {
+        var startTimestamp = Stopwatch.GetTimestamp();
+        var rollbackFrame = _firstIncorrectFrame;
+        _firstIncorrectFrame = -1;
+
+        if (!LoadSnapshot(rollbackFrame))
+        {
+            Fail($"Netplay: no snapshot available to roll back to frame {rollbackFrame}");
+            return;
+        }
+
+        for (var frame = rollbackFrame; frame < _frame; frame++)
+        {
+            SimulateFrame(frame, true);
+        }
+
+        var depth = _frame - rollbackFrame;
+        var elapsed = Stopwatch.GetElapsedTime(startTimestamp);
+
+        Rollbacks++;
+        TotalRollbackFrames += depth;
+        LastRollbackDepth = depth;
+        LastResimulationTime = elapsed;
+        if (depth > MaxRollbackDepth)
+            MaxRollbackDepth = depth;
+        if (elapsed > MaxResimulationTime)
+            MaxResimulationTime = elapsed;
+
+        _logger.Log(5, $"Netplay: rolled back {depth} frames to frame {rollbackFrame} in {elapsed.TotalMilliseconds:0.000}ms");
+    }
+
+    void SaveSnapshot(int frame)
+    {
+        var i = frame % _snapshots.Length;
+        _snapshots[i].SetLength(0);
+        _snapshotOutputs[i].Write(Machine);
+        _snapshotWriters[i].Flush();
+        _snapshotFrames[i] = frame;
+    }
+
+    bool LoadSnapshot(int frame)
+    {
+        var i = frame % _snapshots.Length;
+        if (_snapshotFrames[i] != frame)
+            return false;
+
+        _snapshots[i].Position = 0;
+        _snapshotInputs[i].RestoreMachine(Machine);
+        return true;
+    }
+
+    ulong HashSnapshot(int frame)
+    {
+        var i = frame % _snapshots.Length;
+        return Fnv1a(_snapshots[i].GetBuffer().AsSpan(0, (int)_snapshots[i].Length));
+    }
+
+    void UpdateLocalCheck()
+    {
+        // The snapshot taken ahead of a checkpoint frame is final once all remote input preceding it is confirmed.
+        if (_nextCheckFrame >= _frame || _nextCheckFrame > _lastConfirmedRemoteFrame + 1)
+            return;
+
+        var frame = _nextCheckFrame;
+        _nextCheckFrame += CheckpointInterval;
+        if (_snapshotFrames[frame % _snapshots.Length] != frame)
+            return;
+
+        var hash = HashSnapshot(frame);
+        _localChecks[_localCheckCount++ % CheckRingSize] = (frame, hash);
+        CompareChecks(frame, hash, _remoteCheck.Frame, _remoteCheck.Hash);
+    }
+
+    void CompareChecks(int localFrame, ulong localHash, int remoteFrame, ulong remoteHash)
+    {
+        if (Desynced || localFrame != remoteFrame || localHash == remoteHash)
+            return;
+        Desynced = true;
+        _logger.Log(1, $"Netplay: machine state diverged from remote site at frame {localFrame}");
+    }
+
+    void Poll()
+    {
+        int length;
+        while ((length = _transport.Receive(_receiveBuffer)) > 0)
+        {
+            var packet = _receiveBuffer.AsSpan(0, length);
+            if (length < 5 || BinaryPrimitives.ReadUInt32LittleEndian(packet) != PacketMagic)
+                continue;
+
+            _lastReceiveTimestamp = Stopwatch.GetTimestamp();
+
+            switch (packet[4])
+            {
+                case PacketTypeSync when length >= SyncPacketSize:
+                    ReceiveSync(packet);
+                    break;
+                case PacketTypeInput when length >= InputHeaderSize:
+                    ReceiveInput(packet);
+                    break;
+            }
+        }
+    }
+
+    void ReceiveSync(ReadOnlySpan<byte> packet)
+    {
+        if (State == NetplayState.Failed)
+            return;
+
+        var remoteJack = packet[5];
+        var remoteSawUs = packet[6] != 0;
+        var remoteHash = BinaryPrimitives.ReadUInt64LittleEndian(packet[7..]);
+
+        if (remoteJack == _localJack)
+        {
+            Fail($"Netplay: both sites are configured to drive controller jack {_localJack + 1}");
+            return;
+        }
+        if (remoteHash != _initialStateHash)
+        {
+            Fail("Netplay: remote machine does not match local machine (check ROM, machine type, and controllers)");
+            return;
+        }
+
+        _peerSeen = true;
+        _peerSawUs |= remoteSawUs;
+
+        if (State == NetplayState.Synchronizing && _peerSawUs)
+        {
+            Start();
+        }
+        if (State == NetplayState.Running && !remoteSawUs)
+        {
+            // The remote site missed our acknowledgement.
+            SendSync();
+        }
+    }
+
+    void ReceiveInput(ReadOnlySpan<byte> packet)
+    {
+        if (State == NetplayState.Failed)
+            return;
+        if (State == NetplayState.Synchronizing)
+        {
+            if (!_peerSeen)
+                return;
+            Start();
+        }
+
+        var ackFrame = BinaryPrimitives.ReadInt32LittleEndian(packet[5..]);
+        var remoteFrame = BinaryPrimitives.ReadInt32LittleEndian(packet[9..]);
+        var remoteAdvantage = BinaryPrimitives.ReadInt32LittleEndian(packet[13..]);
+        var startFrame = BinaryPrimitives.ReadInt32LittleEndian(packet[17..]);
+        int count = packet[21];
+        var checkFrame = BinaryPrimitives.ReadInt32LittleEndian(packet[22..]);
+        var checkHash = BinaryPrimitives.ReadUInt64LittleEndian(packet[26..]);
+
+        if (packet.Length < InputHeaderSize + count * _vectorLength * sizeof(int))
+            return;
+
+        if (ackFrame > _remoteAckFrame)
+            _remoteAckFrame = ackFrame;
+        if (remoteFrame > _remoteFrame)
+            (_remoteFrame, _remoteAdvantage) = (remoteFrame, remoteAdvantage);
+
+        if (checkFrame > _remoteCheck.Frame)
+        {
+            _remoteCheck = (checkFrame, checkHash);
+            for (var i = 0; i < CheckRingSize; i++)
+            {
+                CompareChecks(_localChecks[i].Frame, _localChecks[i].Hash, checkFrame, checkHash);
+            }
+        }
+
+        var inputs = packet[InputHeaderSize..];
+        for (var i = 0; i < count; i++, inputs = inputs[(_vectorLength * sizeof(int))..])
+        {
+            var frame = startFrame + i;
+            if (frame <= _lastConfirmedRemoteFrame)
+                continue;
+            if (frame != _lastConfirmedRemoteFrame + 1)
+                break;
+
+            for (var j = 0; j < _vectorLength; j++)
+            {
+                _scratchInput[j] = BinaryPrimitives.ReadInt32LittleEndian(inputs[(j * sizeof(int))..]);
+            }
+            var confirmed = RemoteInput(frame);
+            if (frame < _frame)
+            {
+                // Compare against the prediction the frame was simulated with.
+                Array.Clear(_maskedInput);
+                InputState.MergeJackInput(_scratchInput, _maskedInput, _remoteJack);
+                if (!_maskedInput.AsSpan().SequenceEqual(confirmed) && (_firstIncorrectFrame < 0 || frame < _firstIncorrectFrame))
+                {
+                    _firstIncorrectFrame = frame;
+                }
+            }
+            confirmed.Clear();
+            InputState.MergeJackInput(_scratchInput, confirmed, _remoteJack);
+            _lastConfirmedRemoteFrame = frame;
+        }
+    }
+
+    void Start()
+    {
+        State = NetplayState.Running;
+        _lastReceiveTimestamp = Stopwatch.GetTimestamp();
+        _logger.Log(3, $"Netplay: synchronized with {_transport.RemoteEndPoint}, driving controller jack {_localJack + 1}");
+    }
+
+    void SendSync()
+    {
+        // Resend periodically rather than every frame while waiting for the remote site
+        if (State != NetplayState.Running && _syncCountdown-- > 0)
+            return;
+        _syncCountdown = SyncIntervalFrames;
+
+        var packet = _sendBuffer.AsSpan(0, SyncPacketSize);
+        BinaryPrimitives.WriteUInt32LittleEndian(packet, PacketMagic);
+        packet[4] = PacketTypeSync;
+        packet[5] = (byte)_localJack;
+        packet[6] = (byte)(_peerSeen ? 1 : 0);
+        BinaryPrimitives.WriteUInt64LittleEndian(packet[7..], _initialStateHash);
+        _transport.Send(packet);
+    }
+
+    void SendInput()
+    {
+        var startFrame = _remoteAckFrame + 1;
+        var count = Math.Clamp(_frame - startFrame, 0, MaxInputsPerPacket);
+        var (checkFrame, checkHash) = _localCheckCount > 0 ? _localChecks[(_localCheckCount - 1) % CheckRingSize] : (-1, 0UL);
+
+        var packet = _sendBuffer.AsSpan(0, InputHeaderSize + count * _vectorLength * sizeof(int));
+        BinaryPrimitives.WriteUInt32LittleEndian(packet, PacketMagic);
+        packet[4] = PacketTypeInput;
+        BinaryPrimitives.WriteInt32LittleEndian(packet[5..], _lastConfirmedRemoteFrame);
+        BinaryPrimitives.WriteInt32LittleEndian(packet[9..], _frame);
+        BinaryPrimitives.WriteInt32LittleEndian(packet[13..], _frame - _remoteFrame);
+        BinaryPrimitives.WriteInt32LittleEndian(packet[17..], startFrame);
+        packet[21] = (byte)count;
+        BinaryPrimitives.WriteInt32LittleEndian(packet[22..], checkFrame);
+        BinaryPrimitives.WriteUInt64LittleEndian(packet[26..], checkHash);
+
+        var inputs = packet[InputHeaderSize..];
+        for (var i = 0; i < count; i++)
+        {
+            var input = LocalInput(startFrame + i);
+            for (var j = 0; j < _vectorLength; j++, inputs = inputs[sizeof(int)..])
+            {
+                BinaryPrimitives.WriteInt32LittleEndian(inputs, input[j]);
+            }
+        }
+
+        _transport.Send(packet);
+    }
+
+    void Fail(string reason)
+    {
+        State = NetplayState.Failed;
+        FailureReason = reason;
+        _logger.Log(1, reason);
+    }
+
+    static ulong Fnv1a(ReadOnlySpan<byte> data)
+    {
+        var hash = 0xcbf29ce484222325UL;
+        foreach (var b in data)
+        {
+            hash = (hash ^ b) * 0x100000001b3UL;
+        }
+        return hash;
+    }
+
+    #endregion
+}
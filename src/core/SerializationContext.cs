@@ -1,5 +1,6 @@
 ﻿using System;
 using System.IO;
+using System.Runtime.InteropServices;
 
 namespace EMU7800.Core;
 
@@ -42,6 +43,9 @@ public class SerializationContext
         => _binaryWriter.Write(value);
 
     public void Write(byte[] bytes)
+        => Write(bytes.AsSpan());
+
+    public void Write(ReadOnlySpan<byte> bytes)
     {
         _binaryWriter.Write(bytes.Length);
         if (bytes.Length > 0)
@@ -49,34 +53,24 @@ public class SerializationContext
     }
 
     public void Write(ushort[] ushorts)
-    {
-        var bytes = new byte[ushorts.Length << 1];
-        Buffer.BlockCopy(ushorts, 0, bytes, 0, bytes.Length);
-        Write(bytes);
-    }
+        => Write((ReadOnlySpan<ushort>)ushorts);
+
+    public void Write(ReadOnlySpan<ushort> ushorts)
+        => Write(MemoryMarshal.AsBytes(ushorts));
 
     public void Write(int[] ints)
-    {
-        var bytes = new byte[ints.Length << 2];
-        Buffer.BlockCopy(ints, 0, bytes, 0, bytes.Length);
-        Write(bytes);
-    }
+        => Write(MemoryMarshal.AsBytes(ints.AsSpan()));
 
     public void Write(uint[] uints)
-    {
-        var bytes = new byte[uints.Length << 2];
-        Buffer.BlockCopy(uints, 0, bytes, 0, bytes.Length);
-        Write(bytes);
-    }
+        => Write(MemoryMarshal.AsBytes(uints.AsSpan()));
 
     public void Write(bool[] booleans)
     {
-        var bytes = new byte[booleans.Length];
-        for (var i = 0; i < bytes.Length; i++)
+        _binaryWriter.Write(booleans.Length);
+        foreach (var b in booleans)
         {
-            bytes[i] = (byte)(booleans[i] ? 0xff : 0x00);
+            _binaryWriter.Write((byte)(b ? 0xff : 0x00));
         }
-        Write(bytes);
     }
 
     public void Write(MachineBase m)
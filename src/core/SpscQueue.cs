@@ -0,0 +1,79 @@
+/*
+ * SpscQueue.cs
+ *
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class SpscQueue<T> where T : struct
+{
+    readonly T[] _buffer;
+    readonly int _mask;
+
+    // Producer and consumer indices live on separate cache lines so the two threads do not contend.
+    PaddedIndex _head, _tail;
+
+    public int Capacity => _buffer.Length;
+
+    /// <summary>
+    /// Consumer side: reports whether an item is available, without dequeuing it.
+    /// </summary>
+    public bool IsEmpty
+        => Volatile.Read(ref _tail.Value) == _head.Value;
+
+    /// <summary>
+    /// Producer side: appends an item, or returns false if the queue is full.
+    /// </summary>
+    public bool TryEnqueue(in T item)
+    {
+        var tail = _tail.Value;
+        if (tail - Volatile.Read(ref _head.Value) >= _buffer.Length)
+            return false;
+        _buffer[tail & _mask] = item;
+        Volatile.Write(ref _tail.Value, tail + 1);
+        return true;
+    }
+
+    /// <summary>
+    /// Consumer side: removes the oldest item, if any.
+    /// </summary>
+    public bool TryDequeue(out T item)
+    {
+        var head = _head.Value;
+        if (head == Volatile.Read(ref _tail.Value))
+        {
+            item = default;
+            return false;
+        }
+        item = _buffer[head & _mask];
+        Volatile.Write(ref _head.Value, head + 1);
+        return true;
+    }
+
+    #region Constructors
+
+    /// <param name="capacity">Maximum number of queued items; must be a power of two.</param>
+    public SpscQueue(int capacity)
+    {
+        ArgumentException.ThrowIf(capacity <= 0 || (capacity & (capacity - 1)) != 0, "must be a positive power of two", nameof(capacity));
+
+        _buffer = new T[capacity];
+        _mask = capacity - 1;
+    }
+
+    #endregion
+}
+
+[StructLayout(LayoutKind.Explicit, Size = 128)]
+struct PaddedIndex
+{
+    [FieldOffset(64)] public long Value;
+}
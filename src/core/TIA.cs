@@ -330,7 +330,7 @@ public sealed class TIA : IDevice
 
         TIASound.Reset();
 
-        Log($"{this} reset");
+        M.Logger.Log(4, $"{this} reset");
     }
 
     public void StartFrame()
@@ -475,7 +475,7 @@ public sealed class TIA : IDevice
         }
 
         WritePixel:
-        Collisions |= TIATables.CollisionMask.Span[(int)cxflags];
+        Collisions |= TIATables.CollisionMaskFetch((int)cxflags);
 
         if (HSync >= 68)
         {
@@ -724,7 +724,7 @@ public sealed class TIA : IDevice
 
     void opRSYNC(ushort addr, byte data)
     {
-        Log($"TIA RSYNC: frame={M.FrameNumber} scanline={ScanLine} hsync={PokeOpHSync}");
+        M.Logger.Log(4, $"TIA RSYNC: frame={M.FrameNumber} scanline={ScanLine} hsync={PokeOpHSync}");
     }
 
     void opNUSIZ0(ushort addr, byte data)
@@ -790,13 +790,13 @@ public sealed class TIA : IDevice
     void SetEffGRP0()
     {
         var grp0 = RegW[VDELP0] != 0 ? OldGRP0 : RegW[GRP0];
-        EffGRP0 = RegW[REFP0] != 0 ? TIATables.GRPReflect.Span[grp0] : grp0;
+        EffGRP0 = RegW[REFP0] != 0 ? TIATables.GRPReflect[grp0] : grp0;
     }
 
     void SetEffGRP1()
     {
         var grp1 = RegW[VDELP1] != 0 ? OldGRP1 : RegW[GRP1];
-        EffGRP1 = RegW[REFP1] != 0 ? TIATables.GRPReflect.Span[grp1] : grp1;
+        EffGRP1 = RegW[REFP1] != 0 ? TIATables.GRPReflect[grp1] : grp1;
     }
 
     void Setblon()
@@ -1196,9 +1196,19 @@ public sealed class TIA : IDevice
     {
         M = m;
         TIASound = input.ReadTIASound(M, CPU_TICKS_PER_AUDIO_SAMPLE);
+        ReadState(input);
+    }
 
+    public void Restore(DeserializationContext input)
+    {
+        TIASound.Restore(input);
+        ReadState(input);
+    }
+
+    void ReadState(DeserializationContext input)
+    {
         input.CheckVersion(1);
-        RegW = input.ReadExpectedBytes(0x40);
+        input.ReadBytesInto(RegW);
         HSync = input.ReadInt32();
         HMoveCounter = input.ReadInt32();
         ScanLine = input.ReadInt32();
@@ -1308,11 +1318,4 @@ public sealed class TIA : IDevice
     }
 
     #endregion
-
-    #region Helpers
-
-    void Log(string message)
-        => M.Logger.Log(4, message);
-
-    #endregion
 }
\ No newline at end of file
@@ -78,7 +78,7 @@ public sealed class TIASound
     // implemented by using counters.
     readonly byte[] Div31 = [0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
 
-    // Rather than have a table with 511 entries, I use a random number
+    // The 9-bit poly, generated as the hardware does from a 9-bit LFSR
     readonly byte[] Bit9 = new byte[511];  // 2^9 - 1 = 511
 
     readonly int[] P4 = new int[2];  // Position counter for the 4-bit POLY array
@@ -104,6 +104,9 @@ public sealed class TIASound
     // The last output volume for each channel
     readonly byte[] OutputVol = new byte[2];
 
+    // Volume-only channels the cart's music generator renders in place of AUDV
+    readonly bool[] Relayed = new bool[2];
+
     // Used to determine how much sound to render
     ulong LastUpdateCPUClock;
 
@@ -118,6 +121,7 @@ public sealed class TIASound
         for (var chan = 0; chan < 2; chan++)
         {
             OutputVol[chan] = 0;
+            Relayed[chan] = false;
             DivByNCounter[chan] = 0;
             DivByNMaximum[chan] = 0;
             AUDC[chan] = 0;
@@ -182,6 +186,17 @@ public sealed class TIASound
                 return;
         }
 
+        var music = M.Cart.Music;
+        if (music is not null)
+        {
+            var relayed = AUDC[chan] == SET_TO_1 && (addr is AUDV0 or AUDV1 ? music.IsRelayedAmplitude(data) : Relayed[chan]);
+            if (relayed != Relayed[chan])
+            {
+                Relayed[chan] = relayed;
+                music.SetRelay(chan, relayed);
+            }
+        }
+
         byte new_divn_max;
 
         if (AUDC[chan] == SET_TO_1)
@@ -189,7 +204,7 @@ public sealed class TIASound
             // indicate the clock is zero so no process will occur
             new_divn_max = 0;
             // and set the output to the selected volume
-            OutputVol[chan] = AUDV[chan];
+            OutputVol[chan] = Relayed[chan] ? (byte)0 : AUDV[chan];
         }
         else
         {
@@ -222,11 +237,12 @@ public sealed class TIASound
 
     private TIASound()
     {
-        var r = new Random();
-        r.NextBytes(Bit9);
+        // x^9 + x^5 + 1
+        var lfsr = 0x1ff;
         for (var i = 0; i < Bit9.Length; i++)
         {
-            Bit9[i] &= 0x01;
+            Bit9[i] = (byte)(lfsr & 1);
+            lfsr = (lfsr >> 1) | (((lfsr ^ (lfsr >> 4)) & 1) << 8);
         }
     }
 
@@ -243,25 +259,32 @@ public sealed class TIASound
     #region Serialization Members
 
     public TIASound(DeserializationContext input, MachineBase m, int cpuClocksPerSample) : this(m, cpuClocksPerSample)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
-        input.CheckVersion(1);
-        Bit9 = input.ReadExpectedBytes(511);
-        P4 = input.ReadIntegers(2);
-        P5 = input.ReadIntegers(2);
-        P9 = input.ReadIntegers(2);
-        DivByNCounter = input.ReadIntegers(2);
-        DivByNMaximum = input.ReadIntegers(2);
-        AUDC = input.ReadExpectedBytes(2);
-        AUDF = input.ReadExpectedBytes(2);
-        AUDV = input.ReadExpectedBytes(2);
-        OutputVol = input.ReadExpectedBytes(2);
+        var version = input.CheckVersion(1, 2);
+        input.ReadBytesInto(Bit9);
+        input.ReadIntegersInto(P4);
+        input.ReadIntegersInto(P5);
+        input.ReadIntegersInto(P9);
+        input.ReadIntegersInto(DivByNCounter);
+        input.ReadIntegersInto(DivByNMaximum);
+        input.ReadBytesInto(AUDC);
+        input.ReadBytesInto(AUDF);
+        input.ReadBytesInto(AUDV);
+        input.ReadBytesInto(OutputVol);
+        if (version >= 2)
+            input.ReadBooleansInto(Relayed);
+        else
+            Array.Clear(Relayed);
         LastUpdateCPUClock = input.ReadUInt64();
         BufferIndex = input.ReadInt32();
     }
 
     public void GetObjectData(SerializationContext output)
     {
-        output.WriteVersion(1);
+        output.WriteVersion(2);
         output.Write(Bit9);
         output.Write(P4);
         output.Write(P5);
@@ -272,6 +295,7 @@ public sealed class TIASound
         output.Write(AUDF);
         output.Write(AUDV);
         output.Write(OutputVol);
+        output.Write(Relayed);
         output.Write(LastUpdateCPUClock);
         output.Write(BufferIndex);
     }
@@ -0,0 +1,72 @@
+/*
+ * TraceReader.cs
+ *
+ * Provides read access to a trace file produced by TraceRecorder.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.Serialization;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class TraceReader : IDisposable
+{
+    readonly MemoryMappedFile _mmf;
+    readonly MemoryMappedViewAccessor _view;
+
+    public long RecordCount { get; }
+
+    public TraceRecord this[long index]
+    {
+        get
+        {
+            _view.Read(TraceRecorder.HeaderSize + index * TraceRecord.Size, out TraceRecord record);
+            return record;
+        }
+    }
+
+    /// <summary>
+    /// Reads a contiguous run of records starting at the specified index.
+    /// </summary>
+    /// <returns>Number of records read.</returns>
+    public int Read(long index, TraceRecord[] buffer)
+    {
+        var count = (int)Math.Min(buffer.Length, Math.Max(0, RecordCount - index));
+        return count > 0 ? _view.ReadArray(TraceRecorder.HeaderSize + index * TraceRecord.Size, buffer, 0, count) : 0;
+    }
+
+    public void Dispose()
+    {
+        _view.Dispose();
+        _mmf.Dispose();
+    }
+
+    #region Constructors
+
+    public TraceReader(string fileName)
+    {
+        var length = new FileInfo(fileName).Length;
+        SerializationException.ThrowIf(length < TraceRecorder.HeaderSize, "Trace file too short.");
+
+        _mmf = MemoryMappedFile.CreateFromFile(fileName, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+        _view = _mmf.CreateViewAccessor(0, length, MemoryMappedFileAccess.Read);
+
+        var magic = _view.ReadUInt32(0);
+        var version = _view.ReadUInt16(4);
+        var recordSize = _view.ReadUInt16(6);
+        if (magic != TraceRecorder.Magic || version != TraceRecorder.Version || recordSize != TraceRecord.Size)
+        {
+            Dispose();
+            throw new SerializationException("Unrecognized trace file format.");
+        }
+
+        RecordCount = Math.Min(_view.ReadInt64(8), (length - TraceRecorder.HeaderSize) / TraceRecord.Size);
+    }
+
+    #endregion
+}
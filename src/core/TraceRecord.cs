@@ -0,0 +1,53 @@
+/*
+ * TraceRecord.cs
+ *
+ * A fixed-size record of a single executed CPU instruction.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System.Runtime.InteropServices;
+
+namespace EMU7800.Core;
+
+[StructLayout(LayoutKind.Sequential, Pack = 1, Size = Size)]
+public struct TraceRecord
+{
+    public const int Size = 24;
+
+    /// <summary>
+    /// CPU clock at the start of the instruction.
+    /// </summary>
+    public ulong Clock;
+
+    /// <summary>
+    /// Address of the opcode.
+    /// </summary>
+    public ushort PC;
+
+    public byte OpCode;
+    public byte Operand1;
+    public byte Operand2;
+
+    // Registers prior to execution of the instruction
+    public byte A;
+    public byte X;
+    public byte Y;
+    public byte S;
+    public byte P;
+
+    /// <summary>
+    /// Address of the last bus access made by the instruction.
+    /// </summary>
+    public ushort BusAddress;
+
+    /// <summary>
+    /// Data of the last bus access made by the instruction.
+    /// </summary>
+    public byte BusData;
+
+    /// <summary>
+    /// Cart bank mapped at PC.
+    /// </summary>
+    public byte Bank;
+}
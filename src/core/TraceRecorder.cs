@@ -0,0 +1,182 @@
+/*
+ * TraceRecorder.cs
+ *
+ * Records executed CPU instructions to a trace file.
+ *
+ * Records are handed off from the emulation thread through a single-producer/single-consumer
+ * ring buffer to a spill thread that copies them into a memory-mapped file.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Threading;
+using EMU7800.Core.Extensions;
+
+namespace EMU7800.Core;
+
+public sealed class TraceRecorder : IDisposable
+{
+    public const uint Magic = 0x54383745; // "E78T"
+    public const ushort Version = 1;
+    public const int HeaderSize = 16;
+
+    const int
+        DefaultRingShift    = 16,
+        InitialFileRecords  = 1 << 20;
+
+    readonly TraceRecord[] _ring;
+    readonly int _ringMask;
+
+    // _head is only written by the producer, _tail only by the consumer
+    long _head, _tail;
+
+    readonly string _fileName;
+    readonly Thread _spillThread;
+    volatile bool _stopRequested;
+
+    MemoryMappedFile _mmf;
+    MemoryMappedViewAccessor _view;
+    long _fileRecordCapacity;
+    bool _disposed;
+
+    /// <summary>
+    /// Number of records written to the trace file.
+    /// </summary>
+    public long RecordCount { get; private set; }
+
+    /// <summary>
+    /// Number of times the emulation thread had to wait on a full ring buffer.
+    /// </summary>
+    public long Stalls { get; private set; }
+
+    public void Record(in TraceRecord record)
+    {
+        var head = _head;
+        if (head - Volatile.Read(ref _tail) > _ringMask)
+        {
+            WaitForSpace(head);
+        }
+        _ring[head & _ringMask] = record;
+        Volatile.Write(ref _head, head + 1);
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+            return;
+        _disposed = true;
+
+        _stopRequested = true;
+        _spillThread.Join();
+        Spill();
+
+        _view.Write(8, RecordCount);
+        _view.Dispose();
+        _mmf.Dispose();
+
+        using var fs = new FileStream(_fileName, FileMode.Open, FileAccess.Write, FileShare.Read);
+        fs.SetLength(HeaderSize + RecordCount * TraceRecord.Size);
+    }
+
+    #region Constructors
+
+    public TraceRecorder(string fileName) : this(fileName, DefaultRingShift)
+    {
+    }
+
+    public TraceRecorder(string fileName, int ringShift)
+    {
+        ArgumentException.ThrowIf(ringShift is < 4 or > 24, "must be between 4 and 24", nameof(ringShift));
+
+        _ring = new TraceRecord[1 << ringShift];
+        _ringMask = _ring.Length - 1;
+
+        _fileName = fileName;
+        File.Delete(_fileName);
+
+        _fileRecordCapacity = InitialFileRecords;
+        (_mmf, _view) = OpenView(_fileName, _fileRecordCapacity);
+        _view.Write(0, Magic);
+        _view.Write(4, Version);
+        _view.Write(6, (ushort)TraceRecord.Size);
+        _view.Write(8, 0L);
+
+        _spillThread = new Thread(SpillThreadProc) { IsBackground = true, Name = nameof(TraceRecorder) };
+        _spillThread.Start();
+    }
+
+    #endregion
+
+    #region Helpers
+
+    void WaitForSpace(long head)
+    {
+        Stalls++;
+        var spinner = new SpinWait();
+        while (head - Volatile.Read(ref _tail) > _ringMask)
+        {
+            spinner.SpinOnce();
+        }
+    }
+
+    void SpillThreadProc()
+    {
+        while (!_stopRequested)
+        {
+            if (!Spill())
+            {
+                Thread.Sleep(1);
+            }
+        }
+    }
+
+    bool Spill()
+    {
+        var tail = _tail;
+        var head = Volatile.Read(ref _head);
+        if (head == tail)
+            return false;
+
+        var count = head - tail;
+        if (RecordCount + count > _fileRecordCapacity)
+        {
+            Grow(RecordCount + count);
+        }
+
+        var start = (int)(tail & _ringMask);
+        var firstCount = (int)Math.Min(count, _ring.Length - start);
+        var position = HeaderSize + RecordCount * TraceRecord.Size;
+        _view.WriteArray(position, _ring, start, firstCount);
+        if (firstCount < count)
+        {
+            _view.WriteArray(position + (long)firstCount * TraceRecord.Size, _ring, 0, (int)count - firstCount);
+        }
+
+        RecordCount += count;
+        Volatile.Write(ref _tail, head);
+        return true;
+    }
+
+    void Grow(long minRecords)
+    {
+        while (_fileRecordCapacity < minRecords)
+        {
+            _fileRecordCapacity <<= 1;
+        }
+        _view.Dispose();
+        _mmf.Dispose();
+        (_mmf, _view) = OpenView(_fileName, _fileRecordCapacity);
+    }
+
+    static (MemoryMappedFile, MemoryMappedViewAccessor) OpenView(string fileName, long recordCapacity)
+    {
+        var capacity = HeaderSize + recordCapacity * TraceRecord.Size;
+        var mmf = MemoryMappedFile.CreateFromFile(fileName, FileMode.OpenOrCreate, null, capacity, MemoryMappedFileAccess.ReadWrite);
+        return (mmf, mmf.CreateViewAccessor(0, capacity));
+    }
+
+    #endregion
+}
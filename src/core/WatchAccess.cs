@@ -0,0 +1,17 @@
+﻿/*
+ * WatchAccess.cs
+ *
+ * The kinds of memory access an address space watch reports.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+namespace EMU7800.Core;
+
+[System.Flags]
+public enum WatchAccess
+{
+    Read      = 1,
+    Write     = 2,
+    ReadWrite = Read | Write
+}
\ No newline at end of file
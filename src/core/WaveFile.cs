@@ -0,0 +1,38 @@
+/*
+ * WaveFile.cs
+ *
+ * The header of the 8-bit mono PCM WAV files written by the capture recorder and the SoundEmulator tool.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+using System;
+using System.IO;
+
+namespace EMU7800.Core;
+
+public static class WaveFile
+{
+    public const int HeaderSize = 44;
+
+    /// <summary>
+    /// Writes the header of an 8-bit mono PCM WAV file holding the specified number of samples.
+    /// </summary>
+    public static void WriteHeader(Stream stream, int sampleFrequency, long samples)
+    {
+        Span<byte> header = stackalloc byte[HeaderSize];
+        "RIFF"u8.CopyTo(header);
+        BitConverter.TryWriteBytes(header[4..], (uint)Math.Min(uint.MaxValue, samples + HeaderSize - 8));
+        "WAVEfmt "u8.CopyTo(header[8..]);
+        BitConverter.TryWriteBytes(header[16..], 16);               // fmt chunk size
+        BitConverter.TryWriteBytes(header[20..], (short)1);         // PCM
+        BitConverter.TryWriteBytes(header[22..], (short)1);         // mono
+        BitConverter.TryWriteBytes(header[24..], sampleFrequency);
+        BitConverter.TryWriteBytes(header[28..], sampleFrequency);  // byte rate
+        BitConverter.TryWriteBytes(header[32..], (short)1);         // block align
+        BitConverter.TryWriteBytes(header[34..], (short)8);         // bits per sample
+        "data"u8.CopyTo(header[36..]);
+        BitConverter.TryWriteBytes(header[40..], (uint)Math.Min(uint.MaxValue, samples));
+        stream.Write(header);
+    }
+}
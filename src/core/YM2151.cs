@@ -163,6 +163,9 @@ public sealed class YM2151
     #region Serialization Members
 
     public YM2151(DeserializationContext input, MachineBase m) : this(m)
+        => Restore(input);
+
+    public void Restore(DeserializationContext input)
     {
     }
 
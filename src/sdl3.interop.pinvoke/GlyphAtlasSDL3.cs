@@ -0,0 +1,204 @@
+﻿// © Mike Murphy
+
+using System;
+using System.Collections.Generic;
+
+using static EMU7800.SDL3.Interop.SDL3;
+
+namespace EMU7800.SDL3.Interop;
+
+/// <summary>
+/// A texture shared by all text layouts holding each glyph rasterized once in white, so text is
+/// drawn as colored quads collected into one batch and submitted with a single geometry call.
+/// </summary>
+public sealed class GlyphAtlasSDL3 : IDisposable
+{
+    #region Fields
+
+    const int AtlasSize = 1024, Padding = 1;
+
+    static readonly SDL_Color White = new() { r = 255, g = 255, b = 255, a = 255 };
+
+    readonly IntPtr _hRenderer;
+    IntPtr _texture;
+    readonly Dictionary<(IntPtr, uint), Glyph> _glyphs = [];
+    readonly Dictionary<(IntPtr, uint), int> _advances = [];
+
+    // Glyphs are packed left to right onto shelves as tall as their tallest glyph.
+    int _shelfX, _shelfY, _shelfHeight;
+
+    SDL_Vertex[] _vertices = new SDL_Vertex[4 * 256];
+    int[] _indices = new int[6 * 256];
+    int _quadCount;
+
+    #endregion
+
+    readonly record struct Glyph(float U0, float V0, float U1, float V1, int Width, int Height);
+
+    public int GetAdvance(IntPtr hFont, uint ch)
+    {
+        if (!_advances.TryGetValue((hFont, ch), out var advance))
+        {
+            if (!TTF_GetGlyphMetrics(hFont, ch, out _, out _, out _, out _, out advance))
+                advance = 0;
+            _advances.Add((hFont, ch), advance);
+        }
+        return advance;
+    }
+
+    public int GetKerning(IntPtr hFont, uint previousCh, uint ch)
+      => TTF_GetGlyphKerning(hFont, previousCh, ch, out var kerning) ? kerning : 0;
+
+    /// <summary>
+    /// Queues the glyphs of a layout; positions are relative to <paramref name="x"/>, <paramref name="y"/>.
+    /// </summary>
+    public void Add(IntPtr hFont, ReadOnlySpan<uint> chars, ReadOnlySpan<float> xs, ReadOnlySpan<float> ys, float x, float y, SDL_FColor color)
+    {
+        if (_texture == IntPtr.Zero)
+            return;
+
+        for (var i = 0; i < chars.Length; i++)
+        {
+            if (!TryGetGlyph(hFont, chars[i], out var glyph))
+            {
+                // Full: draw what refers to the current contents and start over.
+                Flush();
+                Clear();
+                if (!TryGetGlyph(hFont, chars[i], out glyph))
+                    continue;
+            }
+            if (glyph.Width == 0)
+                continue;
+            AddQuad(x + xs[i], y + ys[i], glyph, color);
+        }
+    }
+
+    public void Flush()
+    {
+        if (_quadCount == 0)
+            return;
+        SDL_RenderGeometry(_hRenderer, _texture, _vertices.AsSpan(0, 4 * _quadCount), 4 * _quadCount, _indices.AsSpan(0, 6 * _quadCount), 6 * _quadCount);
+        _quadCount = 0;
+    }
+
+    #region IDisposable Members
+
+    public void Dispose()
+    {
+        if (_texture != IntPtr.Zero)
+            SDL_DestroyTexture(_texture);
+        _texture = IntPtr.Zero;
+        _quadCount = 0;
+    }
+
+    #endregion
+
+    #region Constructors
+
+    public unsafe GlyphAtlasSDL3(IntPtr hRenderer)
+    {
+        _hRenderer = hRenderer;
+        _texture = (IntPtr)SDL_CreateTexture(_hRenderer, SDL_PixelFormat.SDL_PIXELFORMAT_ARGB8888, SDL_TextureAccess.SDL_TEXTUREACCESS_STATIC, AtlasSize, AtlasSize);
+        if (_texture == IntPtr.Zero)
+            return;
+        SDL_SetTextureBlendMode(_texture, SDL_BlendMode.SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(_texture, SDL_ScaleMode.SDL_SCALEMODE_NEAREST);
+        FillIndices(0);
+    }
+
+    #endregion
+
+    #region Helpers
+
+    void AddQuad(float x, float y, Glyph glyph, SDL_FColor color)
+    {
+        if (4 * (_quadCount + 1) > _vertices.Length)
+        {
+            Array.Resize(ref _vertices, 2 * _vertices.Length);
+            Array.Resize(ref _indices, 2 * _indices.Length);
+            FillIndices(_quadCount);
+        }
+
+        var v = _vertices.AsSpan(4 * _quadCount, 4);
+        float x1 = x + glyph.Width, y1 = y + glyph.Height;
+        v[0] = new() { position = new() { x = x,  y = y  }, color = color, tex_coord = new() { x = glyph.U0, y = glyph.V0 } };
+        v[1] = new() { position = new() { x = x1, y = y  }, color = color, tex_coord = new() { x = glyph.U1, y = glyph.V0 } };
+        v[2] = new() { position = new() { x = x,  y = y1 }, color = color, tex_coord = new() { x = glyph.U0, y = glyph.V1 } };
+        v[3] = new() { position = new() { x = x1, y = y1 }, color = color, tex_coord = new() { x = glyph.U1, y = glyph.V1 } };
+        _quadCount++;
+    }
+
+    void FillIndices(int fromQuad)
+    {
+        for (var q = fromQuad; q < _indices.Length / 6; q++)
+        {
+            var i = 6 * q;
+            var k = 4 * q;
+            _indices[i]     = k;
+            _indices[i + 1] = k + 1;
+            _indices[i + 2] = k + 2;
+            _indices[i + 3] = k + 2;
+            _indices[i + 4] = k + 1;
+            _indices[i + 5] = k + 3;
+        }
+    }
+
+    unsafe bool TryGetGlyph(IntPtr hFont, uint ch, out Glyph glyph)
+    {
+        if (_glyphs.TryGetValue((hFont, ch), out glyph))
+            return true;
+
+        var rendered = TTF_RenderGlyph_Blended(hFont, ch, White);
+        if (rendered == null)
+        {
+            _glyphs.Add((hFont, ch), glyph);
+            return true;
+        }
+
+        var surface = rendered->format == SDL_PixelFormat.SDL_PIXELFORMAT_ARGB8888 ? rendered : SDL_ConvertSurface((IntPtr)rendered, SDL_PixelFormat.SDL_PIXELFORMAT_ARGB8888);
+        try
+        {
+            if (surface == null || surface->w + Padding > AtlasSize || surface->h + Padding > AtlasSize)
+            {
+                _glyphs.Add((hFont, ch), glyph);
+                return true;
+            }
+
+            var w = surface->w;
+            var h = surface->h;
+            if (_shelfX + w > AtlasSize)
+            {
+                _shelfX = 0;
+                _shelfY += _shelfHeight + Padding;
+                _shelfHeight = 0;
+            }
+            if (_shelfY + h > AtlasSize)
+                return false;
+
+            var rect = new SDL_Rect { x = _shelfX, y = _shelfY, w = w, h = h };
+            SDL_UpdateTexture(_texture, ref rect, surface->pixels, surface->pitch);
+
+            const float Scale = 1f / AtlasSize;
+            glyph = new(rect.x * Scale, rect.y * Scale, (rect.x + w) * Scale, (rect.y + h) * Scale, w, h);
+            _glyphs.Add((hFont, ch), glyph);
+
+            _shelfX += w + Padding;
+            _shelfHeight = Math.Max(_shelfHeight, h);
+            return true;
+        }
+        finally
+        {
+            if (surface != null && surface != rendered)
+                SDL_DestroySurface((IntPtr)surface);
+            SDL_DestroySurface((IntPtr)rendered);
+        }
+    }
+
+    void Clear()
+    {
+        _glyphs.Clear();
+        _shelfX = _shelfY = _shelfHeight = 0;
+    }
+
+    #endregion
+}
\ No newline at end of file
@@ -13,10 +13,11 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 {
     readonly IntPtr hWnd, hRenderer;
     readonly uint _displayId;
-    readonly List<IDisposable> _disposables = [];
+    readonly DisposableResourceList _disposables = new();
     readonly Stack<SDL_Rect> _prevClips = [];
     readonly Dictionary<float, IntPtr> _cachedFonts = [];
     readonly ILogger _logger;
+    readonly GlyphAtlasSDL3? _glyphAtlas;
 
     public SizeU WindowSize { get; private set; }
     public float ScaleFactor { get; private set; } = 1f;
@@ -57,22 +58,28 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
             _cachedFonts.Add(fontSize, hFont);
         }
 
-        var textLayout = new TextSDL3Layout(hRenderer, hFont, text, width, height, paragraphAlignment, textAlignment, brush);
-        _disposables.Add(textLayout);
-        return textLayout;
+        // Layouts own no native resources; their glyphs live in the shared atlas.
+        return _glyphAtlas is null ? TextLayout.Empty : new TextSDL3Layout(_glyphAtlas, hFont, text, width, height, paragraphAlignment, textAlignment, brush);
     }
 
     public void Draw(DynamicBitmap bitmap, RectF rect, BitmapInterpolationMode interpolationMode)
-      => bitmap.Draw(rect, interpolationMode);
+    {
+        FlushText();
+        bitmap.Draw(rect, interpolationMode);
+    }
 
     public void Draw(StaticBitmap bitmap, RectF rect)
-      => bitmap.Draw(rect);
+    {
+        FlushText();
+        bitmap.Draw(rect);
+    }
 
     public void Draw(TextLayout textLayout, PointF location)
       => textLayout.Draw(location);
 
     public void DrawEllipse(RectF rect, float strokeWidth, SolidColorBrush brush)
     {
+        FlushText();
         ApplyBrush(brush);
         SDL_FRect r = rect;
         SDL_RenderRect(hRenderer, ref r);
@@ -80,12 +87,14 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 
     public void DrawLine(PointF dp0, PointF dp1, float strokeWidth, SolidColorBrush brush)
     {
+        FlushText();
         ApplyBrush(brush);
         SDL_RenderLine(hRenderer, dp0.X, dp0.Y, dp1.X, dp1.Y);
     }
 
     public void DrawRectangle(RectF rect, float strokeWidth, SolidColorBrush brush)
     {
+        FlushText();
         ApplyBrush(brush);
         SDL_FRect r = rect;
         SDL_RenderRect(hRenderer, ref r);
@@ -101,10 +110,14 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
     }
 
     public int EndDraw()
-      => SDL_RenderPresent(hRenderer) ? 0 : -1;
+    {
+        FlushText();
+        return SDL_RenderPresent(hRenderer) ? 0 : -1;
+    }
 
     public void FillEllipse(RectF rect, SolidColorBrush brush)
     {
+        FlushText();
         ApplyBrush(brush);
         SDL_FRect r = rect;
         SDL_RenderFillRect(hRenderer, ref r);
@@ -112,6 +125,7 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 
     public void FillRectangle(RectF rect, SolidColorBrush brush)
     {
+        FlushText();
         ApplyBrush(brush);
         SDL_FRect r = rect;
         SDL_RenderFillRect(hRenderer, ref r);
@@ -119,6 +133,7 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 
     public void PopAxisAlignedClip()
     {
+        FlushText();
         if (_prevClips.Count > 0)
         {
             _prevClips.Pop();
@@ -135,6 +150,7 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 
     public void PushAxisAlignedClip(RectF rect, AntiAliasMode antiAliasMode)
     {
+        FlushText();
         SetRenderClipRect(rect);
         _prevClips.Push(rect);
     }
@@ -151,11 +167,8 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 
     public void Shutdown()
     {
-        foreach (var disposable in _disposables)
-        {
-            disposable.Dispose();
-        }
-        _disposables.Clear();
+        _disposables.DisposeAll();
+        _glyphAtlas?.Dispose();
 
         foreach (var kvp in _cachedFonts)
         {
@@ -231,6 +244,8 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
             return;
         }
 
+        _glyphAtlas = new(hRenderer);
+
         ScaleFactor = SDL_GetWindowDisplayScale(hWnd);
 
         _logger.Log(3, $"SDL window display scale: {ScaleFactor}");
@@ -250,6 +265,11 @@ public sealed class GraphicsDeviceSDL3Driver : DisposableResource, IGraphicsDevi
 
     #endregion
 
+    // Text is queued in the glyph atlas batch, so it must be submitted before anything that
+    // draws over it or changes the clip.
+    void FlushText()
+      => _glyphAtlas?.Flush();
+
     void ApplyBrush(SolidColorBrush brush)
     {
         switch (brush)
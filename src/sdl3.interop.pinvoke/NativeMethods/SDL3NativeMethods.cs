@@ -338,6 +338,10 @@ public static unsafe partial class SDL3
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial void SDL_DestroySurface(IntPtr surface);
 
+    [LibraryImport(SDL3SharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDL_Surface* SDL_ConvertSurface(IntPtr surface, SDL_PixelFormat format);
+
     [LibraryImport(SDL3ImageSharedObjectName)]
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial SDL_Surface* IMG_LoadPNG_IO(IntPtr src, SDLBool closeio);
@@ -1928,6 +1932,21 @@ public static unsafe partial class SDL3
         SDL_LOGICAL_PRESENTATION_INTEGER_SCALE = 4,
     }
 
+    [Flags]
+    public enum SDL_BlendMode : uint
+    {
+        SDL_BLENDMODE_NONE  = 0x00000000,
+        SDL_BLENDMODE_BLEND = 0x00000001,
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SDL_Vertex
+    {
+        public SDL_FPoint position;
+        public SDL_FColor color;
+        public SDL_FPoint tex_coord;
+    }
+
     [StructLayout(LayoutKind.Sequential)]
     public struct SDL_Texture
     {
@@ -1957,6 +1976,14 @@ public static unsafe partial class SDL3
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial SDLBool SDL_UpdateTexture(IntPtr texture, IntPtr rect, ReadOnlySpan<byte> pixels, int pitch);
 
+    [LibraryImport(SDL3SharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDLBool SDL_UpdateTexture(IntPtr texture, ref SDL_Rect rect, IntPtr pixels, int pitch);
+
+    [LibraryImport(SDL3SharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDLBool SDL_SetTextureBlendMode(IntPtr texture, SDL_BlendMode blendMode);
+
     [LibraryImport(SDL3SharedObjectName)]
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial SDLBool SDL_SetRenderLogicalPresentation(IntPtr renderer, int w, int h, SDL_RendererLogicalPresentation mode);
@@ -1993,6 +2020,10 @@ public static unsafe partial class SDL3
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial SDLBool SDL_RenderTexture(IntPtr renderer, IntPtr texture, IntPtr srcrect, ref SDL_FRect dstrect);
 
+    [LibraryImport(SDL3SharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDLBool SDL_RenderGeometry(IntPtr renderer, IntPtr texture, ReadOnlySpan<SDL_Vertex> vertices, int num_vertices, ReadOnlySpan<int> indices, int num_indices);
+
     [LibraryImport(SDL3SharedObjectName)]
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial SDLBool SDL_RenderPresent(IntPtr renderer);
@@ -2090,4 +2121,24 @@ public static unsafe partial class SDL3
     [LibraryImport(SDL3TtfSharedObjectName, StringMarshalling = StringMarshalling.Utf8)]
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     internal static partial SDL_Surface* TTF_RenderText_Blended_Wrapped(IntPtr pFont, string text, UIntPtr length, SDL_Color fg, int wrap_width);
+
+    [LibraryImport(SDL3TtfSharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDL_Surface* TTF_RenderGlyph_Blended(IntPtr pFont, uint ch, SDL_Color fg);
+
+    [LibraryImport(SDL3TtfSharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDLBool TTF_GetGlyphMetrics(IntPtr pFont, uint ch, out int minx, out int maxx, out int miny, out int maxy, out int advance);
+
+    [LibraryImport(SDL3TtfSharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial SDLBool TTF_GetGlyphKerning(IntPtr pFont, uint previous_ch, uint ch, out int kerning);
+
+    [LibraryImport(SDL3TtfSharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial int TTF_GetFontHeight(IntPtr pFont);
+
+    [LibraryImport(SDL3TtfSharedObjectName)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    internal static partial int TTF_GetFontLineSkip(IntPtr pFont);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 using EMU7800.Shell;
 using System;
+using System.Collections.Generic;
+using System.Text;
 
 namespace EMU7800.SDL3.Interop;
 
@@ -9,79 +11,128 @@ using static EMU7800.SDL3.Interop.SDL3;
 
 public sealed class TextSDL3Layout : TextLayout
 {
-    readonly IntPtr _hRenderer, _texture;
-    readonly SDL_FRect _dstrect;
+    readonly GlyphAtlasSDL3? _glyphAtlas;
+    readonly IntPtr _hFont;
+    readonly uint[] _chars = [];
+    readonly float[] _xs = [], _ys = [];
+    readonly float _offsetX, _offsetY;
+    readonly SDL_FColor _color;
 
     public override void Draw(PointF location)
-    {
-        if (_hRenderer == IntPtr.Zero)
-            return;
-        SDL_FRect dstrect = _dstrect;
-        dstrect.x += location.X;
-        dstrect.y += location.Y;
-        SDL_RenderTexture(_hRenderer, _texture, IntPtr.Zero, ref dstrect);
-    }
-
-    #region IDispose Members
-
-    protected override void Dispose(bool disposing)
-    {
-        if (!_resourceDisposed)
-        {
-            if (_texture != IntPtr.Zero && HR == 0)
-                SDL_DestroyTexture(_texture);
-            _resourceDisposed = true;
-        }
-        base.Dispose(disposing);
-    }
-
-    #endregion
+      => _glyphAtlas?.Add(_hFont, _chars, _xs, _ys, location.X + _offsetX, location.Y + _offsetY, _color);
 
     #region Constructors
 
-    public unsafe TextSDL3Layout(IntPtr hRenderer, IntPtr hFont, string text, float width, float height, WriteParaAlignment paragraphAlignment, WriteTextAlignment textAlignment, SolidColorBrush brush)
+    public TextSDL3Layout(GlyphAtlasSDL3 glyphAtlas, IntPtr hFont, string text, float width, float height, WriteParaAlignment paragraphAlignment, WriteTextAlignment textAlignment, SolidColorBrush brush)
     {
-        if (string.IsNullOrEmpty(text) || hRenderer == IntPtr.Zero || hFont == IntPtr.Zero)
+        if (string.IsNullOrEmpty(text) || hFont == IntPtr.Zero)
             return;
 
-        _hRenderer = hRenderer;
+        _glyphAtlas = glyphAtlas;
+        _hFont = hFont;
+        _color = ToSDLFColor(ToSDLColor(brush));
 
-        var surface = (IntPtr)TTF_RenderText_Blended_Wrapped(hFont, text, 0, ToSDLColor(brush), (int)width);
-        var texture = SDL_CreateTextureFromSurface(_hRenderer, surface);
+        var chars = new List<uint>(text.Length);
+        foreach (var rune in text.EnumerateRunes())
+            chars.Add((uint)rune.Value);
 
-        _texture = (IntPtr)texture;
+        var lines = WrapLines(chars, (int)width);
 
-        HR = _texture != IntPtr.Zero ? 0 : -1;
+        var drawnChars = new List<uint>(chars.Count);
+        var xs = new List<float>(chars.Count);
+        var ys = new List<float>(chars.Count);
+        var lineSkip = TTF_GetFontLineSkip(hFont);
+        var textWidth = 0;
 
-        if (HR == 0)
+        for (var line = 0; line < lines.Count; line++)
         {
-            SDL_SetTextureScaleMode(_texture, SDL_ScaleMode.SDL_SCALEMODE_NEAREST);
+            var (start, end) = lines[line];
+            var x = 0;
+            for (var i = start; i < end; i++)
+            {
+                var ch = chars[i];
+                if (i > start)
+                    x += _glyphAtlas.GetKerning(hFont, chars[i - 1], ch);
+                if (!Rune.IsWhiteSpace(new Rune(ch)))
+                {
+                    drawnChars.Add(ch);
+                    xs.Add(x);
+                    ys.Add(line * lineSkip);
+                }
+                x += _glyphAtlas.GetAdvance(hFont, ch);
+            }
+            textWidth = Math.Max(textWidth, x);
         }
 
-        SDL_DestroySurface(surface);
+        _chars = [.. drawnChars];
+        _xs = [.. xs];
+        _ys = [.. ys];
+
+        var textHeight = TTF_GetFontHeight(hFont) + (lines.Count - 1) * lineSkip;
 
-        _dstrect.x = textAlignment switch
+        _offsetX = textAlignment switch
         {
             WriteTextAlignment.Leading  => 0,
-            WriteTextAlignment.Center   => (width - texture->w) / 2,
-            WriteTextAlignment.Trailing => width - texture->w,
+            WriteTextAlignment.Center   => (width - textWidth) / 2,
+            WriteTextAlignment.Trailing => width - textWidth,
             _ => 0
          };
-        _dstrect.y = paragraphAlignment switch
+        _offsetY = paragraphAlignment switch
         {
             WriteParaAlignment.Near     => 0,
-            WriteParaAlignment.Center   => (height - texture->h) / 2,
-            WriteParaAlignment.Far      => height - texture->h,
+            WriteParaAlignment.Center   => (height - textHeight) / 2,
+            WriteParaAlignment.Far      => height - textHeight,
             _ => 0
         };
-        _dstrect.w = texture->w;
-        _dstrect.h = texture->h;
 
-        Size = new SizeF(_dstrect.w, _dstrect.h);
+        Size = new SizeF(textWidth, textHeight);
     }
 
     #endregion
 
+    /// <summary>
+    /// Breaks text into lines no wider than <paramref name="wrapWidth"/> at spaces where possible,
+    /// otherwise between characters, and at explicit newlines.
+    /// </summary>
+    List<(int Start, int End)> WrapLines(List<uint> chars, int wrapWidth)
+    {
+        var lines = new List<(int, int)>();
+        int start = 0, lineWidth = 0, lastSpace = -1;
+
+        for (var i = 0; i < chars.Count; i++)
+        {
+            var ch = chars[i];
+            if (ch == '\n')
+            {
+                lines.Add((start, i));
+                start = i + 1;
+                lineWidth = 0;
+                lastSpace = -1;
+                continue;
+            }
+            if (ch == ' ')
+                lastSpace = i;
+
+            lineWidth += _glyphAtlas!.GetAdvance(_hFont, ch);
+            if (wrapWidth <= 0 || lineWidth <= wrapWidth || i == start || ch == ' ')
+                continue;
+
+            var breakAtSpace = lastSpace > start;
+            lines.Add((start, breakAtSpace ? lastSpace : i));
+            start = breakAtSpace ? lastSpace + 1 : i;
+            lastSpace = -1;
+            lineWidth = 0;
+            for (var j = start; j <= i; j++)
+                lineWidth += _glyphAtlas.GetAdvance(_hFont, chars[j]);
+        }
+
+        lines.Add((start, chars.Count));
+        return lines;
+    }
+
+    static SDL_FColor ToSDLFColor(SDL_Color color)
+      => new() { r = color.r / 255f, g = color.g / 255f, b = color.b / 255f, a = color.a / 255f };
+
     static SDL_Color ToSDLColor(SolidColorBrush brush)
       => brush switch
       {
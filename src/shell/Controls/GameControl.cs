@@ -24,8 +24,11 @@ public sealed class GameControl : ControlBase
     IFrameRenderer _frameRenderer = new FrameRendererDefault();
     BitmapInterpolationMode _dynamicBitmapInterpolationMode = BitmapInterpolationMode.NearestNeighbor;
     DynamicBitmap _dynamicBitmap = DynamicBitmap.Empty;
+    VideoFilter? _videoFilter;
+    VideoFilterMode _videoFilterModeApplied;
     RectF _dynamicBitmapRect;
     bool _dynamicBitmapDataUpdated;
+    long _dynamicBitmapInputTimestamp;
 
     static readonly InputState _defaultInputState = new();
     InputState _inputState = _defaultInputState;
@@ -39,6 +42,11 @@ public sealed class GameControl : ControlBase
     Task _workerTask = Task.CompletedTask;
     bool _stopRequested;
 
+    ImportedGameProgramInfo? _runGameProgramInfo;
+    MachineFactory? _runMachineFactory;
+    NetplayInfo? _runNetplay;
+    bool _runStartFresh;
+
     bool _calibrationNeeded, _calibrating, _frameRateChangeNeeded;
     readonly uint[] _frameDurationBuckets = new uint[0x100];
     readonly long _stopwatchFrequencyInMilliseconds = Stopwatch.Frequency / 1000;
@@ -47,6 +55,11 @@ public sealed class GameControl : ControlBase
 
     volatile IAudioDeviceDriver _audioDevice = EmptyAudioDeviceDriver.Default;
 
+    int _inputLatencySamples;
+    double _inputLatencyTotalMilliseconds;
+
+    static bool _startupTimeLogged;
+
     #endregion
 
     public bool IsGameBWConsoleSwitchSet => _inputState.IsGameBWConsoleSwitchSet;
@@ -89,10 +102,40 @@ public sealed class GameControl : ControlBase
             : BitmapInterpolationMode.NearestNeighbor;
     }
 
+    /// <summary>
+    /// Post-processing applied to frames when rendered. Reverts to None when the filter cannot be created.
+    /// </summary>
+    public VideoFilterMode VideoFilterMode { get; set; }
+
     public int CurrentFrameRate { get; private set; }
 
+    /// <summary>
+    /// Interval between background saves of the running machine; zero disables autosave.
+    /// </summary>
+    public int AutosaveIntervalSeconds { get; set; }
+
+    /// <summary>
+    /// When set, subsequently started games are played against a remote site.
+    /// Netplay games always start fresh, cannot be paused locally, and are not persisted.
+    /// </summary>
+    public NetplayInfo? Netplay { get; set; }
+
+    /// <summary>
+    /// While set, the running game's video and audio are recorded to the captures folder.
+    /// Cleared when the capture cannot be started.
+    /// </summary>
+    public bool IsCapturing { get; set; }
+
     public float FrameIdleTime { get; private set; }
 
+    /// <summary>
+    /// Time from the most recent input event being raised until the first frame reflecting it was drawn.
+    /// Presentation (vsync) delay of the graphics device is not included.
+    /// </summary>
+    public double InputLatencyMilliseconds { get; private set; }
+
+    public double MaxInputLatencyMilliseconds { get; private set; }
+
     public int BuffersQueued { get; private set; }
 
     public static int MinFramesPerSecond => 4;
@@ -117,10 +160,15 @@ public sealed class GameControl : ControlBase
         _stopRequested = false;
         _dynamicBitmapData.Span.Clear();
 
-        var machineFactory = new MachineFactory(DatastoreService, specialBinaries, Logger);
+        _runGameProgramInfo = importedGameProgramInfo;
+        _runMachineFactory = new MachineFactory(DatastoreService, specialBinaries, Logger);
+        _runNetplay = Netplay;
+        _runStartFresh = startFresh || Netplay is not null;
 
-        var state = Tuple.Create(importedGameProgramInfo, machineFactory, startFresh);
-        _workerTask = Task.Factory.StartNew(Run, state, TaskCreationOptions.LongRunning);
+        _inputLatencySamples = 0;
+        _inputLatencyTotalMilliseconds = InputLatencyMilliseconds = MaxInputLatencyMilliseconds = 0;
+
+        _workerTask = Task.Factory.StartNew(Run, TaskCreationOptions.LongRunning);
     }
 
     public void StartSnow()
@@ -144,6 +192,11 @@ public sealed class GameControl : ControlBase
         {
         }
         SafeDispose(ref _dynamicBitmap);
+
+        if (_inputLatencySamples > 0)
+        {
+            Logger.Log(3, $"Input latency: {_inputLatencySamples} samples, average {_inputLatencyTotalMilliseconds / _inputLatencySamples:0.0}ms, maximum {MaxInputLatencyMilliseconds:0.0}ms");
+        }
     }
 
     public void SwitchToDarkerPalette()
@@ -273,21 +326,52 @@ public sealed class GameControl : ControlBase
 
     public override void Render(IGraphicsDeviceDriver graphicsDevice)
     {
+        if (VideoFilterMode != _videoFilterModeApplied)
+        {
+            _videoFilter?.Dispose();
+            _videoFilter = VideoFilter.TryCreate(VideoFilterMode, _dynamicBitmapDataSize, Logger);
+            VideoFilterMode = _videoFilterModeApplied = _videoFilter?.Mode ?? VideoFilterMode.None;
+            SafeDispose(ref _dynamicBitmap);
+        }
+
+        long inputTimestamp;
+        ReadOnlySpan<byte> filteredData = [];
         lock (_dynamicBitmapLocker)
         {
+            var load = _dynamicBitmapDataUpdated;
             if (_dynamicBitmap == DynamicBitmap.Empty)
             {
-                _dynamicBitmap = graphicsDevice.CreateDynamicBitmap(_dynamicBitmapDataSize);
-                _dynamicBitmap.Load(_dynamicBitmapData.Span);
+                _dynamicBitmap = graphicsDevice.CreateDynamicBitmap(_videoFilter?.OutputSize ?? _dynamicBitmapDataSize);
+                load = true;
             }
-            else if (_dynamicBitmapDataUpdated)
+            if (load)
             {
-                _dynamicBitmap.Load(_dynamicBitmapData.Span);
+                // The filtered frame is private to this thread, so it is uploaded after the emulator is released.
+                if (_videoFilter is null)
+                    _dynamicBitmap.Load(_dynamicBitmapData.Span);
+                else
+                    filteredData = _videoFilter.Apply(_dynamicBitmapData.Span, (int)_dynamicBitmapDataSize.Width << 2);
             }
             _dynamicBitmapDataUpdated = false;
+            inputTimestamp = _dynamicBitmapInputTimestamp;
+            _dynamicBitmapInputTimestamp = 0;
+        }
+
+        if (!filteredData.IsEmpty)
+        {
+            _dynamicBitmap.Load(filteredData);
         }
 
         graphicsDevice.Draw(_dynamicBitmap, _dynamicBitmapRect, _dynamicBitmapInterpolationMode);
+
+        if (inputTimestamp != 0)
+        {
+            var latency = Stopwatch.GetElapsedTime(inputTimestamp).TotalMilliseconds;
+            InputLatencyMilliseconds = latency;
+            MaxInputLatencyMilliseconds = Math.Max(MaxInputLatencyMilliseconds, latency);
+            _inputLatencyTotalMilliseconds += latency;
+            _inputLatencySamples++;
+        }
     }
 
     protected override void Dispose(bool disposing)
@@ -302,6 +386,9 @@ public sealed class GameControl : ControlBase
     protected override void DisposeResources()
     {
         SafeDispose(ref _dynamicBitmap);
+        _videoFilter?.Dispose();
+        _videoFilter = null;
+        _videoFilterModeApplied = VideoFilterMode.None;
         base.DisposeResources();
     }
 
@@ -309,14 +396,18 @@ public sealed class GameControl : ControlBase
 
     #region Worker
 
-    void Run(object? state)
+    void Run()
     {
-        if (state is not Tuple<ImportedGameProgramInfo, MachineFactory, bool> typedState)
+        if (_runGameProgramInfo is not { } importedGameProgramInfo || _runMachineFactory is not { } machineFactory)
         {
             return;
         }
 
-        var (importedGameProgramInfo, machineFactory, startFresh) = typedState;
+        var startFresh = _runStartFresh;
+        var netplay = _runNetplay;
+        _runGameProgramInfo = null;
+        _runMachineFactory = null;
+        _runNetplay = null;
 
         var machineStateInfo = MachineStateInfo.Default;
 
@@ -347,14 +438,33 @@ public sealed class GameControl : ControlBase
 
         _dynamicBitmapInterpolationMode = (BitmapInterpolationMode)machineStateInfo.InterpolationMode;
 
-        _currentKeyboardPlayerNo = machineStateInfo.CurrentPlayerNo - 1;
-        _inputState = machine.InputState;
+        RollbackSession? session = null;
+        if (netplay is not null)
+        {
+            try
+            {
+                session = new(machine, new(netplay.LocalPort, netplay.RemoteEndPoint), netplay.LocalJack, RollbackSession.DefaultMaxPredictionFrames, Logger);
+            }
+            catch (System.Net.Sockets.SocketException ex)
+            {
+                Logger.Log(1, $"Netplay: unable to use UDP port {netplay.LocalPort}: {ex.Message}");
+                _stopRequested = true;
+                return;
+            }
+        }
+
+        _currentKeyboardPlayerNo = session is null ? machineStateInfo.CurrentPlayerNo - 1 : session.LocalJack;
+        // Input is raised on the UI thread; queue it so the machine latches it when it next reads its controllers.
+        var inputState = session is null ? machine.InputState : session.LocalInputState;
+        inputState.EnableInputEventQueue();
+        System.Threading.Volatile.Write(ref _inputState, inputState);
 
         _inputAdapters[0] = ToInputAdapter(machineStateInfo, 0);
         _inputAdapters[1] = ToInputAdapter(machineStateInfo, 1);
 
-        _jackSwaps[0] = 0;
-        _jackSwaps[1] = 1;
+        // In netplay, the first game controller drives the local site's jack.
+        _jackSwaps[0] = session?.LocalJack ?? 0;
+        _jackSwaps[1] = _jackSwaps[0] ^ 1;
         _paddleSwaps[0] = 0;
         _paddleSwaps[1] = 1;
         _paddleSwaps[2] = 0;
@@ -369,11 +479,25 @@ public sealed class GameControl : ControlBase
         stopwatch.Start();
 
         long ticksPerFrame = 0;
+        var lastAutosaveTick = stopwatch.ElapsedTicks;
 
         var audio = new AudioDevice(_audioDevice);
+        CaptureRecorder? capture = null;
 
         while (!_stopRequested)
         {
+            if (IsCapturing && capture is null)
+            {
+                capture = DatastoreService.StartCapture(machine, machineStateInfo.GameProgramInfo);
+                IsCapturing = capture is not null;
+            }
+            else if (!IsCapturing && capture is not null)
+            {
+                // Draining the encoder can take a moment; keep it off the emulation thread.
+                _ = Task.Run(capture.Dispose);
+                capture = null;
+            }
+
             var startTick = stopwatch.ElapsedTicks;
             var endTick = startTick + ticksPerFrame;
 
@@ -433,18 +557,48 @@ public sealed class GameControl : ControlBase
                 _   =>  0
             });
 
-            if (!IsPaused)
-                machine.ComputeNextFrame();
+            bool frameComputed;
+            if (session is not null)
+            {
+                frameComputed = session.AdvanceFrame();
+                if (session.FrameAdvantage >= 1)
+                {
+                    // Running ahead of the remote site; give it a chance to catch up.
+                    endTick += ticksPerFrame >> 3;
+                }
+            }
+            else
+            {
+                frameComputed = !IsPaused;
+                if (frameComputed)
+                    machine.ComputeNextFrame();
+                else
+                    machine.InputState.DrainInputEvents();
+            }
 
-            if (IsSoundOn && !IsPaused)
+            if (IsSoundOn && frameComputed)
             {
                 audio.SubmitBuffer(machine.FrameBuffer.SoundBuffer.Span);
             }
 
+            if (frameComputed)
+            {
+                capture?.Record(machine.FrameBuffer);
+                if (!_startupTimeLogged)
+                {
+                    _startupTimeLogged = true;
+                    LogStartupTime();
+                }
+            }
+
             lock (_dynamicBitmapLocker)
             {
                 _frameRenderer.UpdateDynamicBitmapData(_currentPalette.Span, machine.FrameBuffer.VideoBuffer.Span, _dynamicBitmapData.Span);
                 _dynamicBitmapDataUpdated = true;
+                // Input applied while paused is not reflected until later, so it is not timed.
+                var inputTimestamp = _inputState.TakeLatchedInputTimestamp();
+                if (frameComputed && _dynamicBitmapInputTimestamp == 0)
+                    _dynamicBitmapInputTimestamp = inputTimestamp;
             }
 
             var elaspedTicks = stopwatch.ElapsedTicks;
@@ -459,6 +613,12 @@ public sealed class GameControl : ControlBase
             FrameIdleTime = (float)(endTick - elaspedTicks) / ticksPerFrame;
             BuffersQueued = buffersQueued;
 
+            if (AutosaveIntervalSeconds > 0 && session is null && !IsPaused && elaspedTicks - lastAutosaveTick >= AutosaveIntervalSeconds * Stopwatch.Frequency)
+            {
+                lastAutosaveTick = elaspedTicks;
+                DatastoreService.PersistMachine(ToPersistedMachineStateInfo(machineStateInfo), _dynamicBitmapData);
+            }
+
             while (stopwatch.ElapsedTicks < endTick)
             {
                 Task.Yield();
@@ -466,17 +626,27 @@ public sealed class GameControl : ControlBase
         }
 
         audio.Close();
+        capture?.Dispose();
+        IsCapturing = false;
 
-        machineStateInfo = machineStateInfo with
+        if (session is not null)
+        {
+            Logger.Log(3, $"{session}");
+            session.Dispose();
+            return;
+        }
+
+        DatastoreService.PersistMachine(ToPersistedMachineStateInfo(machineStateInfo), _dynamicBitmapData);
+    }
+
+    MachineStateInfo ToPersistedMachineStateInfo(MachineStateInfo machineStateInfo)
+        => machineStateInfo with
         {
             CurrentPlayerNo   = _currentKeyboardPlayerNo + 1,
             InterpolationMode = (int)_dynamicBitmapInterpolationMode,
             SoundOff          = !IsSoundOn
         };
 
-        DatastoreService.PersistMachine(machineStateInfo, _dynamicBitmapData);
-    }
-
     void RunSnow()
     {
         var random = new Random();
@@ -556,6 +726,19 @@ public sealed class GameControl : ControlBase
         return inputAdapter;
     }
 
+    // Measures startup as the time from process start to the first emulated frame, once per process.
+    void LogStartupTime()
+    {
+        try
+        {
+            var startupTime = DateTime.Now - Process.GetCurrentProcess().StartTime;
+            Logger.Log(3, $"Startup: first emulated frame {startupTime.TotalMilliseconds:0.0}ms after process start");
+        }
+        catch (Exception ex) when (ex is PlatformNotSupportedException or InvalidOperationException)
+        {
+        }
+    }
+
     void InitializePalettes(ReadOnlyMemory<uint> sourcePalette)
     {
         _normalPalette = sourcePalette;
@@ -33,6 +33,10 @@ public sealed class GameProgramSelectionControl : ControlBase
         GapForCollectionTitle = 50f,
         GapBetweenCollections = 50f;
 
+    // Items keep their text layouts while among the most recently drawn, so short scrolls back
+    // and forth reuse them while the total held stays bounded regardless of library size.
+    const int MinCachedTextLayoutItems = 256;
+
     readonly SizeF _itemSize = new(ITEM_WIDTH, ITEM_HEIGHT);
     readonly SizeF _iconSize = new(ICON_WIDTH, ICON_HEIGHT);
 
@@ -47,6 +51,8 @@ public sealed class GameProgramSelectionControl : ControlBase
     int _focusCandidateCollectionIndex, _focusCandidateCollectionItemIndex;
 
     readonly ScrollColumnInfo[] _scrollColumnInfoSet;
+    readonly List<(int, int)> _visibleItems = [];
+    readonly LinkedList<GameProgramInfoViewItemEx> _textLayoutCache = [];
     RectF _gameProgramViewItemCollectionsRect;
     RectF _clipRect;
 
@@ -278,90 +284,96 @@ public sealed class GameProgramSelectionControl : ControlBase
         _focusCandidateCollectionIndex = -1;
         _focusCandidateCollectionItemIndex = -1;
 
+        // Only columns and items within the control are visited; text layouts are created as
+        // items scroll into view and released as they fall out of the recently drawn list.
+        _visibleItems.Clear();
         for (var i = 0; i < _scrollColumnInfoSet.Length; i++)
         {
+            var columnRect = ToItemRect(i, 0);
+            TranslateRect(ref columnRect, i);
+            if (columnRect.Right < Location.X || columnRect.Left > Location.X + Size.Width)
+                continue;
+
             var gpivic = _scrollColumnInfoSet[i].GameProgramInfoViewItemCollection;
-            for (var j = 0; j < gpivic.GameProgramInfoViewItems.Length; j++)
+            if (gpivic.GameProgramInfoViewItems.Length == 0)
+                continue;
+            if (gpivic.NameTextLayout == TextLayout.Empty)
+                gpivic.NameTextLayout = graphicsDevice.CreateTextLayout(Styles.LargeFontFamily, Styles.LargeFontSize, gpivic.Name, ITEM_WIDTH, ITEM_HEIGHT, WriteParaAlignment.Near, WriteTextAlignment.Leading, SolidColorBrush.White);
+            graphicsDevice.Draw(
+                gpivic.NameTextLayout,
+                new(columnRect.Left, Location.Y + ITEM_HEIGHT / 2 - gpivic.NameTextLayout.Height));
+
+            var firstVisible = Math.Max(0, (int)((Location.Y - columnRect.Top) / ITEM_HEIGHT) - 1);
+            for (var j = firstVisible; j < gpivic.GameProgramInfoViewItems.Length; j++)
             {
                 var itemRect = ToItemRect(i, j);
                 TranslateRect(ref itemRect, i);
-
-                if (j == 0)
-                {
-                    if (gpivic.NameTextLayout == TextLayout.Empty)
-                        gpivic.NameTextLayout = graphicsDevice.CreateTextLayout(Styles.LargeFontFamily, Styles.LargeFontSize, gpivic.Name, ITEM_WIDTH, ITEM_HEIGHT, WriteParaAlignment.Near, WriteTextAlignment.Leading, SolidColorBrush.White);
-                    graphicsDevice.Draw(
-                        gpivic.NameTextLayout,
-                        new(itemRect.Left, Location.Y + ITEM_HEIGHT / 2 - gpivic.NameTextLayout.Height));
-                }
-
-                if (itemRect.Right < Location.X || itemRect.Left > Location.X + Size.Width
-                ||  itemRect.Top > Location.Y + GapForCollectionTitle + Size.Height)
+                if (itemRect.Top > Location.Y + GapForCollectionTitle + Size.Height)
                     break;
                 if (itemRect.Bottom < Location.Y)
                     continue;
+                _visibleItems.Add((i, j));
+            }
+        }
 
-                graphicsDevice.PushAxisAlignedClip(_clipRect, AntiAliasMode.Aliased);
+        if (_visibleItems.Count == 0)
+            return;
 
-                var iconRect = ToIconRect(i, j);
-                TranslateRect(ref iconRect, i);
+        graphicsDevice.PushAxisAlignedClip(_clipRect, AntiAliasMode.Aliased);
 
-                var isIconRectVisible =
-                       iconRect.Left   >= Location.X
-                    && iconRect.Right  <  Location.X + Size.Width
-                    && iconRect.Top    >= Location.Y + GapForCollectionTitle
-                    && iconRect.Bottom <  Location.Y + Size.Height;
+        // Icons first, then all text, so drivers can batch the text of every visible item.
+        foreach (var (i, j) in _visibleItems)
+        {
+            var iconRect = ToIconRect(i, j);
+            TranslateRect(ref iconRect, i);
 
-                if (_focusCandidateCollectionIndex < 0 && isIconRectVisible)
-                {
-                    _focusCandidateCollectionIndex = i;
-                    _focusCandidateCollectionItemIndex = j;
-                }
+            var isIconRectVisible =
+                   iconRect.Left   >= Location.X
+                && iconRect.Right  <  Location.X + Size.Width
+                && iconRect.Top    >= Location.Y + GapForCollectionTitle
+                && iconRect.Bottom <  Location.Y + Size.Height;
 
-                var gpivi = gpivic.GameProgramInfoViewItems[j];
+            if (_focusCandidateCollectionIndex < 0 && isIconRectVisible)
+            {
+                _focusCandidateCollectionIndex = i;
+                _focusCandidateCollectionItemIndex = j;
+            }
 
-                if (gpivi.TitleTextLayout == TextLayout.Empty)
-                    gpivi.TitleTextLayout = graphicsDevice.CreateTextLayout(Styles.NormalFontFamily, Styles.NormalFontSize, gpivi.Title, ITEM_WIDTH - 25, ITEM_HEIGHT, WriteParaAlignment.Near, WriteTextAlignment.Leading, SolidColorBrush.White);
-                if (gpivi.SubTitleTextLayout == TextLayout.Empty)
-                    gpivi.SubTitleTextLayout = graphicsDevice.CreateTextLayout(Styles.SmallFontFamily, Styles.SmallFontSize, gpivi.SubTitle, ITEM_WIDTH - 25, ITEM_HEIGHT, WriteParaAlignment.Near, WriteTextAlignment.Leading, SolidColorBrush.Gray);
+            var gpivi = _scrollColumnInfoSet[i].GameProgramInfoViewItemCollection.GameProgramInfoViewItems[j];
+            var isFocused = i == _focusedCollectionIndex && j == _focusedCollectionItemIndex;
 
-                var itemRectHeight = itemRect.Bottom - itemRect.Top;
-                var totalTextHeight = gpivi.TitleTextLayout.Height + gpivi.SubTitleTextLayout.Height;
-                var textYStart = itemRect.Top + itemRectHeight / 2 - totalTextHeight / 2;
-                PointF textTitleLocation = new(itemRect.Left + 64, textYStart);
-                PointF textSubTitleLocation = new(itemRect.Left + 64, textYStart + gpivi.TitleTextLayout.Height);
+            if (isFocused && _itemDown)
+            {
+                var bitmap = gpivi.ImportedGameProgramInfo.PersistedStateExists ? _pauseRestInverted : _playRestInverted;
+                graphicsDevice.FillRectangle(iconRect, SolidColorBrush.White);
+                graphicsDevice.Draw(bitmap, iconRect);
+            }
+            else
+            {
+                var bitmap = gpivi.ImportedGameProgramInfo.PersistedStateExists ? _pauseRest : _playRest;
+                graphicsDevice.Draw(bitmap, iconRect);
+                graphicsDevice.DrawRectangle(iconRect, isFocused ? 5.0f : 1.0f, SolidColorBrush.White);
+            }
+        }
 
-                if (i == _focusedCollectionIndex && j == _focusedCollectionItemIndex)
-                {
-                    if (_itemDown)
-                    {
-                        var bitmap = gpivi.ImportedGameProgramInfo.PersistedStateExists ? _pauseRestInverted : _playRestInverted;
-                        graphicsDevice.FillRectangle(iconRect, SolidColorBrush.White);
-                        graphicsDevice.Draw(bitmap, iconRect);
-                        graphicsDevice.Draw(gpivi.TitleTextLayout, textTitleLocation);
-                        graphicsDevice.Draw(gpivi.SubTitleTextLayout, textSubTitleLocation);
-                    }
-                    else
-                    {
-                        var bitmap = gpivi.ImportedGameProgramInfo.PersistedStateExists ? _pauseRest : _playRest;
-                        graphicsDevice.Draw(bitmap, iconRect);
-                        graphicsDevice.Draw(gpivi.TitleTextLayout, textTitleLocation);
-                        graphicsDevice.Draw(gpivi.SubTitleTextLayout, textSubTitleLocation);
-                        graphicsDevice.DrawRectangle(iconRect, 5.0f, SolidColorBrush.White);
-                    }
-                }
-                else
-                {
-                    var bitmap = gpivi.ImportedGameProgramInfo.PersistedStateExists ? _pauseRest : _playRest;
-                    graphicsDevice.Draw(bitmap, iconRect);
-                    graphicsDevice.Draw(gpivi.TitleTextLayout, textTitleLocation);
-                    graphicsDevice.Draw(gpivi.SubTitleTextLayout, textSubTitleLocation);
-                    graphicsDevice.DrawRectangle(iconRect, 1.0f, SolidColorBrush.White);
-                }
+        foreach (var (i, j) in _visibleItems)
+        {
+            var itemRect = ToItemRect(i, j);
+            TranslateRect(ref itemRect, i);
 
-                graphicsDevice.PopAxisAlignedClip();
-            }
+            var gpivi = _scrollColumnInfoSet[i].GameProgramInfoViewItemCollection.GameProgramInfoViewItems[j];
+            EnsureTextLayouts(graphicsDevice, gpivi);
+
+            var itemRectHeight = itemRect.Bottom - itemRect.Top;
+            var totalTextHeight = gpivi.TitleTextLayout.Height + gpivi.SubTitleTextLayout.Height;
+            var textYStart = itemRect.Top + itemRectHeight / 2 - totalTextHeight / 2;
+            graphicsDevice.Draw(gpivi.TitleTextLayout, new(itemRect.Left + 64, textYStart));
+            graphicsDevice.Draw(gpivi.SubTitleTextLayout, new(itemRect.Left + 64, textYStart + gpivi.TitleTextLayout.Height));
         }
+
+        graphicsDevice.PopAxisAlignedClip();
+
+        EvictTextLayouts(Math.Max(MinCachedTextLayoutItems, 2 * _visibleItems.Count));
     }
 
     protected override async void CreateResources(IGraphicsDeviceDriver graphicsDevice)
@@ -392,19 +404,8 @@ public sealed class GameProgramSelectionControl : ControlBase
             if (ntl != TextLayout.Empty)
                 ntl.Dispose();
             sci.GameProgramInfoViewItemCollection.NameTextLayout = TextLayout.Empty;
-
-            foreach (var gpivi in sci.GameProgramInfoViewItemCollection.GameProgramInfoViewItems)
-            {
-                var ttl = gpivi.TitleTextLayout;
-                var sttl = gpivi.SubTitleTextLayout;
-                if (ttl != TextLayout.Empty)
-                    ttl.Dispose();
-                if (sttl != TextLayout.Empty)
-                    sttl.Dispose();
-                gpivi.TitleTextLayout = TextLayout.Empty;
-                gpivi.SubTitleTextLayout = TextLayout.Empty;
-            }
         }
+        EvictTextLayouts(0);
 
         base.DisposeResources();
     }
@@ -482,6 +483,36 @@ public sealed class GameProgramSelectionControl : ControlBase
         }
     }
 
+    void EnsureTextLayouts(IGraphicsDeviceDriver graphicsDevice, GameProgramInfoViewItemEx gpivi)
+    {
+        if (gpivi.TextLayoutCacheNode is { } node)
+        {
+            _textLayoutCache.Remove(node);
+            _textLayoutCache.AddFirst(node);
+            return;
+        }
+
+        gpivi.TitleTextLayout = graphicsDevice.CreateTextLayout(Styles.NormalFontFamily, Styles.NormalFontSize, gpivi.Title, ITEM_WIDTH - 25, ITEM_HEIGHT, WriteParaAlignment.Near, WriteTextAlignment.Leading, SolidColorBrush.White);
+        gpivi.SubTitleTextLayout = graphicsDevice.CreateTextLayout(Styles.SmallFontFamily, Styles.SmallFontSize, gpivi.SubTitle, ITEM_WIDTH - 25, ITEM_HEIGHT, WriteParaAlignment.Near, WriteTextAlignment.Leading, SolidColorBrush.Gray);
+        gpivi.TextLayoutCacheNode = _textLayoutCache.AddFirst(gpivi);
+    }
+
+    void EvictTextLayouts(int capacity)
+    {
+        while (_textLayoutCache.Count > capacity && _textLayoutCache.Last is { } node)
+        {
+            var gpivi = node.Value;
+            _textLayoutCache.RemoveLast();
+            gpivi.TextLayoutCacheNode = null;
+            if (gpivi.TitleTextLayout != TextLayout.Empty)
+                gpivi.TitleTextLayout.Dispose();
+            if (gpivi.SubTitleTextLayout != TextLayout.Empty)
+                gpivi.SubTitleTextLayout.Dispose();
+            gpivi.TitleTextLayout = TextLayout.Empty;
+            gpivi.SubTitleTextLayout = TextLayout.Empty;
+        }
+    }
+
     void RaiseSelected()
     {
         if (Selected == DefaultEventHandler || !IsFocusSet)
@@ -5,3 +5,4 @@ public enum AntiAliasMode { PerPrimitive, Aliased }
 public enum BitmapInterpolationMode { NearestNeighbor, Linear }
 public enum WriteTextAlignment { Leading, Trailing, Center }
 public enum WriteParaAlignment { Near, Far, Center }
+public enum VideoFilterMode { None, Scale2x, HQ2x, Scanlines, CRT, NTSC }
@@ -1,6 +1,7 @@
 ﻿// © Mike Murphy
 
 using EMU7800.Services.Dto;
+using System.Collections.Generic;
 
 namespace EMU7800.Shell;
 
@@ -8,4 +9,9 @@ public record GameProgramInfoViewItemEx(string Title, string SubTitle, ImportedG
 {
     public TextLayout TitleTextLayout { get; set;} = TextLayout.Empty;
     public TextLayout SubTitleTextLayout { get; set; } = TextLayout.Empty;
+
+    /// <summary>
+    /// Position in the recently drawn list while the text layouts are materialized.
+    /// </summary>
+    public LinkedListNode<GameProgramInfoViewItemEx>? TextLayoutCacheNode { get; set; }
 }
@@ -39,6 +39,7 @@ public sealed class GamePage : PageBase
     bool _isTooNarrowForHud, _isHudOn;
     bool _isAlreadyNavigatedHere, _isAlreadyNavigatedAway = true;
     readonly bool _startFreshReq;
+    readonly NetplayInfo? _netplay;
 
     int _backAndSettingsButtonVisibilityCounter;
 
@@ -50,11 +51,12 @@ public sealed class GamePage : PageBase
 
     #endregion
 
-    public GamePage(GameProgramInfoViewItem gameProgramInfoViewItem, List<ImportedSpecialBinaryInfo> specialBinaries, bool startFresh = false)
+    public GamePage(GameProgramInfoViewItem gameProgramInfoViewItem, List<ImportedSpecialBinaryInfo> specialBinaries, bool startFresh = false, NetplayInfo? netplay = null)
     {
         _gameProgramInfoViewItem = gameProgramInfoViewItem;
         _specialBinaries = specialBinaries;
         _startFreshReq = startFresh;
+        _netplay = netplay;
 
         _gameControl = new GameControl();
         _buttonBack = new BackButton
@@ -249,12 +251,14 @@ public sealed class GamePage : PageBase
             _hud_buttonPaused.IsChecked = _gameControl.IsPaused = false;
         }
 
+        _gameControl.Netplay = _netplay;
         _gameControl.Start(_gameProgramInfoViewItem.ImportedGameProgramInfo, _specialBinaries, _startFreshReq);
 
         _gameProgramInfoViewItem.ImportedGameProgramInfo.PersistedStateAt = DateTime.UtcNow;
 
         _settings = DatastoreService.GetSettings();
         _gameControl.IsInTouchMode = _touchbuttonCollection.IsVisible = _settings.ShowTouchControls;
+        _gameControl.AutosaveIntervalSeconds = _settings.AutosaveIntervalSeconds;
     }
 
     public override void OnNavigatingAway()
@@ -427,6 +431,18 @@ public sealed class GamePage : PageBase
                 swapped = _gameControl.SwapRightControllerPaddles();
                 PostInfoText($"P3/P4 paddles {(swapped ? "" : "un")}swapped");
                 break;
+            case KeyboardKey.C:
+                if (down)
+                    return;
+                _gameControl.IsCapturing = !_gameControl.IsCapturing;
+                PostInfoText(_gameControl.IsCapturing ? "Capture started" : "Capture stopped");
+                break;
+            case KeyboardKey.V:
+                if (down)
+                    return;
+                _gameControl.VideoFilterMode = (VideoFilterMode)((int)(_gameControl.VideoFilterMode + 1) % ((int)VideoFilterMode.NTSC + 1));
+                PostInfoText($"Video filter: {_gameControl.VideoFilterMode}");
+                break;
             case KeyboardKey.PageUp:
                 if (!_hud_buttonPower.IsChecked)
                     PowerOn();
@@ -1,8 +1,10 @@
 ﻿using EMU7800.Core;
 using EMU7800.Services;
+using EMU7800.Services.Dto;
 using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Net;
 
 namespace EMU7800.Shell;
 
@@ -109,6 +111,9 @@ public sealed class CommandLine
                -c            : Open console window (Windows only)
                -f            : Run fullscreen
                -v <0-9>      : Logging verbosity level (0 = no logging, 9 = most verbose)
+               -n <host:port>: With -r, play over the network against the EMU7800 at host:port
+               -l <port>     : Local UDP port for netplay (default: same as remote port)
+               -j <1|2>      : Controller jack played from this site for netplay (default: 1)
                (none)        : Run Game Program selection menu
 
                MachineTypes:
@@ -154,6 +159,8 @@ public sealed class CommandLine
             return null;
         }
 
+        var netplay = GetNetplayOption(args);
+
         var machineType = args.Select(MachineTypeUtil.From).FirstOrDefault(mt => mt != MachineType.Unknown);
         var cartType = args.Select(CartTypeUtil.From).FirstOrDefault(ct => ct != CartType.Unknown);
         var lController = args.Select(ControllerUtil.From).FirstOrDefault(co => co != Controller.None);
@@ -206,7 +213,7 @@ public sealed class CommandLine
                 return null;
             }
 
-            return new(new(machineType, cartType, lController, rController, romPath), importedRoms.SpecialBinaries, _datastoreSvc, _logger);
+            return new(new(machineType, cartType, lController, rController, romPath), importedRoms.SpecialBinaries, _datastoreSvc, _logger, netplay);
         }
         else
         {
@@ -214,7 +221,7 @@ public sealed class CommandLine
             var gpiviList = gameProgramLibrarySvc.GetGameProgramInfoViewItems(romPath);
             if (gpiviList.Count > 0)
             {
-                return new(gpiviList.First(), importedRoms.SpecialBinaries, _datastoreSvc, _logger);
+                return new(gpiviList.First(), importedRoms.SpecialBinaries, _datastoreSvc, _logger, netplay);
             }
             else
             {
@@ -222,7 +229,7 @@ public sealed class CommandLine
                 if (RomBytesService.IsA78Format(bytes))
                 {
                     var gpi = RomBytesService.ToGameProgramInfoFromA78Format(bytes);
-                    return new(new(gpi, string.Empty, romPath), importedRoms.SpecialBinaries, _datastoreSvc, _logger);
+                    return new(new(gpi, string.Empty, romPath), importedRoms.SpecialBinaries, _datastoreSvc, _logger, netplay);
                 }
                 else
                 {
@@ -251,6 +258,41 @@ public sealed class CommandLine
     public static bool GetOpenConsoleOption(string[] args)
       => GetBooleanOptionFlag(args, "c");
 
+    public NetplayInfo? GetNetplayOption(string[] args)
+    {
+        if (!TryGetStringOption(args, out var remote, "n"))
+            return null;
+
+        var i = remote.LastIndexOf(':');
+        if (i < 0 || !int.TryParse(remote[(i + 1)..], out var remotePort) || remotePort is <= 0 or > 0xffff)
+        {
+            _logger.Log(1, $"Netplay: expected <host:port>, found '{remote}'");
+            return null;
+        }
+
+        var host = remote[..i].Trim('[', ']');
+        if (!IPAddress.TryParse(host, out var address))
+        {
+            try
+            {
+                address = Dns.GetHostAddresses(host).FirstOrDefault();
+            }
+            catch (System.Net.Sockets.SocketException)
+            {
+            }
+        }
+        if (address is null)
+        {
+            _logger.Log(1, $"Netplay: unable to resolve host '{host}'");
+            return null;
+        }
+
+        var localPort = TryGetIntOption(args, out var port, "l") && port is > 0 and <= 0xffff ? port : remotePort;
+        var localJack = TryGetIntOption(args, out var jack, "j") && jack == 2 ? 1 : 0;
+
+        return new(new(address, remotePort), localPort, localJack);
+    }
+
     #region Constructors
 
     public CommandLine(ILogger logger)
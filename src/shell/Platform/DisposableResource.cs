@@ -8,6 +8,8 @@ public abstract class DisposableResource : IDisposable
 
     public int HR { get; protected set; } = 0;
 
+    public bool IsDisposed => _resourceDisposed;
+
     protected virtual void Dispose(bool disposing) {}
 
     public void Dispose()
@@ -0,0 +1,38 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace EMU7800.Shell;
+
+/// <summary>
+/// Resources a graphics driver created and must release at shutdown. Resources their owners
+/// already disposed are dropped as the list grows, so short-lived ones do not accumulate.
+/// </summary>
+public sealed class DisposableResourceList
+{
+    const int InitialPruneCount = 64;
+
+    readonly List<DisposableResource> _resources = [];
+    int _pruneCount = InitialPruneCount;
+
+    public int Count => _resources.Count;
+
+    public void Add(DisposableResource resource)
+    {
+        if (_resources.Count >= _pruneCount)
+        {
+            _resources.RemoveAll(r => r.IsDisposed);
+            _pruneCount = Math.Max(InitialPruneCount, 2 * _resources.Count);
+        }
+        _resources.Add(resource);
+    }
+
+    public void DisposeAll()
+    {
+        foreach (var resource in _resources)
+        {
+            resource.Dispose();
+        }
+        _resources.Clear();
+        _pruneCount = InitialPruneCount;
+    }
+}
@@ -0,0 +1,119 @@
+﻿// © Mike Murphy
+
+using EMU7800.Core;
+using System;
+using System.Runtime.InteropServices;
+
+namespace EMU7800.Shell;
+
+/// <summary>
+/// Post-processes frames with the native EMU7800.VideoFilters library before they are handed to the
+/// graphics driver, so the same filters apply to every driver.
+/// </summary>
+public sealed partial class VideoFilter : IDisposable
+{
+    const string VideoFiltersLibraryName = "EMU7800.VideoFilters";
+
+    // Threads applying a filter, counting the render thread that calls in; two workers suffice at these frame sizes.
+    const int ThreadCount = 3;
+
+    static bool _libraryUnavailable;
+
+    IntPtr _filterPtr;
+
+    public VideoFilterMode Mode { get; }
+
+    public SizeU OutputSize { get; }
+
+    /// <summary>
+    /// Filters a frame of BGR32 pixels of the size the filter was created for.
+    /// </summary>
+    /// <returns>The filtered frame, valid until the next call.</returns>
+    public unsafe ReadOnlySpan<byte> Apply(ReadOnlySpan<byte> frame, int pitch)
+    {
+        byte* output;
+        fixed (byte* input = frame)
+        {
+            output = emu7800_filter_apply(_filterPtr, input, pitch);
+        }
+        return output is null ? [] : new(output, (int)(OutputSize.Width * OutputSize.Height) << 2);
+    }
+
+    /// <summary>
+    /// Creates a filter for frames of the given size.
+    /// </summary>
+    /// <returns>null when the mode is None, or the native library is not installed or rejects the size.</returns>
+    public static VideoFilter? TryCreate(VideoFilterMode mode, SizeU inputSize, ILogger logger)
+    {
+        if (mode == VideoFilterMode.None || _libraryUnavailable)
+            return null;
+
+        IntPtr filterPtr;
+        try
+        {
+            filterPtr = emu7800_filter_create((int)mode, (int)inputSize.Width, (int)inputSize.Height, ThreadCount);
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            _libraryUnavailable = true;
+            logger.Log(1, $"Video filters unavailable: {ex.Message}");
+            return null;
+        }
+
+        if (filterPtr == IntPtr.Zero)
+        {
+            logger.Log(1, $"Video filter {mode} not created for {inputSize.Width}x{inputSize.Height} frames");
+            return null;
+        }
+
+        emu7800_filter_output_size(filterPtr, out var width, out var height);
+        return new(filterPtr, mode, new(width, height));
+    }
+
+    #region IDisposable Members
+
+    public void Dispose()
+    {
+        if (_filterPtr != IntPtr.Zero)
+        {
+            emu7800_filter_destroy(_filterPtr);
+            _filterPtr = IntPtr.Zero;
+        }
+        GC.SuppressFinalize(this);
+    }
+
+    ~VideoFilter()
+    {
+        if (_filterPtr != IntPtr.Zero)
+            emu7800_filter_destroy(_filterPtr);
+    }
+
+    #endregion
+
+    #region Constructors
+
+    VideoFilter(IntPtr filterPtr, VideoFilterMode mode, SizeU outputSize)
+    {
+        _filterPtr = filterPtr;
+        Mode = mode;
+        OutputSize = outputSize;
+    }
+
+    #endregion
+
+    #region Native Methods
+
+    [LibraryImport(VideoFiltersLibraryName)]
+    private static partial IntPtr emu7800_filter_create(int filter, int width, int height, int threadCount);
+
+    [LibraryImport(VideoFiltersLibraryName)]
+    private static partial void emu7800_filter_destroy(IntPtr filter);
+
+    [LibraryImport(VideoFiltersLibraryName)]
+    private static partial int emu7800_filter_output_size(IntPtr filter, out int width, out int height);
+
+    [LibraryImport(VideoFiltersLibraryName)]
+    private static unsafe partial byte* emu7800_filter_apply(IntPtr filter, byte* input, int inputPitch);
+
+    #endregion
+}
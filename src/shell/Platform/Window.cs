@@ -112,8 +112,8 @@ public sealed class Window
     public Window(DatastoreService datastoreSvc, ILogger logger)
       : this(new TitlePage(), datastoreSvc, logger) {}
 
-    public Window(GameProgramInfoViewItem gpivi, List<ImportedSpecialBinaryInfo> specialBinaries, DatastoreService datastoreSvc, ILogger logger)
-      : this(new GamePage(gpivi, specialBinaries, true), datastoreSvc, logger) {}
+    public Window(GameProgramInfoViewItem gpivi, List<ImportedSpecialBinaryInfo> specialBinaries, DatastoreService datastoreSvc, ILogger logger, NetplayInfo? netplay = null)
+      : this(new GamePage(gpivi, specialBinaries, true, netplay), datastoreSvc, logger) {}
 
     public Window(PageBase startPage, DatastoreService datastoreSvc, ILogger logger)
       => (_pageBackStack, _logger) = (new PageBackStackHost(startPage, datastoreSvc, logger), logger);
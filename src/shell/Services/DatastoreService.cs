@@ -20,9 +20,20 @@ public sealed class DatastoreService
         SavedGamesFolderName            = ".emu7800savedgames",
         PersistedGameProgramsFolderName = "PersistedGamePrograms",
         NvramFolderName                 = "nvram",
+        CapturesFolderName              = "Captures",
+        CaptureVideoFileExtension       = ".e78cap",
+        CaptureAudioFileExtension       = ".wav",
         ApplicationSettingsFileName     = "Settings.emusettings";
 
+    const int PersistedStateVersion = 3;
+
+    // About two seconds of frames may await the capture encoder before any are dropped.
+    const int CaptureQueueCapacity = 128;
+
+    static readonly TimeSpan PersistenceWriterTimeout = TimeSpan.FromSeconds(5);
+
     readonly IFileSystemAccessor _fileSystemAccessor;
+    readonly PersistenceWriter _persistenceWriter;
     readonly ILogger _logger;
 
     Dictionary<string, DateTime>? _cachedPersistedDir;
@@ -171,6 +182,10 @@ public sealed class DatastoreService
         return dt;
     }
 
+    /// <summary>
+    /// Captures the machine state and screenshot into pooled buffers and queues them to be compressed and
+    /// written in the background; returns without waiting on disk.
+    /// </summary>
     public void PersistMachine(MachineStateInfo machineStateInfo, ReadOnlyMemory<byte> screenshotData)
     {
         string[] folder = [..SaveGamesEmu7800Folder, PersistedGameProgramsFolderName];
@@ -181,57 +196,33 @@ public sealed class DatastoreService
         NVRAM2k.ReadNVRAMBytes  = ReadNVRAMBytes;
         NVRAM2k.WriteNVRAMBytes = WriteNVRAMBytes;
 
+        var stateData = new PooledBufferStream();
+        try
         {
-            using var stream = _fileSystemAccessor.CreateWriteStream(pssPath);
-            if (stream == Stream.Null)
-            {
-                Error(nameof(PersistMachine), "Unable to persist machine state due to previous error.");
-                return;
-            }
-
-            try
-            {
-                using var bw = new BinaryWriter(stream);
-                bw.Write(2); // version
-                bw.Write(machineStateInfo.Machine.FrameHZ);
-                bw.Write(machineStateInfo.SoundOff);
-                bw.Write(machineStateInfo.CurrentPlayerNo);
-                bw.Write(machineStateInfo.InterpolationMode);
-                machineStateInfo.Machine.Serialize(bw);
-                bw.Flush();
-                bw.Close();
-            }
-            catch (Exception ex)
-            {
-                Error(nameof(PersistMachine), $"Unable to persist machine state to {ToString(pssPath)}", ex);
-            }
+            using var bw = new BinaryWriter(stateData, Encoding.UTF8, true);
+            bw.Write(PersistedStateVersion);
+            bw.Write(machineStateInfo.Machine.FrameHZ);
+            bw.Write(machineStateInfo.SoundOff);
+            bw.Write(machineStateInfo.CurrentPlayerNo);
+            bw.Write(machineStateInfo.InterpolationMode);
+            var headerLength = (int)stateData.Length;
+            machineStateInfo.Machine.Serialize(bw);
+            bw.Flush();
+            _persistenceWriter.Enqueue(pssPath, stateData, headerLength, CompressionLevel.Fastest);
+        }
+        catch (Exception ex)
+        {
+            stateData.Dispose();
+            Error(nameof(PersistMachine), $"Unable to persist machine state to {ToString(pssPath)}", ex);
+            return;
         }
-
-        var sssName = ToScreenshotStorageName(machineStateInfo.GameProgramInfo);
-        string[] sssPath = [..folder, sssName];
 
         // data is 320w x 230h, BGR32 pixel format, width should scale x4
 
-        {
-            using var stream = _fileSystemAccessor.CreateWriteStream(sssPath);
-            if (stream == Stream.Null)
-            {
-                Error(nameof(PersistMachine), "Unable to persist machine state due to previous error.");
-                return;
-            }
-
-            try
-            {
-                using var bw = new BinaryWriter(stream);
-                bw.Write(screenshotData.Span);
-                bw.Flush();
-                stream.Close();
-            }
-            catch (Exception ex)
-            {
-                Error(nameof(PersistMachine), $"Unable to persist screenshot to {ToString(sssPath)}", ex);
-            }
-        }
+        var screenshot = new PooledBufferStream(screenshotData.Length);
+        screenshot.Write(screenshotData.Span);
+        _persistenceWriter.Enqueue([..folder, ToScreenshotStorageName(machineStateInfo.GameProgramInfo)], screenshot, 0, CompressionLevel.Optimal,
+            [..folder, ToLegacyScreenshotStorageName(machineStateInfo.GameProgramInfo)]);
 
         _cachedPersistedDir?.Remove(pssName);
         _cachedPersistedDir?.Add(pssName, DateTime.UtcNow);
@@ -244,9 +235,13 @@ public sealed class DatastoreService
         var pssName = ToPersistedStateStorageName(gameProgramInfo);
         string[] pssPath = [..folder, pssName];
         string[] sssPath = [..folder, ToScreenshotStorageName(gameProgramInfo)];
+        string[] legacySssPath = [..folder, ToLegacyScreenshotStorageName(gameProgramInfo)];
+
+        _persistenceWriter.WaitForIdle(PersistenceWriterTimeout);
 
         _fileSystemAccessor.DeleteFile(pssPath);
         _fileSystemAccessor.DeleteFile(sssPath);
+        _fileSystemAccessor.DeleteFile(legacySssPath);
 
         _cachedPersistedDir?.Remove(pssName);
     }
@@ -260,6 +255,9 @@ public sealed class DatastoreService
 
         string[] path = [..folder, ToPersistedStateStorageName(gameProgramInfo)];
 
+        // A state persisted moments ago may still be in flight.
+        _persistenceWriter.WaitForIdle(PersistenceWriterTimeout);
+
         using var stream = _fileSystemAccessor.CreateReadStream(path);
         if (stream == Stream.Null)
         {
@@ -271,11 +269,19 @@ public sealed class DatastoreService
         {
             using var br = new BinaryReader(stream);
             var version = br.ReadInt32();
+            if (version < 1 || version > PersistedStateVersion)
+            {
+                Error(nameof(RestoreMachine), $"Unable to read persisted machine state from {ToString(path)}: unsupported version {version}.");
+                return MachineStateInfo.Default;
+            }
             var framesPerSecond = br.ReadInt32();
             var soundOff = br.ReadBoolean();
             var currentPlayerNo = br.ReadInt32();
             var interpolationMode = (version > 1) ? br.ReadInt32() : 0;
-            var machine = MachineBase.Deserialize(br);
+            // Version 3 and later: the serialized machine is deflate compressed and is decompressed as it is read.
+            using var machineStream = version > 2 ? new DeflateStream(stream, CompressionMode.Decompress) : stream;
+            using var machineReader = new BinaryReader(machineStream);
+            var machine = MachineBase.Deserialize(machineReader);
             machine.FrameHZ = framesPerSecond;
             return new(machine, gameProgramInfo, soundOff, currentPlayerNo, interpolationMode);
         }
@@ -313,7 +319,8 @@ public sealed class DatastoreService
             return new()
             {
                 ShowTouchControls = br.ReadBoolean(),
-                TouchControlSeparation = version <= 1 ? 0 : br.ReadInt32()
+                TouchControlSeparation = version <= 1 ? 0 : br.ReadInt32(),
+                AutosaveIntervalSeconds = version <= 2 ? new ApplicationSettings().AutosaveIntervalSeconds : br.ReadInt32()
             };
         }
         catch (FileNotFoundException)
@@ -342,9 +349,10 @@ public sealed class DatastoreService
         try
         {
             using var bw = new BinaryWriter(stream);
-            bw.Write(2); // version
+            bw.Write(3); // version
             bw.Write(settings.ShowTouchControls);
             bw.Write(settings.TouchControlSeparation);
+            bw.Write(settings.AutosaveIntervalSeconds);
             bw.Flush();
         }
         catch (Exception ex)
@@ -355,6 +363,51 @@ public sealed class DatastoreService
 
     #endregion
 
+    #region Captures
+
+    /// <summary>
+    /// Starts recording the machine's video and audio to a new pair of files in the captures folder.
+    /// </summary>
+    /// <returns>null when the capture files cannot be created.</returns>
+    public CaptureRecorder? StartCapture(MachineBase machine, GameProgramInfo gameProgramInfo)
+    {
+        string[] folder = [..SaveGamesEmu7800Folder, CapturesFolderName];
+        _ = _fileSystemAccessor.CreateFolder(folder);
+
+        var name = ToCaptureStorageName(gameProgramInfo, DateTime.Now);
+        string[] videoPath = [..folder, name + CaptureVideoFileExtension];
+        string[] audioPath = [..folder, name + CaptureAudioFileExtension];
+
+        var videoStream = _fileSystemAccessor.CreateWriteStream(videoPath);
+        var audioStream = _fileSystemAccessor.CreateWriteStream(audioPath);
+        try
+        {
+            if (videoStream == Stream.Null || audioStream == Stream.Null)
+            {
+                throw new IOException("Unable to create capture files.");
+            }
+            var recorder = new CaptureRecorder(machine, videoStream, audioStream, CaptureQueueCapacity, _logger);
+            Info(nameof(StartCapture), "Recording to " + ToString(videoPath));
+            return recorder;
+        }
+        catch (Exception ex)
+        {
+            videoStream.Dispose();
+            audioStream.Dispose();
+            Error(nameof(StartCapture), $"Unable to start capture to {ToString(videoPath)}", ex);
+            return null;
+        }
+    }
+
+    static string ToCaptureStorageName(GameProgramInfo gameProgramInfo, DateTime startedAt)
+    {
+        var gpi = gameProgramInfo;
+        var fileName = $"{gpi.Title}.{gpi.MachineType}.{startedAt:yyyyMMdd_HHmmss}";
+        return EscapeFileNameChars(fileName);
+    }
+
+    #endregion
+
     #region Crash Dumping
 
     public void DumpCrashReport(Exception ex)
@@ -380,7 +433,7 @@ public sealed class DatastoreService
       : this(new FileSystemAccessor(logger), logger) {}
 
     public DatastoreService(IFileSystemAccessor fileSystemAccessor, ILogger logger)
-      => (_fileSystemAccessor, _logger) = (fileSystemAccessor, logger);
+      => (_fileSystemAccessor, _persistenceWriter, _logger) = (fileSystemAccessor, new(fileSystemAccessor, logger), logger);
 
     #endregion
 
@@ -394,6 +447,13 @@ public sealed class DatastoreService
     }
 
     static string ToScreenshotStorageName(GameProgramInfo gameProgramInfo, int saveSlot = 0)
+    {
+        var gpi = gameProgramInfo;
+        var fileName = $"{gpi.Title}.{gpi.MachineType}.{gpi.LController}.{gpi.RController}.{saveSlot}.bgr32.320x230.scrdata.deflate";
+        return EscapeFileNameChars(fileName);
+    }
+
+    static string ToLegacyScreenshotStorageName(GameProgramInfo gameProgramInfo, int saveSlot = 0)
     {
         var gpi = gameProgramInfo;
         var fileName = $"{gpi.Title}.{gpi.MachineType}.{gpi.LController}.{gpi.RController}.{saveSlot}.bgr32.320x230.scrdata";
@@ -6,4 +6,5 @@ public record ApplicationSettings
 {
     public bool ShowTouchControls { get; set; }
     public int TouchControlSeparation { get; set; }
+    public int AutosaveIntervalSeconds { get; set; } = 300;
 }
\ No newline at end of file
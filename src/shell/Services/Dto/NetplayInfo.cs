@@ -0,0 +1,11 @@
+// © Mike Murphy
+
+using System.Net;
+
+namespace EMU7800.Services.Dto;
+
+/// <summary>
+/// Remote site and local configuration for a two-site netplay session.
+/// </summary>
+/// <param name="LocalJack">Controller jack driven from this site, 0 (left) or 1 (right).</param>
+public record NetplayInfo(IPEndPoint RemoteEndPoint, int LocalPort, int LocalJack);
@@ -16,6 +16,7 @@ public interface IFileSystemAccessor
     IEnumerable<string> GetFolders(params string[] pathParts);
     Dictionary<string, DateTime> GetFiles(params string[] pathParts);
     void DeleteFile(params string[] pathParts);
+    bool MoveFile(string[] sourcePathParts, string[] destinationPathParts);
     Stream CreateReadStream(params string[] pathParts);
     Stream CreateWriteStream(params string[] pathParts);
 }
@@ -37,6 +38,9 @@ public sealed class NullFileSystemAccessor : IFileSystemAccessor
 
     public void DeleteFile(params string[] pathParts) {}
 
+    public bool MoveFile(string[] sourcePathParts, string[] destinationPathParts)
+      => false;
+
     public bool FolderExists(params string[] pathParts)
       => false;
 
@@ -175,6 +179,22 @@ public sealed class FileSystemAccessor : IFileSystemAccessor
         }
     }
 
+    public bool MoveFile(string[] sourcePathParts, string[] destinationPathParts)
+    {
+        var sourcePath = Path.Combine(sourcePathParts);
+        var destinationPath = Path.Combine(destinationPathParts);
+        try
+        {
+            File.Move(sourcePath, destinationPath, true);
+            return true;
+        }
+        catch (Exception ex)
+        {
+            Error("moving file", ex, sourcePath);
+            return false;
+        }
+    }
+
     #region Constructors
 
     public FileSystemAccessor(ILogger logger)
@@ -0,0 +1,161 @@
+﻿// © Mike Murphy
+
+using EMU7800.Core;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.Compression;
+using System.Threading;
+
+namespace EMU7800.Services;
+
+/// <summary>
+/// Compresses and writes snapshots on a long-lived writer thread so the emulation thread never waits on disk.
+/// Files are written under a temporary name and renamed into place, so a reader never observes a partial file.
+/// </summary>
+public sealed class PersistenceWriter
+{
+    const string TempFileExtension = ".tmp";
+
+    readonly IFileSystemAccessor _fileSystemAccessor;
+    readonly ILogger _logger;
+
+    readonly Lock _locker = new();
+    readonly List<WriteRequest> _pending = [];
+    readonly ManualResetEventSlim _idle = new(true);
+    readonly AutoResetEvent _workAvailable = new(false);
+    Thread? _writerThread;
+
+    sealed record WriteRequest(string[] Path, PooledBufferStream Data, int UncompressedPrefixLength, CompressionLevel CompressionLevel, string[]? SupersededPath);
+
+    /// <summary>
+    /// Queues data to be written to the specified path; ownership of the data buffer passes to the writer.
+    /// The first <paramref name="uncompressedPrefixLength"/> bytes are written as is, the remainder is deflate compressed.
+    /// A queued request for the same path that has not yet started is superseded.
+    /// Once the write succeeds, the file at <paramref name="supersededPath"/>, if any, is deleted.
+    /// </summary>
+    public void Enqueue(string[] path, PooledBufferStream data, int uncompressedPrefixLength, CompressionLevel compressionLevel, string[]? supersededPath = null)
+    {
+        var request = new WriteRequest(path, data, uncompressedPrefixLength, compressionLevel, supersededPath);
+        using (_locker.EnterScope())
+        {
+            var i = _pending.FindIndex(r => r.Path.AsSpan().SequenceEqual(path));
+            if (i >= 0)
+            {
+                _pending[i].Data.Dispose();
+                _pending[i] = request;
+            }
+            else
+            {
+                _pending.Add(request);
+            }
+
+            _idle.Reset();
+
+            if (_writerThread is null)
+            {
+                _writerThread = new Thread(WriterThreadProc) { IsBackground = true, Name = nameof(PersistenceWriter) };
+                _writerThread.Start();
+            }
+        }
+
+        _workAvailable.Set();
+    }
+
+    /// <summary>
+    /// Blocks until all queued writes have completed.
+    /// </summary>
+    public bool WaitForIdle(TimeSpan timeout)
+      => _idle.Wait(timeout);
+
+    #region Constructors
+
+    public PersistenceWriter(IFileSystemAccessor fileSystemAccessor, ILogger logger)
+      => (_fileSystemAccessor, _logger) = (fileSystemAccessor, logger);
+
+    #endregion
+
+    #region Helpers
+
+    void WriterThreadProc()
+    {
+        while (true)
+        {
+            WriteRequest? request = null;
+            using (_locker.EnterScope())
+            {
+                if (_pending.Count == 0)
+                {
+                    _idle.Set();
+                }
+                else
+                {
+                    request = _pending[0];
+                    _pending.RemoveAt(0);
+                }
+            }
+
+            // Holds the process open while writes are queued, so they complete even when the application is exiting.
+            Thread.CurrentThread.IsBackground = request is null;
+
+            if (request is null)
+            {
+                _workAvailable.WaitOne();
+                continue;
+            }
+
+            using (request.Data)
+            {
+                Write(request);
+            }
+        }
+    }
+
+    void Write(WriteRequest request)
+    {
+        var path = request.Path;
+        string[] tempPath = [..path[..^1], path[^1] + TempFileExtension];
+        var written = true;
+
+        using (var stream = _fileSystemAccessor.CreateWriteStream(tempPath))
+        {
+            if (stream == Stream.Null)
+            {
+                Error($"Unable to write {ToString(path)} due to previous error.");
+                return;
+            }
+
+            try
+            {
+                var data = request.Data.WrittenSpan;
+                stream.Write(data[..request.UncompressedPrefixLength]);
+                using var deflateStream = new DeflateStream(stream, request.CompressionLevel, true);
+                deflateStream.Write(data[request.UncompressedPrefixLength..]);
+            }
+            catch (Exception ex)
+            {
+                Error($"Unable to write {ToString(path)}: {ex.GetType().Name}: {ex.Message}");
+                written = false;
+            }
+        }
+
+        if (!written || !_fileSystemAccessor.MoveFile(tempPath, path))
+        {
+            _fileSystemAccessor.DeleteFile(tempPath);
+            return;
+        }
+
+        if (request.SupersededPath is { } supersededPath)
+        {
+            _fileSystemAccessor.DeleteFile(supersededPath);
+        }
+    }
+
+    void Error(string message)
+      => _logger.Log(1, $"{nameof(PersistenceWriter)}: {message}");
+
+    static string ToString(string[] path)
+      => string.Join("|", path);
+
+    #endregion
+}
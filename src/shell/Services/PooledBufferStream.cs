@@ -0,0 +1,89 @@
+﻿// © Mike Murphy
+
+using System;
+using System.Buffers;
+using System.IO;
+
+namespace EMU7800.Services;
+
+/// <summary>
+/// A write-only, growable stream over buffers rented from the shared array pool.
+/// </summary>
+public sealed class PooledBufferStream : Stream
+{
+    byte[] _buffer;
+    int _length;
+
+    public ReadOnlySpan<byte> WrittenSpan
+      => _buffer.AsSpan(0, _length);
+
+    public override bool CanRead => false;
+    public override bool CanSeek => false;
+    public override bool CanWrite => true;
+    public override long Length => _length;
+
+    public override long Position
+    {
+        get => _length;
+        set => throw new NotSupportedException();
+    }
+
+    public override void Flush() {}
+
+    public override int Read(byte[] buffer, int offset, int count)
+      => throw new NotSupportedException();
+
+    public override long Seek(long offset, SeekOrigin origin)
+      => throw new NotSupportedException();
+
+    public override void SetLength(long value)
+      => throw new NotSupportedException();
+
+    public override void Write(byte[] buffer, int offset, int count)
+      => Write(buffer.AsSpan(offset, count));
+
+    public override void Write(ReadOnlySpan<byte> buffer)
+    {
+        EnsureCapacity(_length + buffer.Length);
+        buffer.CopyTo(_buffer.AsSpan(_length));
+        _length += buffer.Length;
+    }
+
+    public override void WriteByte(byte value)
+    {
+        EnsureCapacity(_length + 1);
+        _buffer[_length++] = value;
+    }
+
+    protected override void Dispose(bool disposing)
+    {
+        if (_buffer.Length > 0)
+        {
+            ArrayPool<byte>.Shared.Return(_buffer);
+            _buffer = [];
+            _length = 0;
+        }
+        base.Dispose(disposing);
+    }
+
+    #region Constructors
+
+    public PooledBufferStream(int initialCapacity = 0x10000)
+      => _buffer = ArrayPool<byte>.Shared.Rent(initialCapacity);
+
+    #endregion
+
+    #region Helpers
+
+    void EnsureCapacity(int capacity)
+    {
+        if (capacity <= _buffer.Length)
+            return;
+        var buffer = ArrayPool<byte>.Shared.Rent(Math.Max(capacity, _buffer.Length << 1));
+        WrittenSpan.CopyTo(buffer);
+        ArrayPool<byte>.Shared.Return(_buffer);
+        _buffer = buffer;
+    }
+
+    #endregion
+}
@@ -0,0 +1,218 @@
+﻿using System;
+using System.IO;
+using System.Text;
+
+namespace EMU7800.CaptureTool;
+
+/// <summary>
+/// Writes an uncompressed AVI: 24-bit RGB frames interleaved with optional 8-bit mono PCM audio.
+/// </summary>
+public sealed class AviWriter : IDisposable
+{
+    /// <summary>
+    /// Players commonly reject AVI 1.0 files with RIFF chunks past 2GB.
+    /// </summary>
+    public const long MaxFileSize = int.MaxValue;
+
+    const uint
+        AVIF_HASINDEX       = 0x10,
+        AVIF_ISINTERLEAVED  = 0x100,
+        AVIIF_KEYFRAME      = 0x10;
+
+    readonly Stream _stream;
+    readonly BinaryWriter _writer;
+    readonly MemoryStream _index = new();
+    readonly BinaryWriter _indexWriter;
+    readonly int _frameSize;
+    readonly bool _hasAudio;
+    readonly long _riffSizePosition, _totalFramesPosition, _videoLengthPosition, _audioLengthPosition, _moviSizePosition, _moviPosition;
+    int _frames;
+    long _audioSamples;
+
+    public int Width { get; }
+    public int Height { get; }
+    public long Length => _stream.Position + _index.Length;
+
+    /// <summary>
+    /// Writes a frame of bottom-up BGR rows, each padded to four bytes.
+    /// </summary>
+    public void WriteFrame(ReadOnlySpan<byte> frame)
+    {
+        WriteChunk("00db"u8, frame[.._frameSize]);
+        _frames++;
+    }
+
+    public void WriteAudio(ReadOnlySpan<byte> samples)
+    {
+        if (!_hasAudio || samples.IsEmpty)
+            return;
+        WriteChunk("01wb"u8, samples);
+        _audioSamples += samples.Length;
+    }
+
+    public void Dispose()
+    {
+        var moviEnd = _stream.Position;
+        _writer.Write("idx1"u8);
+        _writer.Write((uint)_index.Length);
+        _index.WriteTo(_stream);
+        Patch(_riffSizePosition, (uint)(_stream.Position - _riffSizePosition - 4));
+        Patch(_moviSizePosition, (uint)(moviEnd - _moviSizePosition - 4));
+        Patch(_totalFramesPosition, (uint)_frames);
+        Patch(_videoLengthPosition, (uint)_frames);
+        if (_hasAudio)
+        {
+            Patch(_audioLengthPosition, (uint)_audioSamples);
+        }
+
+        _writer.Dispose();
+        _indexWriter.Dispose();
+    }
+
+    #region Constructors
+
+    /// <param name="stream">Seekable destination; owned by the writer.</param>
+    /// <param name="width"></param>
+    /// <param name="height"></param>
+    /// <param name="frameRate">Frames per second.</param>
+    /// <param name="sampleRate">Audio samples per second, or zero for no audio stream.</param>
+    public AviWriter(Stream stream, int width, int height, int frameRate, int sampleRate)
+    {
+        _stream = stream;
+        _writer = new(stream, Encoding.ASCII, false);
+        _indexWriter = new(_index, Encoding.ASCII, true);
+        _hasAudio = sampleRate > 0;
+
+        Width = width;
+        Height = height;
+        _frameSize = ((width * 3 + 3) & ~3) * height;
+        var samplesPerFrame = _hasAudio ? (sampleRate + frameRate - 1) / frameRate : 0;
+
+        _writer.Write("RIFF"u8);
+        _riffSizePosition = Placeholder();
+        _writer.Write("AVI "u8);
+
+        var hdrlSizePosition = BeginList("hdrl"u8);
+        _writer.Write("avih"u8);
+        _writer.Write(56);
+        _writer.Write(1000000 / frameRate);                         // microseconds per frame
+        _writer.Write((_frameSize + samplesPerFrame) * frameRate);  // max bytes per second
+        _writer.Write(0);                                           // padding granularity
+        _writer.Write(AVIF_HASINDEX | AVIF_ISINTERLEAVED);
+        _totalFramesPosition = Placeholder();
+        _writer.Write(0);                                           // initial frames
+        _writer.Write(_hasAudio ? 2 : 1);                           // streams
+        _writer.Write(_frameSize);                                  // suggested buffer size
+        _writer.Write(width);
+        _writer.Write(height);
+        _writer.Write(new byte[16]);                                // reserved
+
+        var strlSizePosition = BeginList("strl"u8);
+        _videoLengthPosition = WriteStreamHeader("vids"u8, "DIB "u8, 1, frameRate, _frameSize, 0, width, height);
+        _writer.Write("strf"u8);
+        _writer.Write(40);
+        _writer.Write(40);                                          // BITMAPINFOHEADER size
+        _writer.Write(width);
+        _writer.Write(height);                                      // positive: bottom-up rows
+        _writer.Write((short)1);                                    // planes
+        _writer.Write((short)24);                                   // bits per pixel
+        _writer.Write(0);                                           // BI_RGB
+        _writer.Write(_frameSize);
+        _writer.Write(new byte[16]);                                // resolution, palette counts
+        EndList(strlSizePosition);
+
+        if (_hasAudio)
+        {
+            strlSizePosition = BeginList("strl"u8);
+            _audioLengthPosition = WriteStreamHeader("auds"u8, [0, 0, 0, 0], 1, sampleRate, samplesPerFrame, 1, 0, 0);
+            _writer.Write("strf"u8);
+            _writer.Write(18);
+            _writer.Write((short)1);                                // PCM
+            _writer.Write((short)1);                                // mono
+            _writer.Write(sampleRate);
+            _writer.Write(sampleRate);                              // bytes per second
+            _writer.Write((short)1);                                // block align
+            _writer.Write((short)8);                                // bits per sample
+            _writer.Write((short)0);
+            EndList(strlSizePosition);
+        }
+        EndList(hdrlSizePosition);
+
+        _writer.Write("LIST"u8);
+        _moviSizePosition = Placeholder();
+        _moviPosition = _stream.Position;
+        _writer.Write("movi"u8);
+    }
+
+    #endregion
+
+    #region Helpers
+
+    void WriteChunk(ReadOnlySpan<byte> fourCC, ReadOnlySpan<byte> data)
+    {
+        // Index offsets are relative to the 'movi' list type.
+        _indexWriter.Write(fourCC);
+        _indexWriter.Write(AVIIF_KEYFRAME);
+        _indexWriter.Write((uint)(_stream.Position - _moviPosition));
+        _indexWriter.Write((uint)data.Length);
+
+        _writer.Write(fourCC);
+        _writer.Write((uint)data.Length);
+        _writer.Write(data);
+        if ((data.Length & 1) != 0)
+        {
+            _writer.Write((byte)0);
+        }
+    }
+
+    long WriteStreamHeader(ReadOnlySpan<byte> type, ReadOnlySpan<byte> handler, int scale, int rate, int suggestedBufferSize, int sampleSize, int width, int height)
+    {
+        _writer.Write("strh"u8);
+        _writer.Write(56);
+        _writer.Write(type);
+        _writer.Write(handler);
+        _writer.Write(0);                                           // flags
+        _writer.Write(0);                                           // priority, language
+        _writer.Write(0);                                           // initial frames
+        _writer.Write(scale);
+        _writer.Write(rate);
+        _writer.Write(0);                                           // start
+        var lengthPosition = Placeholder();
+        _writer.Write(suggestedBufferSize);
+        _writer.Write(-1);                                          // quality
+        _writer.Write(sampleSize);
+        _writer.Write((short)0);
+        _writer.Write((short)0);
+        _writer.Write((short)width);
+        _writer.Write((short)height);
+        return lengthPosition;
+    }
+
+    long BeginList(ReadOnlySpan<byte> type)
+    {
+        _writer.Write("LIST"u8);
+        var sizePosition = Placeholder();
+        _writer.Write(type);
+        return sizePosition;
+    }
+
+    void EndList(long sizePosition)
+        => Patch(sizePosition, (uint)(_stream.Position - sizePosition - 4));
+
+    long Placeholder()
+    {
+        var position = _stream.Position;
+        _writer.Write(0);
+        return position;
+    }
+
+    void Patch(long position, uint value)
+    {
+        var end = _stream.Position;
+        _stream.Position = position;
+        _writer.Write(value);
+        _stream.Position = end;
+    }
+
+    #endregion
+}
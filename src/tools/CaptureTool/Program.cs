@@ -0,0 +1,180 @@
+﻿using EMU7800.CaptureTool;
+using EMU7800.Core;
+using System;
+using System.IO;
+using static System.Console;
+
+AppDomain.CurrentDomain.UnhandledException += CurrentDomainUnhandledException;
+
+const int VisibleScanlines = 230;
+
+var helpRequested = false;
+var captureFileName = string.Empty;
+var audioFileName = string.Empty;
+var outputFileName = string.Empty;
+
+foreach (var arg in args)
+{
+    if (StartsWith(arg, "/h"))
+    {
+        helpRequested = true;
+    }
+    else if (StartsWith(arg, "/i"))
+    {
+        captureFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/a"))
+    {
+        audioFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/o"))
+    {
+        outputFileName = GetStrArg(arg, string.Empty);
+    }
+}
+
+WriteLine(@"
+EMU7800 CaptureTool
+Copyright (c) 2026 Mike Murphy
+");
+
+if (helpRequested || string.IsNullOrWhiteSpace(captureFileName))
+{
+    WriteLine(@"
+Usage:
+    /h                    Show usage information
+    /i:<filename>         Capture file (.e78cap) recorded by EMU7800 (required)
+    /a:<filename>         Capture audio (default: capture file name with .wav extension)
+    /o:<filename>         Output file; .avi for uncompressed video with audio,
+                          .rgb for raw 24-bit frames to encode with ffmpeg
+                          (default: report capture statistics only)
+");
+    return 0;
+}
+
+if (!File.Exists(captureFileName))
+{
+    WriteLine("Specified capture file not found.");
+    return 1;
+}
+if (string.IsNullOrWhiteSpace(audioFileName))
+{
+    audioFileName = Path.ChangeExtension(captureFileName, ".wav");
+}
+
+using var reader = new CaptureReader(File.OpenRead(captureFileName));
+using var audio = File.Exists(audioFileName) ? File.OpenRead(audioFileName) : null;
+
+// Crop to the visible scanlines as the shell does; 160 pixel wide frames are doubled horizontally.
+var firstScanline = Math.Min(reader.FirstScanline, reader.Scanlines - 1);
+var height = Math.Min(VisibleScanlines, reader.Scanlines - firstScanline);
+var scale = reader.Pitch < 320 ? 2 : 1;
+var width = reader.Pitch * scale;
+var sampleRate = reader.SoundSamplesPerFrame * reader.FrameHZ;
+
+WriteLine($"Capture: {reader.Pitch}x{reader.Scanlines} at {reader.FrameHZ} HZ, first visible scanline {reader.FirstScanline}");
+WriteLine(audio is null ? "Audio: none" : $"Audio: {audioFileName} ({sampleRate} HZ)");
+
+audio?.Seek(WaveFile.HeaderSize, SeekOrigin.Begin);  // canonical PCM WAV header written by CaptureRecorder
+
+var isAvi = outputFileName.EndsWith(".avi", StringComparison.OrdinalIgnoreCase);
+var isRaw = outputFileName.EndsWith(".rgb", StringComparison.OrdinalIgnoreCase);
+if (!string.IsNullOrWhiteSpace(outputFileName) && !isAvi && !isRaw)
+{
+    WriteLine("Output file extension must be .avi or .rgb.");
+    return 1;
+}
+
+var output = isAvi || isRaw ? File.Create(outputFileName) : null;
+var avi = isAvi ? new AviWriter(output!, width, height, reader.FrameHZ, audio is null ? 0 : sampleRate) : null;
+
+var frame = new byte[reader.Pitch * reader.Scanlines];
+var samples = new byte[reader.SoundSamplesPerFrame];
+var stride = (width * 3 + 3) & ~3;
+var image = new byte[stride * height];
+
+var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+var truncated = false;
+while (reader.ReadFrame(frame))
+{
+    if (avi is not null && avi.Length + image.Length + samples.Length + 64 > AviWriter.MaxFileSize)
+    {
+        truncated = true;
+        break;
+    }
+
+    if (output is not null)
+    {
+        // AVI frames are bottom-up BGR, raw frames top-down RGB.
+        for (var y = 0; y < height; y++)
+        {
+            var source = frame.AsSpan((firstScanline + y) * reader.Pitch, reader.Pitch);
+            var row = image.AsSpan((avi is not null ? height - 1 - y : y) * (avi is not null ? stride : width * 3));
+            for (int x = 0, di = 0; x < source.Length; x++)
+            {
+                var color = reader.Palette[source[x]];
+                var (first, last) = avi is not null ? ((byte)color, (byte)(color >> 16)) : ((byte)(color >> 16), (byte)color);
+                for (var i = 0; i < scale; i++)
+                {
+                    row[di++] = first;
+                    row[di++] = (byte)(color >> 8);
+                    row[di++] = last;
+                }
+            }
+        }
+    }
+
+    var sampleCount = audio?.ReadAtLeast(samples, samples.Length, false) ?? 0;
+    if (avi is not null)
+    {
+        avi.WriteFrame(image);
+        avi.WriteAudio(samples.AsSpan(0, sampleCount));
+    }
+    else
+    {
+        output?.Write(image, 0, stride == width * 3 ? image.Length : width * 3 * height);
+    }
+}
+stopwatch.Stop();
+
+avi?.Dispose();
+output?.Dispose();
+
+var frames = reader.FrameCount;
+var captureBytes = new FileInfo(captureFileName).Length;
+WriteLine($"{frames} frames ({(double)frames / reader.FrameHZ:0.00}s), {captureBytes} bytes ({(frames > 0 ? captureBytes / frames : 0)} bytes/frame), {(double)frames * frame.Length / Math.Max(1, captureBytes):0.0}:1 compression");
+if (reader.FramesDropped > 0)
+{
+    WriteLine($"{reader.FramesDropped} frames were dropped during recording; each repeats the frame before it, with silence");
+}
+WriteLine($"Decoded in {stopwatch.Elapsed.TotalSeconds:0.000}s ({frames / Math.Max(1e-6, stopwatch.Elapsed.TotalSeconds):0} frames/s)");
+
+if (truncated)
+{
+    WriteLine($"Stopped after {frames} frames: AVI output would exceed {AviWriter.MaxFileSize} bytes; use .rgb output for longer captures.");
+}
+if (isAvi)
+{
+    WriteLine($"Wrote {outputFileName} ({width}x{height})");
+}
+else if (isRaw)
+{
+    WriteLine($"Wrote {outputFileName}; encode with, for example:");
+    WriteLine($"    ffmpeg -f rawvideo -pixel_format rgb24 -video_size {width}x{height} -framerate {reader.FrameHZ} -i \"{outputFileName}\"{(audio is null ? "" : $" -i \"{audioFileName}\"")} -c:v libx264 -crf 0 capture.mkv");
+}
+return 0;
+
+static bool StartsWith(string arg, string text)
+    => !string.IsNullOrWhiteSpace(arg) && arg.StartsWith(text, StringComparison.OrdinalIgnoreCase);
+
+static string GetStrArg(string curArg, string defaultValue)
+{
+    var startPos = curArg.IndexOf(":", StringComparison.OrdinalIgnoreCase);
+    return startPos >= 0 ? curArg[(startPos + 1)..] : defaultValue;
+}
+
+static void CurrentDomainUnhandledException(object sender, UnhandledExceptionEventArgs e)
+{
+    WriteLine(e.ExceptionObject.ToString());
+    Environment.Exit(1);
+}
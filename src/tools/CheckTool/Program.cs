@@ -0,0 +1,581 @@
+﻿using EMU7800.Core;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Net;
+using System.Security.Cryptography;
+using static System.Console;
+
+AppDomain.CurrentDomain.UnhandledException += CurrentDomainUnhandledException;
+
+var helpRequested = false;
+var allocationCheckRequested = false;
+var loopbackCheckRequested = false;
+var cartCheckRequested = false;
+var romDirectory = Path.Combine("lib", "roms");
+var romPropertiesFileName = Path.Combine("src", "assets", "ROMProperties.csv");
+var frames = 10000;
+
+foreach (var arg in args)
+{
+    if (StartsWith(arg, "/h"))
+    {
+        helpRequested = true;
+    }
+    else if (StartsWith(arg, "/a"))
+    {
+        allocationCheckRequested = true;
+    }
+    else if (StartsWith(arg, "/l"))
+    {
+        loopbackCheckRequested = true;
+    }
+    else if (StartsWith(arg, "/c"))
+    {
+        cartCheckRequested = true;
+    }
+    else if (StartsWith(arg, "/r"))
+    {
+        romDirectory = GetStrArg(arg, romDirectory);
+    }
+    else if (StartsWith(arg, "/p"))
+    {
+        romPropertiesFileName = GetStrArg(arg, romPropertiesFileName);
+    }
+    else if (StartsWith(arg, "/n"))
+    {
+        frames = GetIntArg(arg, frames);
+        if (frames < 1)
+        {
+            WriteLine("Frames must be at least 1.");
+            return 1;
+        }
+    }
+}
+
+WriteLine(@"
+EMU7800 CheckTool
+Copyright (c) 2026 Mike Murphy
+");
+
+if (helpRequested || !allocationCheckRequested && !loopbackCheckRequested && !cartCheckRequested)
+{
+    WriteLine(@"
+Usage:
+    /h                    Show usage information
+    /a                    Allocation check: run every machine type with one ROM per cart type
+                          and fail unless emulation allocates zero bytes
+    /l                    Netplay loopback check: run two rollback sessions over UDP loopback at uneven
+                          paces for every machine type with one ROM per cart type, and fail on a desync,
+                          no rollbacks, allocation, or a final state unlike that of an uninterrupted run
+    /c                    Cart check: drive each bankswitched cart type with a synthetic ROM through a fixed
+                          sequence of reads, writes and resets, and fail on a result unlike the digest recorded
+                          for it, or on a cart that behaves differently once restored from a saved state
+    /r:<directory>        ROM directory, searched recursively (default: lib/roms)
+    /p:<filename>         ROM properties (default: src/assets/ROMProperties.csv)
+    /n:{#}                Frames to run per machine type and ROM (default:10000)
+
+Exits with a nonzero code when a check fails.
+");
+    return 0;
+}
+
+var result = 0;
+if (cartCheckRequested)
+{
+    result |= CheckCarts();
+}
+if (!allocationCheckRequested && !loopbackCheckRequested)
+{
+    return result;
+}
+
+if (!Directory.Exists(romDirectory))
+{
+    WriteLine("Specified ROM directory not found.");
+    return 1;
+}
+if (!File.Exists(romPropertiesFileName))
+{
+    WriteLine("Specified ROM properties file not found.");
+    return 1;
+}
+
+var plannedRuns = PlanRuns(romDirectory, romPropertiesFileName, out var missingBiosFailures);
+result |= missingBiosFailures == 0 ? 0 : 1;
+if (allocationCheckRequested)
+{
+    result |= CheckAllocations(plannedRuns, frames);
+}
+if (loopbackCheckRequested)
+{
+    result |= CheckLoopback(plannedRuns, frames);
+}
+return result;
+
+static int CheckAllocations(List<MachineRun> plannedRuns, int frames)
+{
+    const int WarmupFrames = 120;
+
+    var failures = 0;
+    var runs = 0;
+
+    foreach (var run in plannedRuns)
+    {
+        var machine = run.CreateMachine();
+
+        for (var i = 0; i < WarmupFrames; i++)
+        {
+            RunFrame(machine, i);
+        }
+
+        var allocatedBefore = GC.GetAllocatedBytesForCurrentThread();
+        for (var i = 0; i < frames; i++)
+        {
+            RunFrame(machine, i);
+        }
+        var allocated = GC.GetAllocatedBytesForCurrentThread() - allocatedBefore;
+
+        runs++;
+        if (allocated != 0)
+        {
+            failures++;
+        }
+        WriteLine($"{run.MachineType,-14} {run.Rom.CartType,-12} {Path.GetFileName(run.Rom.FileName),-28} {allocated,10} bytes {(allocated == 0 ? "ok" : "FAIL")}");
+    }
+
+    WriteLine();
+    WriteLine($"{runs} runs of {frames} frames, {failures} failed");
+    return failures == 0 && runs > 0 ? 0 : 1;
+
+    // Toggles the fire button and a direction so the input paths are exercised along with the frame.
+    static void RunFrame(MachineBase machine, int frameNo)
+    {
+        machine.InputState.RaiseInput(0, MachineInput.Fire, (frameNo & 8) != 0);
+        machine.InputState.RaiseInput(0, MachineInput.Left, (frameNo & 32) != 0);
+        machine.ComputeNextFrame();
+    }
+}
+
+// Each site drives one jack through its own session; a third machine runs the same input without netplay.
+// Site B skips and doubles up frames so that each site predicts, and later corrects, the other's input.
+static int CheckLoopback(List<MachineRun> plannedRuns, int frames)
+{
+    const int
+        WarmupFrames = 120,
+        QuietFrames  = 4 * RollbackSession.DefaultMaxPredictionFrames,
+        BasePort     = 47800;
+
+    var failures = 0;
+    var runs = 0;
+
+    foreach (var run in plannedRuns)
+    {
+        // Both sites must start from identical state, which a multicart picking its game at creation would not.
+        var initialState = SerializeMachine(run.CreateMachine());
+        var reference = DeserializeMachine(initialState);
+        for (var frame = 0; frame < frames; frame++)
+        {
+            RaiseLoopbackInput(reference.InputState, 0, frame, frames - QuietFrames);
+            RaiseLoopbackInput(reference.InputState, 1, frame, frames - QuietFrames);
+            reference.ComputeNextFrame();
+        }
+
+        using var siteA = new RollbackSession(DeserializeMachine(initialState), new(BasePort, new(IPAddress.Loopback, BasePort + 1)), 0, RollbackSession.DefaultMaxPredictionFrames, NullLogger.Default);
+        using var siteB = new RollbackSession(DeserializeMachine(initialState), new(BasePort + 1, new(IPAddress.Loopback, BasePort)), 1, RollbackSession.DefaultMaxPredictionFrames, NullLogger.Default);
+
+        long allocated = 0;
+        var maxIterations = 4L * frames + 10000;
+        var iteration = 0L;
+        for (; iteration < maxIterations && (siteA.Frame < frames || siteB.Frame < frames); iteration++)
+        {
+            var allocatedBefore = GC.GetAllocatedBytesForCurrentThread();
+            AdvanceSite(siteA, 1, frames, QuietFrames);
+            AdvanceSite(siteB, iteration % 7 == 0 ? 0 : iteration % 5 == 0 ? 2 : 1, frames, QuietFrames);
+            if (siteA.Frame > WarmupFrames && siteB.Frame > WarmupFrames)
+            {
+                allocated += GC.GetAllocatedBytesForCurrentThread() - allocatedBefore;
+            }
+        }
+
+        var referenceState = SerializeMachine(reference);
+        var failure = iteration == maxIterations ? "sessions stalled"
+            : siteA.State != NetplayState.Running || siteB.State != NetplayState.Running ? "session not running"
+            : siteA.Desynced || siteB.Desynced ? "desynced"
+            : siteA.Rollbacks + siteB.Rollbacks == 0 ? "no rollbacks"
+            : !SerializeMachine(siteA.Machine).SequenceEqual(referenceState) || !SerializeMachine(siteB.Machine).SequenceEqual(referenceState) ? "final state differs"
+            : allocated != 0 ? "allocated"
+            : null;
+
+        runs++;
+        if (failure is not null)
+        {
+            failures++;
+        }
+        WriteLine($"{run.MachineType,-14} {run.Rom.CartType,-12} {Path.GetFileName(run.Rom.FileName),-28} {siteA.Rollbacks + siteB.Rollbacks,6} rollbacks {allocated,10} bytes {failure ?? "ok"}");
+    }
+
+    WriteLine();
+    WriteLine($"{runs} loopback runs of {frames} frames, {failures} failed");
+    return failures == 0 && runs > 0 ? 0 : 1;
+
+    static void AdvanceSite(RollbackSession session, int count, int frames, int quietFrames)
+    {
+        for (var i = 0; i < count && session.Frame < frames; i++)
+        {
+            RaiseLoopbackInput(session.LocalInputState, session.LocalJack, session.Frame, frames - quietFrames);
+            session.AdvanceFrame();
+        }
+    }
+
+    // Input ends early so that nothing remains mispredicted once both sites reach the last frame.
+    static void RaiseLoopbackInput(InputState inputState, int playerNo, int frameNo, int quietFrameNo)
+    {
+        var active = frameNo < quietFrameNo;
+        inputState.RaiseInput(playerNo, MachineInput.Fire, active && (frameNo / (8 + 4 * playerNo) & 1) != 0);
+        inputState.RaiseInput(playerNo, playerNo == 0 ? MachineInput.Left : MachineInput.Right, active && (frameNo / (32 - 12 * playerNo) & 1) != 0);
+    }
+}
+
+// Each cart gets its own deterministic ROM and access sequence, so a digest changes only with the cart's behavior:
+// the bytes it returns, its RAM, its bank numbers and its POKEY output. The digests were recorded with the cart
+// classes as they were before they moved onto BankswitchedCart.
+static int CheckCarts()
+{
+    const int Segments = 64;
+
+    (CartType CartType, int RomSize, string Digest)[] expected =
+    [
+        (CartType.A2K,          0x00800, "2E11C5C594299670"),
+        (CartType.A4K,          0x01000, "AC6C8F6D8AA91328"),
+        (CartType.A8K,          0x02000, "CB22AD3551D2F9C9"),
+        (CartType.A8KR,         0x02000, "9DA2DB6D48775F76"),
+        (CartType.A16K,         0x04000, "61F982F3DDAFF0FD"),
+        (CartType.A16KR,        0x04000, "987B8D629F537788"),
+        (CartType.A32K,         0x08000, "7663D990A60945A5"),
+        (CartType.A32KR,        0x08000, "46736D6124964BC3"),
+        (CartType.DC8K,         0x02000, "639A70F4B1253C6A"),
+        (CartType.PB8K,         0x02000, "1234275945662440"),
+        (CartType.TV8K,         0x02000, "30E099F4FB36575E"),
+        (CartType.TV8K,         0x01800, "F0034BEC50404A30"),  // banks wrap at the bank count, no longer at 16 bits
+        (CartType.CBS12K,       0x03000, "42454D23BA74F526"),
+        (CartType.MN16K,        0x04000, "72FE693A0C83D9EC"),
+        (CartType.A7808,        0x02000, "EB83CADDA507F8C0"),
+        (CartType.A7816,        0x04000, "38043027C1059112"),
+        (CartType.A7832,        0x08000, "DA9AEF7A13DCBF8D"),
+        (CartType.A7832P,       0x08000, "94DC5F7F2D18DCA9"),
+        (CartType.A7832PL,      0x08000, "BEFB25C68DAB2903"),
+        (CartType.A7848,        0x0c000, "6F595962CF6FA8A8"),
+        (CartType.A78SG,        0x20000, "D34BF144258CA1AC"),
+        (CartType.A78SGP,       0x20000, "0256C28C98153A8F"),
+        (CartType.A78SGR,       0x20000, "6047D4ADCC941B1A"),
+        (CartType.A78S9,        0x24000, "71C9AD82F9027198"),
+        (CartType.A78S9PL,      0x24000, "C00918A7A314A323"),  // console reset now resets the POKEY
+        (CartType.A78S4,        0x10000, "B669F4FCAFE98A54"),
+        (CartType.A78S4R,       0x10000, "EF38BAF678C6A3E4"),
+        (CartType.A78AB,        0x10000, "E94E5C5C7461ED3F"),
+        (CartType.A78AC,        0x20000, "40319C0D9B38BAF1"),
+        (CartType.A78BB32K,     0x08000, "927DD30613E83ABD"),
+        (CartType.A78BB32KP,    0x08000, "F1509998D4CEEEA3"),
+        (CartType.A78BB32KRPL,  0x08000, "026E73BD1BED9FB9"),
+        (CartType.A78BB48K,     0x0c000, "6F751FF66F613936"),
+        (CartType.A78BB48KP,    0x0c000, "6C58D9315E3E8AC1"),
+        (CartType.A78BB52K,     0x0d000, "7479CC55908400C0"),
+        (CartType.A78BB52KP,    0x0d000, "ECE1320D1AA85258"),
+        (CartType.A78BB128K,    0x20000, "57DFA11A449A3CD4"),
+        (CartType.A78BB128KR,   0x20000, "BDED307CEE75967A"),
+        (CartType.A78BB128KP,   0x20000, "F4E0077BBF37E7CE"),
+        (CartType.A78BB128KRPL, 0x20000, "BCF9AC292D824A04"),
+    ];
+
+    var failures = 0;
+
+    foreach (var (cartType, romSize, expectedDigest) in expected)
+    {
+        var random = CartSeed(cartType, romSize);
+        var machine = CreateCartMachine(cartType, romSize, ref random);
+        var digest = DigestCartAccesses(machine, ref random, Segments);
+
+        // From here on, a machine restored from a saved state must go on exactly as the original. Maria reads
+        // only last the length of a DMA fetch, so they are not part of the saved state.
+        var restored = DeserializeMachine(SerializeMachine(machine));
+        restored.Mem.MariaRead = machine.Mem.MariaRead;
+        var restoredRandom = random;
+        var restoredDiffers = DigestCartAccesses(restored, ref restoredRandom, 1) != DigestCartAccesses(machine, ref random, 1);
+
+        var failure = digest != expectedDigest ? "digest differs"
+            : restoredDiffers ? "differs once restored"
+            : null;
+        if (failure is not null)
+        {
+            failures++;
+        }
+        WriteLine($"{cartType,-12} {romSize,7} bytes {digest} {failure ?? "ok"}");
+    }
+
+    WriteLine();
+    WriteLine($"{expected.Length} carts, {failures} failed");
+    return failures == 0 ? 0 : 1;
+}
+
+static ulong CartSeed(CartType cartType, int romSize)
+    => 0x9e3779b97f4a7c15UL ^ (ulong)cartType << 32 ^ (ulong)romSize;
+
+static MachineBase CreateCartMachine(CartType cartType, int romSize, ref ulong random)
+{
+    var rom = new byte[romSize];
+    for (var i = 0; i < rom.Length; i++)
+    {
+        rom[i] = (byte)NextRandom(ref random);
+    }
+    var machineType = cartType < CartType.A7808 ? MachineType.A2600NTSC : MachineType.A7800NTSC;
+    return MachineBase.Create(machineType, Cart.Create(rom, cartType), Bios7800.Default, Controller.Joystick, Controller.Joystick, NullLogger.Default);
+}
+
+// Accesses go through the address space, so snooping and the cart's own mapping take part. Writes favor the
+// hotspot and POKEY ranges of the various schemes; POKEY RANDOM reads are left out of the digest, as they
+// derive from the CPU clock rather than the cart.
+static string DigestCartAccesses(MachineBase machine, ref ulong random, int segments)
+{
+    const int AccessesPerSegment = 1024;
+
+    var is7800 = machine is Machine7800;
+    var cart = machine.Cart;
+    using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+    var reads = new byte[AccessesPerSegment];
+    var banks = new byte[16];
+
+    for (var segment = 0; segment < segments; segment++)
+    {
+        machine.FrameBuffer.SoundBuffer.Span.Clear();
+        cart.StartFrame();
+
+        var readCount = 0;
+        for (var i = 0; i < AccessesPerSegment; i++)
+        {
+            var r = NextRandom(ref random);
+            var value = (byte)(r >> 8);
+            var low = (int)(r >> 16) & 0xff;
+            var high = (int)(r >> 20);
+            switch (r & 0x0f)
+            {
+                case < 8:
+                    var readAddr = !is7800 ? ((r & 0x30) == 0 ? 0x1fc0 | (low & 0x3f) : 0x1000 | (high & 0x0fff))
+                        : (r & 0x30) == 0 ? 0xff80 | (low & 0x7f) : 0x3000 + high % 0xd000;
+                    var data = machine.Mem[(ushort)readAddr];
+                    if (!is7800 || readAddr is < 0x4000 or >= 0x8000 || (readAddr & 0x0f) != 0x0a)
+                    {
+                        reads[readCount++] = data;
+                    }
+                    break;
+                case < 14:
+                    var writeAddr = !is7800 ? ((r >> 4) & 3) switch
+                        {
+                            0 => 0x1fc0 | (low & 0x3f),
+                            1 => low & 0x3f,
+                            _ => 0x1000 | (high & 0x0fff),
+                        }
+                        : ((r >> 4) & 7) switch
+                        {
+                            0 => 0xff80 | (low & 0x7f),
+                            1 => 0x0440 | (low & 0x3f),
+                            2 => 0x0800 | low,
+                            3 => 0x4000 | (low & 0x0f),
+                            4 => 0x8000 | (high & 0x3fff),
+                            _ => 0x3000 + high % 0xd000,
+                        };
+                    machine.Mem[(ushort)writeAddr] = value;
+                    break;
+                case 14:
+                    if (is7800)
+                    {
+                        machine.Mem.MariaRead ^= 1;
+                    }
+                    break;
+                default:
+                    if (low == 0)
+                    {
+                        cart.Reset();
+                    }
+                    break;
+            }
+        }
+
+        cart.EndFrame();
+
+        hash.AppendData(reads, 0, readCount);
+        hash.AppendData(machine.FrameBuffer.SoundBuffer.Span);
+        hash.AppendData(cart.RAMContents);
+        for (var i = 0; i < banks.Length; i++)
+        {
+            banks[i] = cart.GetBankNo((ushort)(is7800 ? 0x3000 + i * 0x0d00 : 0x1000 + i * 0x0100));
+        }
+        hash.AppendData(banks);
+    }
+
+    return Convert.ToHexString(hash.GetHashAndReset())[..16];
+}
+
+// xorshift64*
+static uint NextRandom(ref ulong state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (uint)(state * 0x2545f4914f6cdd1dUL >> 32);
+}
+
+static byte[] SerializeMachine(MachineBase machine)
+{
+    using var stream = new MemoryStream();
+    using var writer = new BinaryWriter(stream);
+    machine.Serialize(writer);
+    writer.Flush();
+    return stream.ToArray();
+}
+
+static MachineBase DeserializeMachine(byte[] state)
+{
+    using var reader = new BinaryReader(new MemoryStream(state));
+    return MachineBase.Deserialize(reader);
+}
+
+static List<MachineRun> PlanRuns(string romDirectory, string romPropertiesFileName, out int failures)
+{
+    var roms = PickRomPerCartType(romDirectory, romPropertiesFileName);
+    var biosDirectory = Path.Combine(romDirectory, "Bios78");
+    var hscRom = ReadIfExists(Path.Combine(biosDirectory, "HighScore.bin"));
+
+    var runs = new List<MachineRun>();
+    failures = 0;
+
+    foreach (var machineType in Enum.GetValues<MachineType>().Where(mt => mt != MachineType.Unknown))
+    {
+        var bios = !MachineTypeUtil.Is7800bios(machineType) ? Bios7800.Default
+            : ReadIfExists(Path.Combine(biosDirectory, MachineTypeUtil.IsPAL(machineType) ? "7800pal.ROM1" : "7800.ROM")) is { Length: > 0 } biosBytes
+            ? new Bios7800(biosBytes) : null;
+        if (bios is null || (MachineTypeUtil.Is7800hsc(machineType) || MachineTypeUtil.Is7800xm(machineType)) && hscRom.Length == 0)
+        {
+            WriteLine($"{machineType}: FAIL: BIOS or High Score cartridge ROM not found in {biosDirectory}");
+            failures++;
+            continue;
+        }
+
+        foreach (var rom in roms.Where(r => MachineTypeUtil.Is7800(r.MachineType) == MachineTypeUtil.Is7800(machineType)))
+        {
+            runs.Add(new(machineType, rom, bios, hscRom));
+        }
+    }
+
+    return runs;
+}
+
+static List<RomInfo> PickRomPerCartType(string romDirectory, string romPropertiesFileName)
+{
+    const int A78HeaderSize = 128;
+
+    var properties = File.ReadLines(romPropertiesFileName)
+        .Skip(1)
+        .Select(line => line.Split(','))
+        .Where(sl => sl.Length >= 13)
+        .GroupBy(sl => sl[^2], StringComparer.OrdinalIgnoreCase)
+        .ToDictionary(g => g.Key, g => g.First(), StringComparer.OrdinalIgnoreCase);
+
+    var picks = new Dictionary<(bool, CartType), RomInfo>();
+
+    foreach (var fileName in Directory.EnumerateFiles(romDirectory, "*", SearchOption.AllDirectories).Order(StringComparer.Ordinal))
+    {
+        var bytes = File.ReadAllBytes(fileName);
+        if (bytes.Length % 1024 == A78HeaderSize)
+        {
+            bytes = bytes[A78HeaderSize..];
+        }
+
+        var md5 = Convert.ToHexString(MD5.HashData(bytes));
+        if (!properties.TryGetValue(md5, out var sl)
+            || !Enum.TryParse<MachineType>(sl[^5], out var machineType) || machineType == MachineType.Unknown)
+        {
+            continue;
+        }
+
+        var cartType = Enum.TryParse<CartType>(sl[^6], out var ct) && ct != CartType.Unknown ? ct
+            : InferCartTypeFromSize(machineType, bytes.Length);
+        if (cartType == CartType.Unknown)
+        {
+            continue;
+        }
+
+        var is7800 = MachineTypeUtil.Is7800(machineType);
+        var defaultController = is7800 ? Controller.ProLineJoystick : Controller.Joystick;
+        var lController = Enum.TryParse<Controller>(sl[^4], out var lc) && lc != Controller.None ? lc : defaultController;
+        var rController = Enum.TryParse<Controller>(sl[^3], out var rc) && rc != Controller.None ? rc : defaultController;
+
+        picks.TryAdd((is7800, cartType), new(fileName, bytes, machineType, cartType, lController, rController));
+    }
+
+    return [.. picks.Values];
+
+    // As the shell infers the cart type of ROMs listed without one.
+    static CartType InferCartTypeFromSize(MachineType machineType, int romByteCount)
+        => MachineTypeUtil.Is2600(machineType) ? romByteCount switch
+        {
+             2048 => CartType.A2K,
+             4096 => CartType.A4K,
+             8192 => CartType.A8K,
+            16384 => CartType.A16K,
+            32768 => CartType.A32K,
+            _     => CartType.Unknown
+        }
+        : romByteCount switch
+        {
+             8192 => CartType.A7808,
+            16384 => CartType.A7816,
+            32768 => CartType.A7832,
+            49152 => CartType.A7848,
+            _     => CartType.Unknown
+        };
+}
+
+static byte[] ReadIfExists(string fileName)
+    => File.Exists(fileName) ? File.ReadAllBytes(fileName) : [];
+
+static bool StartsWith(string arg, string text)
+    => !string.IsNullOrWhiteSpace(arg) && arg.StartsWith(text, StringComparison.OrdinalIgnoreCase);
+
+static int GetIntArg(string curArg, int defaultValue)
+{
+    var startPos = curArg.IndexOf(":", StringComparison.OrdinalIgnoreCase);
+    return startPos >= 0 ? int.TryParse(curArg[(startPos + 1)..], out var num) ? num : defaultValue : defaultValue;
+}
+
+static string GetStrArg(string curArg, string defaultValue)
+{
+    var startPos = curArg.IndexOf(":", StringComparison.OrdinalIgnoreCase);
+    return startPos >= 0 ? curArg[(startPos + 1)..] : defaultValue;
+}
+
+static void CurrentDomainUnhandledException(object sender, UnhandledExceptionEventArgs e)
+{
+    WriteLine(e.ExceptionObject.ToString());
+    Environment.Exit(1);
+}
+
+record RomInfo(string FileName, byte[] Bytes, MachineType MachineType, CartType CartType, Controller LController, Controller RController);
+
+record MachineRun(MachineType MachineType, RomInfo Rom, Bios7800 Bios, byte[] HscRom)
+{
+    public MachineBase CreateMachine()
+    {
+        var cart = Cart.Create(Rom.Bytes, Rom.CartType);
+        if (MachineTypeUtil.Is7800hsc(MachineType))
+        {
+            cart = new HSC7800(HscRom, cart);
+        }
+        else if (MachineTypeUtil.Is7800xm(MachineType))
+        {
+            cart = new XM7800(HscRom, cart);
+        }
+        return MachineBase.Create(MachineType, cart, Bios, Rom.LController, Rom.RController, NullLogger.Default);
+    }
+}
@@ -14,6 +14,11 @@ public class InputTapePlayer(InputTapeReader inputTapeReader)
 
     public Action EndOfTapeReached = () => {};
 
+    /// <summary>
+    /// Whether each new register setting is written to the console as it is reached.
+    /// </summary>
+    public bool IsEchoOn { get; set; } = true;
+
     public void GetRegisterSettingsForNextFrame(SoundEmulator e)
     {
         if (_endOfTapeReached)
@@ -29,7 +34,8 @@ public class InputTapePlayer(InputTapeReader inputTapeReader)
                 EndOfTapeReached();
                 return;
             }
-            Console.WriteLine($@"
+            if (IsEchoOn)
+                Console.WriteLine($@"
 tAUD C0:{reg[0]:x2} F0:{reg[1]:x2} V0:{reg[2]:x2}  C1:{reg[3]:x2} F1:{reg[4]:x2} V1:{reg[5]:x2}  pAUD CTL:{reg[6]:x2}  C1:{reg[7]:x2} F1:{reg[8]:x2}  C2:{reg[9]:x2} F2:{reg[10]:x2}  C3:{reg[11]:x2} F3:{reg[12]:x2}  C4:{reg[13]:x2} F4:{reg[14]:x2}    {reg[15]}");
         }
 
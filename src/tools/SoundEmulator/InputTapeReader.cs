@@ -9,22 +9,49 @@ public class InputTapeReader
 {
     readonly Queue<byte[]> _queue = new();
 
+    /// <summary>
+    /// Parses the tape in buffered chunks, one line at a time, without decoding it to strings.
+    /// </summary>
     public int Load(string fileName)
     {
         _queue.Clear();
 
-        using (var sr = new StreamReader(fileName))
+        using var stream = new FileStream(fileName, FileMode.Open, FileAccess.Read, FileShare.Read, 1, FileOptions.SequentialScan);
+
+        var buffer = new byte[0x4000];
+        var count = 0;
+        var atStart = true;
+        while (true)
         {
-            while (true)
+            var read = stream.Read(buffer, count, buffer.Length - count);
+            count += read;
+
+            var pending = new ReadOnlySpan<byte>(buffer, 0, count);
+            if (atStart && pending.StartsWith(Utf8Bom))
+            {
+                pending = pending[Utf8Bom.Length..];
+            }
+            atStart = false;
+
+            int eol;
+            while ((eol = pending.IndexOf((byte)'\n')) >= 0)
+            {
+                ParseLine(pending[..eol]);
+                pending = pending[(eol + 1)..];
+            }
+
+            if (read == 0)
             {
-                var line = sr.ReadLine();
-                if (line == null)
-                    break;
-                var parsedLine = ParseLine(line);
-                if (parsedLine.Length > 0)
-                {
-                    _queue.Enqueue(parsedLine);
-                }
+                ParseLine(pending);
+                break;
+            }
+
+            // Carry the partial line over to the next chunk, making room for lines longer than the buffer.
+            pending.CopyTo(buffer);
+            count = pending.Length;
+            if (count == buffer.Length)
+            {
+                Array.Resize(ref buffer, buffer.Length << 1);
             }
         }
 
@@ -34,26 +61,32 @@ public class InputTapeReader
     public byte[] Dequeue()
         => _queue.Count > 0 ? _queue.Dequeue() : [];
 
-    static byte[] ParseLine(string line)
+    void ParseLine(ReadOnlySpan<byte> line)
     {
-        var trimmedLine = line.Trim();
-        if (trimmedLine.Length == 0 || trimmedLine[0] == ';')
-        {
-            return [];
-        }
+        line = line.Trim(Whitespace);
+        if (line.IsEmpty || line[0] == ';')
+            return;
 
         var parsedLine = new byte[16];
 
-        var splitTrimmedLine = trimmedLine.Split(' ', StringSplitOptions.RemoveEmptyEntries);
-
-        for (var i = 0; i < parsedLine.Length && i < splitTrimmedLine.Length; i++)
+        for (var i = 0; i < parsedLine.Length && !line.IsEmpty; )
         {
-            if (byte.TryParse(splitTrimmedLine[i], NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var byteVal))
+            var end = line.IndexOfAny(Whitespace);
+            var token = end < 0 ? line : line[..end];
+            line = end < 0 ? [] : line[(end + 1)..];
+            if (token.IsEmpty)
+                continue;
+            if (byte.TryParse(token, NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var byteVal))
             {
                 parsedLine[i] = byteVal;
             }
+            i++;
         }
 
-        return parsedLine;
+        _queue.Enqueue(parsedLine);
     }
+
+    static ReadOnlySpan<byte> Whitespace => " \t\r\f\v"u8;
+
+    static ReadOnlySpan<byte> Utf8Bom => [0xef, 0xbb, 0xbf];
 }
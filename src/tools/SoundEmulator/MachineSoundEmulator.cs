@@ -5,7 +5,7 @@ namespace EMU7800.SoundEmulator;
 
 internal sealed class MachineSoundEmulator : MachineBase
 {
-    public static readonly new MachineSoundEmulator Default = new(1, 0);
+    public static readonly new MachineSoundEmulator Default = new(1, 1, 0);
 
     const ushort
         TIA_BASE   = 0x0000,
@@ -20,16 +20,16 @@ internal sealed class MachineSoundEmulator : MachineBase
     public void PokePokey(byte pokeyRegister, byte value)
         => Mem[(ushort)(POKEY_BASE + pokeyRegister)] = value;
 
-    public override void ComputeNextFrame()
+    protected override void ComputeFrame()
     {
-        base.ComputeNextFrame();
         _tiaSoundDevice.StartFrame();
         _pokeySoundDevice.StartFrame();
         _tiaSoundDevice.EndFrame();
         _pokeySoundDevice.EndFrame();
     }
 
-    MachineSoundEmulator(int freq, int scanlines) : base(NullLogger.Default, scanlines, 0, 0, freq, ReadOnlyMemory<uint>.Empty, 0)
+    // Video is not computed; a one pixel pitch satisfies the frame buffer.
+    MachineSoundEmulator(int freq, int scanlines, int hz) : base(NullLogger.Default, scanlines, 0, hz, freq, ReadOnlyMemory<uint>.Empty, 1)
     {
         _tiaSoundDevice = new TIASoundDeviceWrapper(this);
         _pokeySoundDevice = new PokeySoundDeviceWrapper(this);
@@ -41,8 +41,8 @@ internal sealed class MachineSoundEmulator : MachineBase
     }
 
     public static MachineSoundEmulator CreateForNTSC()
-        => new(31440, 262);
+        => new(31440, 262, 60);
 
     public static MachineSoundEmulator CreateForPAL()
-        => new(31200, 312);
+        => new(31200, 312, 50);
 }
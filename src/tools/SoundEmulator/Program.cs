@@ -1,6 +1,9 @@
 ﻿using EMU7800.SoundEmulator;
 using System;
+using System.Diagnostics;
 using System.IO;
+using System.Threading;
+using System.Threading.Tasks;
 using static System.Console;
 
 AppDomain.CurrentDomain.UnhandledException += CurrentDomainUnhandledException;
@@ -9,6 +12,10 @@ var helpRequested = false;
 var inputTapeFileName = string.Empty;
 var palRegionRequested = false;
 var buffers = 8;
+var waveFileName = string.Empty;
+var tapeDirectory = string.Empty;
+var outputDirectory = string.Empty;
+var parallelism = Environment.ProcessorCount;
 
 foreach (var arg in args)
 {
@@ -34,6 +41,27 @@ foreach (var arg in args)
             return 1;
         }
     }
+    else if (StartsWith(arg, "/w"))
+    {
+        waveFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/d"))
+    {
+        tapeDirectory = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/o"))
+    {
+        outputDirectory = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/p"))
+    {
+        parallelism = GetIntArg(arg, parallelism);
+        if (parallelism < 1)
+        {
+            WriteLine("Parallelism must be at least 1.");
+            return 1;
+        }
+    }
 }
 
 WriteLine(@"
@@ -49,10 +77,26 @@ Usage:
     /f:<filename>         Input tape (required)
     /r:{region}           Region select: NTSC or PAL (default:NTSC)
     /b:{#}                Number of buffers in sound queue (default:8)
+
+  Render offline to 8-bit mono WAV, as fast as possible, instead of playing:
+    /w:<filename>         WAV file to render the input tape to
+    /d:<directory>        Render every input tape (*.txt) in the directory, in parallel
+    /o:<directory>        Output folder for /d (default: alongside each tape)
+    /p:{#}                Number of tapes rendered at once (default: processor count)
 ");
     return 0;
 }
 
+if (!string.IsNullOrWhiteSpace(tapeDirectory))
+{
+    if (!Directory.Exists(tapeDirectory))
+    {
+        WriteLine("Specified input tape directory not found.");
+        return 1;
+    }
+    return RenderDirectory(tapeDirectory, outputDirectory, palRegionRequested, parallelism);
+}
+
 if (string.IsNullOrWhiteSpace(inputTapeFileName))
 {
     WriteLine("Input tape not specified. /h for help.");
@@ -64,6 +108,15 @@ if (!File.Exists(inputTapeFileName))
     return 0;
 }
 
+if (!string.IsNullOrWhiteSpace(waveFileName))
+{
+    var stopwatch = Stopwatch.StartNew();
+    var samples = RenderTape(inputTapeFileName, waveFileName, palRegionRequested);
+    stopwatch.Stop();
+    WriteLine($"Rendered {inputTapeFileName} to {waveFileName}: {samples} samples in {stopwatch.Elapsed.TotalSeconds:0.000}s ({samples / stopwatch.Elapsed.TotalSeconds:0} samples/sec)");
+    return 0;
+}
+
 WriteLine($@"Sound buffer queue size: {buffers}
 Using {(palRegionRequested ? "PAL" : "NTSC")} region 7800 machine configuration for playback.
 Loading input tape: {inputTapeFileName}");
@@ -96,6 +149,58 @@ soundEmulator.WaitUntilStopped();
 
 return 0;
 
+static int RenderDirectory(string tapeDirectory, string outputDirectory, bool palRegionRequested, int parallelism)
+{
+    var tapeFileNames = Directory.GetFiles(tapeDirectory, "*.txt");
+    if (!string.IsNullOrWhiteSpace(outputDirectory))
+    {
+        Directory.CreateDirectory(outputDirectory);
+    }
+
+    WriteLine($"Rendering {tapeFileNames.Length} input tapes from {tapeDirectory} using {(palRegionRequested ? "PAL" : "NTSC")} region, {parallelism} at a time");
+
+    var totalSamples = 0L;
+    var failures = 0;
+    var stopwatch = Stopwatch.StartNew();
+
+    Parallel.ForEach(tapeFileNames, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, tapeFileName =>
+    {
+        var waveFileName = Path.Combine(
+            string.IsNullOrWhiteSpace(outputDirectory) ? Path.GetDirectoryName(tapeFileName) ?? string.Empty : outputDirectory,
+            Path.GetFileNameWithoutExtension(tapeFileName) + ".wav");
+        try
+        {
+            var tapeStopwatch = Stopwatch.StartNew();
+            var samples = RenderTape(tapeFileName, waveFileName, palRegionRequested);
+            tapeStopwatch.Stop();
+            Interlocked.Add(ref totalSamples, samples);
+            WriteLine($"{Path.GetFileName(tapeFileName)}: {samples} samples, {samples / tapeStopwatch.Elapsed.TotalSeconds:0} samples/sec");
+        }
+        catch (Exception ex)
+        {
+            Interlocked.Increment(ref failures);
+            WriteLine($"{Path.GetFileName(tapeFileName)}: {ex.Message}");
+        }
+    });
+
+    stopwatch.Stop();
+    WriteLine($"Rendered {tapeFileNames.Length - failures} of {tapeFileNames.Length} tapes: {totalSamples} samples in {stopwatch.Elapsed.TotalSeconds:0.000}s ({totalSamples / stopwatch.Elapsed.TotalSeconds:0} samples/sec)");
+    return failures > 0 ? 1 : 0;
+}
+
+static long RenderTape(string tapeFileName, string waveFileName, bool palRegionRequested)
+{
+    var inputTapeReader = new InputTapeReader();
+    inputTapeReader.Load(tapeFileName);
+
+    var soundEmulator = new SoundEmulator();
+    var player = new InputTapePlayer(inputTapeReader) { IsEchoOn = false, EndOfTapeReached = soundEmulator.Stop };
+    soundEmulator.GetRegisterSettingsForNextFrame = player.GetRegisterSettingsForNextFrame;
+
+    using var waveStream = new FileStream(waveFileName, FileMode.Create, FileAccess.ReadWrite, FileShare.None, 1 << 16);
+    return soundEmulator.Render(waveStream, palRegionRequested);
+}
+
 static bool StartsWith(string arg, string text)
     => !string.IsNullOrWhiteSpace(arg) && arg.StartsWith(text, StringComparison.OrdinalIgnoreCase);
 
@@ -1,5 +1,7 @@
-﻿using EMU7800.Win32.Interop;
+﻿using EMU7800.Core;
+using EMU7800.Win32.Interop;
 using System;
+using System.IO;
 using System.Threading;
 
 namespace EMU7800.SoundEmulator;
@@ -68,12 +70,48 @@ public class SoundEmulator
         _workerThread.Start();
     }
 
+    /// <summary>
+    /// Renders frames on the calling thread as fast as they can be computed, writing them to a WAV stream
+    /// rather than playing them, until stopped from GetRegisterSettingsForNextFrame.
+    /// </summary>
+    /// <returns>Number of samples rendered.</returns>
+    public long Render(Stream waveStream, bool palRequested)
+    {
+        if (_workerThread.IsAlive)
+            throw new InvalidOperationException("Already started");
+
+        _machine = palRequested ? MachineSoundEmulator.CreateForPAL() : MachineSoundEmulator.CreateForNTSC();
+        _stopRequested = false;
+
+        var sampleFrequency = _machine.SoundSampleFrequency;
+        WaveFile.WriteHeader(waveStream, sampleFrequency, 0);
+
+        var samples = 0L;
+        while (true)
+        {
+            GetRegisterSettingsForNextFrame?.Invoke(this);
+            if (_stopRequested)
+                break;
+
+            _machine.ComputeNextFrame();
+
+            var soundBuffer = _machine.FrameBuffer.SoundBuffer.Span;
+            waveStream.Write(soundBuffer);
+            samples += soundBuffer.Length;
+        }
+
+        waveStream.Position = 0;
+        WaveFile.WriteHeader(waveStream, sampleFrequency, samples);
+
+        return samples;
+    }
+
     public void Stop()
     {
+        _stopRequested = true;
+        _playNoise = false;
         if (_workerThread.IsAlive)
         {
-            _stopRequested = true;
-            _playNoise = false;
             _workerThread.Join();
         }
      }
@@ -0,0 +1,268 @@
+﻿using EMU7800.Core;
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using static System.Console;
+
+AppDomain.CurrentDomain.UnhandledException += CurrentDomainUnhandledException;
+
+var helpRequested = false;
+var romFileName = string.Empty;
+var machineType = MachineType.Unknown;
+var cartType = CartType.Unknown;
+var frames = 60;
+var traceFileName = string.Empty;
+var diffTraceFileName = string.Empty;
+var profileFileName = string.Empty;
+var labelFileName = string.Empty;
+var timeStartupOnly = false;
+var startIndex = 0L;
+var count = 100L;
+
+foreach (var arg in args)
+{
+    if (StartsWith(arg, "/h"))
+    {
+        helpRequested = true;
+    }
+    else if (StartsWith(arg, "/r"))
+    {
+        romFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/m"))
+    {
+        machineType = MachineTypeUtil.From(GetStrArg(arg, string.Empty));
+    }
+    else if (StartsWith(arg, "/c"))
+    {
+        cartType = CartTypeUtil.From(GetStrArg(arg, string.Empty));
+    }
+    else if (StartsWith(arg, "/n"))
+    {
+        frames = GetIntArg(arg, frames);
+        count = frames;
+    }
+    else if (StartsWith(arg, "/f"))
+    {
+        traceFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/d"))
+    {
+        diffTraceFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/p"))
+    {
+        profileFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/l"))
+    {
+        labelFileName = GetStrArg(arg, string.Empty);
+    }
+    else if (StartsWith(arg, "/t"))
+    {
+        timeStartupOnly = true;
+    }
+    else if (StartsWith(arg, "/s"))
+    {
+        startIndex = GetIntArg(arg, 0);
+    }
+}
+
+WriteLine(@"
+EMU7800 TraceTool
+Copyright (c) 2026 Mike Murphy
+");
+
+if (helpRequested || string.IsNullOrWhiteSpace(traceFileName) && string.IsNullOrWhiteSpace(profileFileName) && !timeStartupOnly)
+{
+    WriteLine(@"
+Usage:
+    /h                    Show usage information
+    /f:<filename>         Trace file (required unless profiling or timing)
+
+  Record a trace and/or profile:
+    /r:<filename>         ROM to run headless while recording to the trace file
+    /m:<MachineType>      Machine type (required when recording)
+    /c:<CartType>         Cart type (default: inferred from ROM size)
+    /n:{#}                Number of frames to run (default:60)
+    /p:<filename>         Write a folded-stack CPU profile (flame graph input)
+    /t                    Time TraceTool's own process start to its first emulated frame only;
+                          the apps log their startup time when they emulate their first frame
+    /l:<filename>         Assembler label file used to name profiled code
+
+  Disassemble a trace:
+    /s:{#}                Index of first record to disassemble (default:0)
+    /n:{#}                Number of records to disassemble (default:100)
+
+  Compare two traces:
+    /d:<filename>         Second trace file; reports divergences from the first
+    /n:{#}                Maximum number of divergences to report (default:100)
+");
+    return 0;
+}
+
+if (!string.IsNullOrWhiteSpace(romFileName))
+{
+    return Record(romFileName, machineType, cartType, timeStartupOnly ? 1 : frames, traceFileName, profileFileName, labelFileName);
+}
+if (!File.Exists(traceFileName))
+{
+    WriteLine("Specified trace file not found.");
+    return 1;
+}
+if (!string.IsNullOrWhiteSpace(diffTraceFileName))
+{
+    if (!File.Exists(diffTraceFileName))
+    {
+        WriteLine("Specified trace file to compare not found.");
+        return 1;
+    }
+    return Diff(traceFileName, diffTraceFileName, count);
+}
+return Disassemble(traceFileName, startIndex, count);
+
+static int Record(string romFileName, MachineType machineType, CartType cartType, int frames, string traceFileName, string profileFileName, string labelFileName)
+{
+    if (machineType == MachineType.Unknown)
+    {
+        WriteLine("Machine type not specified. /h for help.");
+        return 1;
+    }
+    if (!File.Exists(romFileName))
+    {
+        WriteLine("Specified ROM file not found.");
+        return 1;
+    }
+    if (!string.IsNullOrWhiteSpace(labelFileName) && !File.Exists(labelFileName))
+    {
+        WriteLine("Specified label file not found.");
+        return 1;
+    }
+
+    const int A78HeaderSize = 128;
+
+    var romBytes = File.ReadAllBytes(romFileName);
+    if (romBytes.Length % 1024 == A78HeaderSize)
+    {
+        romBytes = romBytes[A78HeaderSize..];
+    }
+
+    var cart = Cart.Create(romBytes, cartType);
+    var is7800 = MachineTypeUtil.Is7800(machineType);
+    var controller = is7800 ? Controller.ProLineJoystick : Controller.Joystick;
+    var machine = MachineBase.Create(machineType, cart, Bios7800.Default, controller, controller, NullLogger.Default);
+
+    WriteLine($"Running {frames} frames of {romFileName} ({machineType}, {cart})");
+
+    var tracer = string.IsNullOrWhiteSpace(traceFileName) ? null : new TraceRecorder(traceFileName);
+    var profiler = string.IsNullOrWhiteSpace(profileFileName) ? null : new M6502Profiler();
+
+    var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+    machine.CPU.Tracer = tracer;
+    machine.CPU.Profiler = profiler;
+    machine.ComputeNextFrame();
+    var startupTime = DateTime.Now - System.Diagnostics.Process.GetCurrentProcess().StartTime;
+    for (var i = 1; i < frames && !machine.CPU.Jammed; i++)
+    {
+        machine.ComputeNextFrame();
+    }
+    machine.CPU.Tracer = null;
+    machine.CPU.Profiler = null;
+    tracer?.Dispose();
+    stopwatch.Stop();
+
+    WriteLine($"First frame completed {startupTime.TotalMilliseconds:0.0}ms after TraceTool process start");
+
+    if (tracer is not null)
+    {
+        WriteLine($"Recorded {tracer.RecordCount} instructions to {traceFileName} in {stopwatch.Elapsed.TotalSeconds:0.000}s ({tracer.RecordCount / stopwatch.Elapsed.TotalSeconds / 1e6:0.00}M instr/s, {tracer.Stalls} stalls)");
+    }
+    if (profiler is not null)
+    {
+        var symbols = string.IsNullOrWhiteSpace(labelFileName) ? null : M6502SymbolTable.Load(labelFileName);
+        using (var writer = new StreamWriter(profileFileName))
+        {
+            profiler.WriteFoldedStacks(writer, symbols);
+        }
+        WriteLine($"Wrote profile to {profileFileName}");
+        profiler.WriteReport(Out, 20, symbols);
+    }
+    return 0;
+}
+
+static int Disassemble(string traceFileName, long startIndex, long count)
+{
+    using var reader = new TraceReader(traceFileName);
+    WriteLine($"{reader.RecordCount} records");
+    var endIndex = Math.Min(reader.RecordCount, startIndex + count);
+    for (var i = startIndex; i < endIndex; i++)
+    {
+        WriteLine(ToString(i, reader[i]));
+    }
+    return 0;
+}
+
+static int Diff(string traceFileName1, string traceFileName2, long maxDivergences)
+{
+    using var reader1 = new TraceReader(traceFileName1);
+    using var reader2 = new TraceReader(traceFileName2);
+
+    var buffer1 = new TraceRecord[0x1000];
+    var buffer2 = new TraceRecord[0x1000];
+
+    var divergences = 0L;
+    var index = 0L;
+    while (divergences < maxDivergences)
+    {
+        var read1 = reader1.Read(index, buffer1);
+        var read2 = reader2.Read(index, buffer2);
+        var read = Math.Min(read1, read2);
+        for (var i = 0; i < read && divergences < maxDivergences; i++)
+        {
+            if (!MemoryMarshal.AsBytes(buffer1.AsSpan(i, 1)).SequenceEqual(MemoryMarshal.AsBytes(buffer2.AsSpan(i, 1))))
+            {
+                WriteLine($"< {ToString(index + i, buffer1[i])}");
+                WriteLine($"> {ToString(index + i, buffer2[i])}");
+                divergences++;
+            }
+        }
+        index += read;
+        if (read < buffer1.Length)
+            break;
+    }
+
+    if (divergences == 0 && reader1.RecordCount == reader2.RecordCount)
+    {
+        WriteLine($"Traces are identical ({reader1.RecordCount} records)");
+        return 0;
+    }
+    if (reader1.RecordCount != reader2.RecordCount)
+    {
+        WriteLine($"Trace lengths differ: {reader1.RecordCount} vs {reader2.RecordCount} records");
+    }
+    return 2;
+}
+
+static string ToString(long index, TraceRecord r)
+    => $"{index,10} {r.Clock,12} {r.Bank:x2}:{r.PC:x4}  {M6502DASM.RenderOpCode(r.PC, r.OpCode, r.Operand1, r.Operand2),-15} {M6502DASM.GetRegisters(r)}  bus:{r.BusAddress:x4}={r.BusData:x2}";
+
+static bool StartsWith(string arg, string text)
+    => !string.IsNullOrWhiteSpace(arg) && arg.StartsWith(text, StringComparison.OrdinalIgnoreCase);
+
+static int GetIntArg(string curArg, int defaultValue)
+{
+    var startPos = curArg.IndexOf(":", StringComparison.OrdinalIgnoreCase);
+    return startPos >= 0 ? int.TryParse(curArg[(startPos + 1)..], out var num) ? num : defaultValue : defaultValue;
+}
+
+static string GetStrArg(string curArg, string defaultValue)
+{
+    var startPos = curArg.IndexOf(":", StringComparison.OrdinalIgnoreCase);
+    return startPos >= 0 ? curArg[(startPos + 1)..] : defaultValue;
+}
+
+static void CurrentDomainUnhandledException(object sender, UnhandledExceptionEventArgs e)
+{
+    WriteLine(e.ExceptionObject.ToString());
+    Environment.Exit(1);
+}
@@ -0,0 +1,149 @@
+﻿using EMU7800.Core;
+using EMU7800.Core.Extensions;
+using System;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace EMU7800.VecEnv;
+
+/// <summary>
+/// C entry points of the NativeAOT shared library; see emu7800_vecenv.h. Calls return zero on success
+/// and a negative value (or a null handle) on failure, with the reason available from emu7800_env_last_error.
+/// </summary>
+public static unsafe class NativeExports
+{
+    [ThreadStatic]
+    static string? _lastError;
+
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_create")]
+    public static nint Create(byte* romBytes, int romLength, byte* machineType, byte* cartType, int count, int format, int downsample, int frameSkip, int threadCount)
+    {
+        try
+        {
+            ArgumentException.ThrowIf(romBytes is null || romLength <= 0, "must be specified", nameof(romBytes));
+
+            const int A78HeaderSize = 128;
+
+            var rom = new ReadOnlySpan<byte>(romBytes, romLength);
+            if (rom.Length % 1024 == A78HeaderSize)
+            {
+                rom = rom[A78HeaderSize..];
+            }
+
+            var env = new VectorEnvironment(
+                rom.ToArray(),
+                MachineTypeUtil.From(Marshal.PtrToStringUTF8((nint)machineType) ?? string.Empty),
+                CartTypeUtil.From(Marshal.PtrToStringUTF8((nint)cartType) ?? string.Empty),
+                count, (ObservationFormat)format, downsample, frameSkip, threadCount);
+            return GCHandle.ToIntPtr(GCHandle.Alloc(env));
+        }
+        catch (Exception ex)
+        {
+            _lastError = ex.Message;
+            return 0;
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_destroy")]
+    public static int Destroy(nint handle)
+    {
+        try
+        {
+            var env = FromHandle(handle);
+            env.Dispose();
+            GCHandle.FromIntPtr(handle).Free();
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            _lastError = ex.Message;
+            return -1;
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_observation_shape")]
+    public static int GetObservationShape(nint handle, int* height, int* width, int* channels)
+    {
+        try
+        {
+            ArgumentException.ThrowIf(height is null || width is null || channels is null, "must be specified", nameof(height));
+            var env = FromHandle(handle);
+            *height = env.ObservationHeight;
+            *width = env.ObservationWidth;
+            *channels = env.ObservationChannels;
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            _lastError = ex.Message;
+            return -1;
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_ram_size")]
+    public static int GetRAMSize(nint handle)
+    {
+        try
+        {
+            return FromHandle(handle).RAMSize;
+        }
+        catch (Exception ex)
+        {
+            _lastError = ex.Message;
+            return -1;
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_reset")]
+    public static int Reset(nint handle, byte* mask, byte* observations, byte* ram)
+    {
+        try
+        {
+            FromHandle(handle).Reset(mask, observations, ram);
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            _lastError = ex.Message;
+            return -1;
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_step")]
+    public static int Step(nint handle, uint* actions, byte* observations, byte* ram, byte* halted)
+    {
+        try
+        {
+            FromHandle(handle).Step(actions, observations, ram, halted);
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            _lastError = ex.Message;
+            return -1;
+        }
+    }
+
+    /// <summary>
+    /// Copies the UTF-8 message of the calling thread's last failure into the buffer, truncated and NUL-terminated.
+    /// </summary>
+    /// <returns>Length of the copied message in bytes, excluding the terminator.</returns>
+    [UnmanagedCallersOnly(EntryPoint = "emu7800_env_last_error")]
+    public static int GetLastError(byte* buffer, int length)
+    {
+        if (buffer is null || length <= 0)
+            return 0;
+        var message = Encoding.UTF8.GetBytes(_lastError ?? string.Empty);
+        var written = Math.Min(message.Length, length - 1);
+        message.AsSpan(0, written).CopyTo(new Span<byte>(buffer, written));
+        buffer[written] = 0;
+        return written;
+    }
+
+    static VectorEnvironment FromHandle(nint handle)
+    {
+        ArgumentException.ThrowIf(handle == 0, "must not be null", nameof(handle));
+        return GCHandle.FromIntPtr(handle).Target as VectorEnvironment
+            ?? throw new ArgumentException("not an environment", nameof(handle));
+    }
+}
@@ -0,0 +1,428 @@
+﻿using EMU7800.Core;
+using EMU7800.Core.Extensions;
+using System;
+using System.IO;
+using System.Runtime.ExceptionServices;
+using System.Threading;
+
+namespace EMU7800.VecEnv;
+
+public enum ObservationFormat
+{
+    None,
+    Grayscale,
+    Rgb,
+}
+
+/// <summary>
+/// Joystick and console switch bits of a step action. Player 1 occupies the low byte;
+/// the joystick bits shifted left by <see cref="VectorEnvironment.Player2Shift"/> apply to player 2.
+/// </summary>
+[Flags]
+public enum EnvironmentAction : uint
+{
+    None   = 0,
+    Fire   = 1 << 0,
+    Up     = 1 << 1,
+    Down   = 1 << 2,
+    Left   = 1 << 3,
+    Right  = 1 << 4,
+    Fire2  = 1 << 5,
+    Reset  = 1 << 6,
+    Select = 1 << 7,
+}
+
+/// <summary>
+/// Runs a batch of identical machines in lockstep for reinforcement learning. Each call resets or steps
+/// every machine across a fixed pool of worker threads and writes observations directly into
+/// caller-provided buffers laid out as [environment, row, column, channel], without allocating.
+/// </summary>
+public sealed unsafe class VectorEnvironment : IDisposable
+{
+    public const int Player2Shift = 8;
+
+    const int VisibleScanlines = 230;
+
+    static readonly (EnvironmentAction Action, MachineInput Input)[] JoystickInputs =
+    [
+        (EnvironmentAction.Fire,  MachineInput.Fire),
+        (EnvironmentAction.Up,    MachineInput.Up),
+        (EnvironmentAction.Down,  MachineInput.Down),
+        (EnvironmentAction.Left,  MachineInput.Left),
+        (EnvironmentAction.Right, MachineInput.Right),
+        (EnvironmentAction.Fire2, MachineInput.Fire2),
+    ];
+
+    enum Operation { Reset, Step }
+
+    readonly MachineBase[] _machines;
+    readonly byte[] _initialState;
+    readonly BinaryReader[] _initialStateReaders;
+    readonly uint[] _palette = new uint[0x100];
+    readonly byte[] _luminance = new byte[0x100];
+    readonly byte[][] _priorFrames;
+    readonly int[][] _rowSums;
+    readonly int _pitch, _firstVisibleIndex, _visibleSize;
+
+    readonly Thread[] _workers;
+    readonly object _gate = new();
+    long _generation;
+    int _pending, _nextIndex;
+    bool _disposed;
+    Exception? _failure;
+
+    Operation _operation;
+    byte* _resetMask, _observations, _ram, _halted;
+    uint* _actions;
+
+    public int Count => _machines.Length;
+    public ObservationFormat Format { get; }
+    public int Downsample { get; }
+    public int FrameSkip { get; }
+    public int ObservationHeight { get; }
+    public int ObservationWidth { get; }
+    public int ObservationChannels => Format switch { ObservationFormat.Grayscale => 1, ObservationFormat.Rgb => 3, _ => 0 };
+    public int ObservationSize => ObservationHeight * ObservationWidth * ObservationChannels;
+    public int RAMSize { get; }
+    public int ThreadCount => _workers.Length + 1;
+
+    /// <summary>
+    /// Restores the selected environments to their initial state and writes their first observations.
+    /// Rows of unselected environments are left untouched.
+    /// </summary>
+    /// <param name="mask">One byte per environment, nonzero to reset.</param>
+    /// <param name="observations"><see cref="ObservationSize"/> bytes per environment, or null.</param>
+    /// <param name="ram"><see cref="RAMSize"/> bytes per environment, or null.</param>
+    public void Reset(byte* mask, byte* observations, byte* ram)
+    {
+        ArgumentException.ThrowIf(mask is null, "must be specified", nameof(mask));
+
+        _resetMask = mask;
+        _observations = observations;
+        _ram = ram;
+        _halted = null;
+        Run(Operation.Reset);
+    }
+
+    /// <summary>
+    /// Holds each environment's action for <see cref="FrameSkip"/> frames, then writes the observation
+    /// (max-pooled over the last two frames) and RAM of every environment.
+    /// </summary>
+    /// <param name="actions">One <see cref="EnvironmentAction"/> bit set per environment.</param>
+    /// <param name="observations"><see cref="ObservationSize"/> bytes per environment, or null.</param>
+    /// <param name="ram"><see cref="RAMSize"/> bytes per environment, or null.</param>
+    /// <param name="halted">One byte per environment, set nonzero when the machine has halted or jammed, or null.</param>
+    public void Step(uint* actions, byte* observations, byte* ram, byte* halted)
+    {
+        ArgumentException.ThrowIf(actions is null, "must be specified", nameof(actions));
+
+        _actions = actions;
+        _observations = observations;
+        _ram = ram;
+        _halted = halted;
+        Run(Operation.Step);
+    }
+
+    public void Reset(ReadOnlySpan<byte> mask, Span<byte> observations, Span<byte> ram)
+    {
+        ThrowIfTooShort(mask.Length, 1, nameof(mask));
+        ThrowIfTooShort(observations.Length, ObservationSize, nameof(observations));
+        ThrowIfTooShort(ram.Length, RAMSize, nameof(ram));
+
+        fixed (byte* pMask = mask)
+        fixed (byte* pObservations = observations)
+        fixed (byte* pRam = ram)
+        {
+            Reset(pMask, observations.IsEmpty ? null : pObservations, ram.IsEmpty ? null : pRam);
+        }
+    }
+
+    public void Step(ReadOnlySpan<uint> actions, Span<byte> observations, Span<byte> ram, Span<byte> halted)
+    {
+        ThrowIfTooShort(actions.Length, 1, nameof(actions));
+        ThrowIfTooShort(observations.Length, ObservationSize, nameof(observations));
+        ThrowIfTooShort(ram.Length, RAMSize, nameof(ram));
+        ThrowIfTooShort(halted.Length, 1, nameof(halted));
+
+        fixed (uint* pActions = actions)
+        fixed (byte* pObservations = observations)
+        fixed (byte* pRam = ram)
+        fixed (byte* pHalted = halted)
+        {
+            Step(pActions, observations.IsEmpty ? null : pObservations, ram.IsEmpty ? null : pRam, halted.IsEmpty ? null : pHalted);
+        }
+    }
+
+    public void Dispose()
+    {
+        lock (_gate)
+        {
+            _disposed = true;
+            Monitor.PulseAll(_gate);
+        }
+        foreach (var worker in _workers)
+        {
+            worker.Join();
+        }
+    }
+
+    #region Constructors
+
+    /// <param name="romBytes">Cart image, without any .a78 header.</param>
+    /// <param name="machineType"></param>
+    /// <param name="cartType">Cart type, or <see cref="CartType.Unknown"/> to infer it from the ROM size.</param>
+    /// <param name="count">Number of environments.</param>
+    /// <param name="format">Observation pixel format.</param>
+    /// <param name="downsample">Box filter size applied in both directions to the visible frame.</param>
+    /// <param name="frameSkip">Number of frames each step holds its action.</param>
+    /// <param name="threadCount">Number of threads stepping environments, including the caller; zero for one per processor.</param>
+    public VectorEnvironment(byte[] romBytes, MachineType machineType, CartType cartType, int count, ObservationFormat format, int downsample, int frameSkip, int threadCount)
+    {
+        ArgumentException.ThrowIf(machineType == MachineType.Unknown, "must be specified", nameof(machineType));
+        ArgumentException.ThrowIf(count <= 0, "must be a positive integer", nameof(count));
+        ArgumentException.ThrowIf(downsample <= 0, "must be a positive integer", nameof(downsample));
+        ArgumentException.ThrowIf(frameSkip <= 0, "must be a positive integer", nameof(frameSkip));
+        ArgumentException.ThrowIf(threadCount < 0, "must not be negative", nameof(threadCount));
+
+        var controller = MachineTypeUtil.Is7800(machineType) ? Controller.ProLineJoystick : Controller.Joystick;
+        var machine = MachineBase.Create(machineType, Cart.Create(romBytes, cartType), Bios7800.Default, controller, controller, NullLogger.Default);
+
+        using (var stream = new MemoryStream())
+        {
+            machine.Serialize(new BinaryWriter(stream));
+            _initialState = stream.ToArray();
+        }
+
+        _machines = new MachineBase[count];
+        _initialStateReaders = new BinaryReader[count];
+        for (var i = 0; i < count; i++)
+        {
+            _initialStateReaders[i] = new(new MemoryStream(_initialState, false));
+            _machines[i] = MachineBase.Deserialize(_initialStateReaders[i]);
+        }
+
+        machine.Palette.Span.CopyTo(_palette);
+        for (var i = 0; i < _palette.Length; i++)
+        {
+            var c = _palette[i];
+            _luminance[i] = (byte)((299 * ((c >> 16) & 0xff) + 587 * ((c >> 8) & 0xff) + 114 * (c & 0xff)) / 1000);
+        }
+
+        Format = format;
+        Downsample = downsample;
+        FrameSkip = frameSkip;
+        RAMSize = machine.RAMSize;
+
+        _pitch = machine.FrameBuffer.VisiblePitch;
+        var visibleScanlines = Math.Min(VisibleScanlines, machine.FrameBuffer.Scanlines - machine.FirstScanline);
+        _firstVisibleIndex = machine.FirstScanline * _pitch;
+        _visibleSize = visibleScanlines * _pitch;
+        ObservationHeight = format == ObservationFormat.None ? 0 : visibleScanlines / downsample;
+        ObservationWidth = format == ObservationFormat.None ? 0 : _pitch / downsample;
+
+        _priorFrames = new byte[count][];
+        _rowSums = new int[count][];
+        for (var i = 0; i < count; i++)
+        {
+            _priorFrames[i] = frameSkip > 1 && format != ObservationFormat.None ? new byte[_visibleSize] : [];
+            _rowSums[i] = new int[ObservationWidth * ObservationChannels];
+        }
+
+        if (threadCount == 0)
+        {
+            threadCount = Environment.ProcessorCount;
+        }
+        _workers = new Thread[Math.Min(threadCount, count) - 1];
+        for (var i = 0; i < _workers.Length; i++)
+        {
+            _workers[i] = new Thread(WorkerLoop) { IsBackground = true, Name = $"VecEnv worker {i + 1}" };
+            _workers[i].Start();
+        }
+    }
+
+    #endregion
+
+    #region Helpers
+
+    void Run(Operation operation)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        lock (_gate)
+        {
+            _operation = operation;
+            _nextIndex = -1;
+            _failure = null;
+            _pending = _workers.Length;
+            _generation++;
+            Monitor.PulseAll(_gate);
+        }
+
+        RunEnvironments();
+
+        lock (_gate)
+        {
+            while (_pending > 0)
+            {
+                Monitor.Wait(_gate);
+            }
+        }
+
+        if (_failure is not null)
+        {
+            ExceptionDispatchInfo.Throw(_failure);
+        }
+    }
+
+    void WorkerLoop()
+    {
+        var generation = 0L;
+        while (true)
+        {
+            lock (_gate)
+            {
+                while (_generation == generation && !_disposed)
+                {
+                    Monitor.Wait(_gate);
+                }
+                if (_disposed)
+                    return;
+                generation = _generation;
+            }
+
+            RunEnvironments();
+
+            lock (_gate)
+            {
+                if (--_pending == 0)
+                {
+                    Monitor.PulseAll(_gate);
+                }
+            }
+        }
+    }
+
+    void RunEnvironments()
+    {
+        int i;
+        while ((i = Interlocked.Increment(ref _nextIndex)) < _machines.Length)
+        {
+            try
+            {
+                if (_operation == Operation.Step)
+                {
+                    StepEnvironment(i, _actions[i]);
+                }
+                else if (_resetMask[i] != 0)
+                {
+                    RestoreInitialState(i);
+                    StepEnvironment(i, 0);
+                }
+            }
+            catch (Exception ex)
+            {
+                Interlocked.CompareExchange(ref _failure, ex, null);
+            }
+        }
+    }
+
+    void StepEnvironment(int i, uint action)
+    {
+        var machine = _machines[i];
+        ApplyAction(machine.InputState, action);
+
+        for (var frame = 0; frame < FrameSkip; frame++)
+        {
+            machine.ComputeNextFrame();
+            if (frame == FrameSkip - 2 && _priorFrames[i].Length > 0)
+            {
+                machine.FrameBuffer.VideoBuffer.Span.Slice(_firstVisibleIndex, _visibleSize).CopyTo(_priorFrames[i]);
+            }
+        }
+
+        if (_observations is not null && Format != ObservationFormat.None)
+        {
+            WriteObservation(i, new Span<byte>(_observations + (long)i * ObservationSize, ObservationSize));
+        }
+        if (_ram is not null)
+        {
+            machine.CopyRAM(new Span<byte>(_ram + (long)i * RAMSize, RAMSize));
+        }
+        if (_halted is not null)
+        {
+            _halted[i] = (byte)(machine.MachineHalt || machine.CPU.Jammed ? 1 : 0);
+        }
+    }
+
+    static void ApplyAction(InputState inputState, uint action)
+    {
+        for (var playerNo = 0; playerNo < 2; playerNo++)
+        {
+            var bits = (EnvironmentAction)(action >> (playerNo * Player2Shift));
+            foreach (var (a, input) in JoystickInputs)
+            {
+                inputState.RaiseInput(playerNo, input, (bits & a) != 0);
+            }
+        }
+        inputState.RaiseInput(0, MachineInput.Reset, ((EnvironmentAction)action & EnvironmentAction.Reset) != 0);
+        inputState.RaiseInput(0, MachineInput.Select, ((EnvironmentAction)action & EnvironmentAction.Select) != 0);
+    }
+
+    /// <summary>
+    /// Converts the visible frame to the observation format, taking the per-channel maximum with the
+    /// prior frame to remove sprite flicker, then box filters it down to the observation size.
+    /// </summary>
+    void WriteObservation(int i, Span<byte> observation)
+    {
+        ReadOnlySpan<byte> frame = _machines[i].FrameBuffer.VideoBuffer.Span.Slice(_firstVisibleIndex, _visibleSize);
+        ReadOnlySpan<byte> prior = _priorFrames[i].Length > 0 ? _priorFrames[i] : frame;
+        var sums = _rowSums[i];
+        var ds = Downsample;
+        var area = ds * ds;
+
+        for (int oy = 0, di = 0; oy < ObservationHeight; oy++)
+        {
+            Array.Clear(sums);
+            for (var y = oy * ds; y < (oy + 1) * ds; y++)
+            {
+                var row = frame.Slice(y * _pitch, ObservationWidth * ds);
+                var priorRow = prior.Slice(y * _pitch, ObservationWidth * ds);
+                if (Format == ObservationFormat.Grayscale)
+                {
+                    for (var x = 0; x < row.Length; x++)
+                    {
+                        sums[x / ds] += Math.Max(_luminance[row[x]], _luminance[priorRow[x]]);
+                    }
+                }
+                else
+                {
+                    for (var x = 0; x < row.Length; x++)
+                    {
+                        uint c = _palette[row[x]], p = _palette[priorRow[x]];
+                        var si = x / ds * 3;
+                        sums[si]     += (int)Math.Max((c >> 16) & 0xff, (p >> 16) & 0xff);
+                        sums[si + 1] += (int)Math.Max((c >> 8) & 0xff, (p >> 8) & 0xff);
+                        sums[si + 2] += (int)Math.Max(c & 0xff, p & 0xff);
+                    }
+                }
+            }
+            for (var k = 0; k < sums.Length; k++)
+            {
+                observation[di++] = (byte)(sums[k] / area);
+            }
+        }
+    }
+
+    // Restores in place, so a reset reuses the machine, its frame buffer and ROM rather than building new ones.
+    void RestoreInitialState(int i)
+    {
+        var reader = _initialStateReaders[i];
+        reader.BaseStream.Position = 0;
+        _machines[i].Restore(reader);
+    }
+
+    void ThrowIfTooShort(int length, int bytesPerEnvironment, string paramName)
+        => ArgumentException.ThrowIf(length > 0 && length < bytesPerEnvironment * (long)Count, "too short for the number of environments", paramName);
+
+    #endregion
+}
@@ -0,0 +1,74 @@
+/*
+ * emu7800_vecenv.h
+ *
+ * C interface to the EMU7800 vectorized environment shared library (NativeAOT publish of
+ * EMU7800.VecEnv). Each call resets or steps every environment across the library's worker
+ * threads, writing directly into caller-owned C-contiguous buffers such as NumPy arrays:
+ *
+ *   observations  uint8[count][height][width][channels]
+ *   ram           uint8[count][ram_size]
+ *   actions       uint32[count]
+ *   mask, halted  uint8[count]
+ *
+ * Any output buffer may be NULL to skip it. From Python, load with ctypes.CDLL and pass
+ * array.ctypes.data for each buffer.
+ *
+ * Copyright © 2026 Mike Murphy
+ *
+ */
+#ifndef EMU7800_VECENV_H
+#define EMU7800_VECENV_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum emu7800_observation_format {
+    EMU7800_OBSERVATION_NONE      = 0,
+    EMU7800_OBSERVATION_GRAYSCALE = 1,
+    EMU7800_OBSERVATION_RGB       = 2,
+};
+
+/* Action bits for player 1; shift left by EMU7800_ACTION_PLAYER2_SHIFT for player 2 (joystick bits only). */
+enum emu7800_action {
+    EMU7800_ACTION_FIRE   = 1 << 0,
+    EMU7800_ACTION_UP     = 1 << 1,
+    EMU7800_ACTION_DOWN   = 1 << 2,
+    EMU7800_ACTION_LEFT   = 1 << 3,
+    EMU7800_ACTION_RIGHT  = 1 << 4,
+    EMU7800_ACTION_FIRE2  = 1 << 5,
+    EMU7800_ACTION_RESET  = 1 << 6,
+    EMU7800_ACTION_SELECT = 1 << 7,
+};
+
+#define EMU7800_ACTION_PLAYER2_SHIFT 8
+
+/*
+ * machine_type: e.g. "A2600NTSC", "A7800NTSC"; cart_type: e.g. "A4K", or "" to infer from the ROM size.
+ * downsample: box filter size; frame_skip: frames per step, observations max-pooled over the last two;
+ * thread_count: 0 for one per processor. Returns NULL on failure.
+ */
+void *emu7800_env_create(const uint8_t *rom, int32_t rom_length, const char *machine_type, const char *cart_type,
+                         int32_t count, int32_t format, int32_t downsample, int32_t frame_skip, int32_t thread_count);
+
+int32_t emu7800_env_destroy(void *env);
+
+int32_t emu7800_env_observation_shape(void *env, int32_t *height, int32_t *width, int32_t *channels);
+
+int32_t emu7800_env_ram_size(void *env);
+
+/* Restores the environments selected by nonzero mask bytes and writes only their rows. */
+int32_t emu7800_env_reset(void *env, const uint8_t *mask, uint8_t *observations, uint8_t *ram);
+
+int32_t emu7800_env_step(void *env, const uint32_t *actions, uint8_t *observations, uint8_t *ram, uint8_t *halted);
+
+/* Copies the calling thread's last failure message; calls above return negative values (or NULL) on failure. */
+int32_t emu7800_env_last_error(char *buffer, int32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
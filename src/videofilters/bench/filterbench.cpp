@@ -0,0 +1,93 @@
+// © Mike Murphy
+
+// Reports the throughput of each filter, in output megapixels per second, single threaded and
+// with the default thread count, on a synthetic 320x230 frame of the size the shell renders.
+//
+// Usage: emu7800_filterbench [seconds per measurement] [thread count]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "videofilters.h"
+
+namespace {
+
+const int Width = 320, Height = 230;
+
+const struct { int32_t type; const char* name; } Filters[] =
+{
+    { EMU7800_FILTER_NONE,      "none" },
+    { EMU7800_FILTER_SCALE2X,   "scale2x" },
+    { EMU7800_FILTER_HQ2X,      "hq2x" },
+    { EMU7800_FILTER_SCANLINES, "scanlines" },
+    { EMU7800_FILTER_CRT,       "crt" },
+    { EMU7800_FILTER_NTSC,      "ntsc" },
+};
+
+// Large flat color areas with diagonal edges, like a playfield with sprites.
+std::vector<uint32_t> MakeFrame()
+{
+    const uint32_t palette[] = { 0x000000, 0x1c3c9c, 0x5cb85c, 0xd0d0d0, 0xb84c4c, 0x9c7cf0, 0xf0e068, 0x404040 };
+    std::vector<uint32_t> frame((size_t)Width * Height);
+    for (int y = 0; y < Height; y++)
+        for (int x = 0; x < Width; x++)
+            frame[(size_t)y * Width + x] = palette[((x + y) / 12 + (x * 3 - y) / 20 + (y / 7 & 1)) & 7];
+    return frame;
+}
+
+double Measure(int32_t type, int threads, const std::vector<uint32_t>& frame, double seconds)
+{
+    void* filter = emu7800_filter_create(type, Width, Height, threads);
+    if (!filter)
+        return 0;
+    int32_t outWidth = 0, outHeight = 0;
+    emu7800_filter_output_size(filter, &outWidth, &outHeight);
+
+    const uint8_t* input = (const uint8_t*)frame.data();
+    for (int i = 0; i < 10; i++)
+        emu7800_filter_apply(filter, input, Width * 4);
+
+    using clock = std::chrono::steady_clock;
+    long frames = 0;
+    auto start = clock::now();
+    double elapsed;
+    do
+    {
+        for (int i = 0; i < 10; i++)
+            emu7800_filter_apply(filter, input, Width * 4);
+        frames += 10;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    while (elapsed < seconds);
+
+    emu7800_filter_destroy(filter);
+    return (double)frames * outWidth * outHeight / elapsed / 1e6;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 1.0;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    if (seconds <= 0)
+        seconds = 1.0;
+
+    auto frame = MakeFrame();
+    unsigned processors = std::thread::hardware_concurrency();
+
+    printf("EMU7800 video filter benchmark: %dx%d input, %u processors\n\n", Width, Height, processors);
+    printf("%-10s %14s %14s %14s\n", "filter", "1 thread MP/s", "N thread MP/s", "frames/s (N)");
+    for (const auto& f : Filters)
+    {
+        double single = Measure(f.type, 1, frame, seconds);
+        double multi = Measure(f.type, threads, frame, seconds);
+        int scale = f.type == EMU7800_FILTER_NONE ? 1 : 2;
+        printf("%-10s %14.1f %14.1f %14.0f\n", f.name, single, multi, multi * 1e6 / (Width * scale * Height * scale));
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+// © Mike Murphy
+
+// Scanlines and the CRT look. Each input row becomes a full-brightness line of doubled pixels
+// followed by a darker line blending it with the row below, as the gap between beam passes on
+// a tube. The CRT filter then weights every output column toward red, green or blue in turn,
+// the stripes of an aperture grille.
+
+#include "filters.h"
+#include "simd.h"
+
+namespace vf {
+
+namespace {
+
+// Per-channel brightness of the in-between line, out of 256.
+const uint32_t ScanlineWeight = 0x00a0a0a0;
+
+// Aperture grille stripes: the favored channel at full strength, the others dimmed.
+const uint32_t MaskWeights[3] = { 0x00c0c0ff, 0x00c0ffc0, 0x00ffc0c0 };
+
+// Channel arithmetic matching avg4 and scale4, for the pixels left over after the vector loop.
+inline uint32_t Avg(uint32_t a, uint32_t b)
+{
+    return (a | b) - (((a ^ b) >> 1) & 0x7f7f7f7f);
+}
+
+inline uint32_t Scale(uint32_t a, uint32_t weight)
+{
+    uint32_t r = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        r |= ((((a >> shift) & 0xff) * ((weight >> shift) & 0xff)) >> 8) << shift;
+    return r;
+}
+
+template <bool Masked>
+void LineRows(FilterContext& c, int y0, int y1)
+{
+    const uint32_t* padded = c.padded.data();
+    const uint32_t* mask = c.mask.data();
+    const int pp = c.paddedPitch, w = c.width, ow = c.outWidth;
+    const v4p weight = splat4(ScanlineWeight);
+
+    for (int y = y0; y < y1; y++)
+    {
+        const uint32_t* row = padded + (y + 1) * pp + 1;
+        const uint32_t* below = row + pp;
+        uint32_t* o0 = c.output.data() + (size_t)(2 * y) * ow;
+        uint32_t* o1 = o0 + ow;
+
+        int x = 0;
+        for (; x + 4 <= w; x += 4)
+        {
+            v4p E = load4(row + x);
+            v4p S = scale4(avg4(E, load4(below + x)), weight);
+
+            v4p lo, hi, slo, shi;
+            zip4(E, E, lo, hi);
+            zip4(S, S, slo, shi);
+            if (Masked)
+            {
+                v4p mlo = load4(mask + 2 * x), mhi = load4(mask + 2 * x + 4);
+                lo = scale4(lo, mlo);
+                hi = scale4(hi, mhi);
+                slo = scale4(slo, mlo);
+                shi = scale4(shi, mhi);
+            }
+            store4(o0 + 2 * x, lo);
+            store4(o0 + 2 * x + 4, hi);
+            store4(o1 + 2 * x, slo);
+            store4(o1 + 2 * x + 4, shi);
+        }
+
+        for (; x < w; x++)
+        {
+            uint32_t E = row[x];
+            uint32_t S = Scale(Avg(E, below[x]), ScanlineWeight);
+            for (int i = 0; i < 2; i++)
+            {
+                int ox = 2 * x + i;
+                o0[ox] = Masked ? Scale(E, mask[ox]) : E;
+                o1[ox] = Masked ? Scale(S, mask[ox]) : S;
+            }
+        }
+    }
+}
+
+}
+
+void InitCrt(FilterContext& c)
+{
+    c.mask.resize(c.outWidth);
+    for (int x = 0; x < c.outWidth; x++)
+        c.mask[x] = MaskWeights[x % 3];
+}
+
+void ScanlineRows(FilterContext& c, int y0, int y1)
+{
+    LineRows<false>(c, y0, y1);
+}
+
+void CrtRows(FilterContext& c, int y0, int y1)
+{
+    LineRows<true>(c, y0, y1);
+}
+
+}
@@ -0,0 +1,66 @@
+// © Mike Murphy
+
+// Filter state shared by the kernels. Each kernel renders the output rows of input rows
+// [y0, y1) and may run concurrently with itself on other bands.
+
+#ifndef FILTERS_H
+#define FILTERS_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "threadpool.h"
+
+namespace vf {
+
+struct FilterContext
+{
+    int filter;
+    int width, height;          // input
+    int outWidth, outHeight;
+
+    // Input copy with a one pixel border replicated from the edges, so kernels read neighbors
+    // without bounds checks. Row y, column x of the frame is at padded[(y + 1) * paddedPitch + x + 1].
+    int paddedPitch;
+    std::vector<uint32_t> padded;
+    std::vector<uint32_t> paddedYuv;    // HQ2X: padded in packed Y, U, V for similarity tests
+
+    std::vector<uint32_t> output;
+
+    std::vector<uint32_t> mask;         // CRT: phosphor weights per output column
+
+    // NTSC: FIR taps and a private row of planar samples per band.
+    std::vector<float> lumaTaps, iTaps, qTaps;
+    std::vector<float> carrierI, carrierQ;
+    int ntscStride;
+    std::vector<float> ntscScratch;
+
+    unsigned frame;
+    int bandRows, bandCount;
+    ThreadPool pool;
+
+    FilterContext(int filter, int width, int height, int threadCount);
+};
+
+void Scale2xRows(FilterContext& c, int y0, int y1);
+void Hq2xRows(FilterContext& c, int y0, int y1);
+void ScanlineRows(FilterContext& c, int y0, int y1);
+void CrtRows(FilterContext& c, int y0, int y1);
+void NtscRows(FilterContext& c, int band, int y0, int y1);
+
+void InitCrt(FilterContext& c);
+void InitNtsc(FilterContext& c);
+
+// Packs the hqx Y, U, V of a BGR32 pixel into the low three bytes.
+inline uint32_t ToYuv(uint32_t p)
+{
+    int b = p & 0xff, g = (p >> 8) & 0xff, r = (p >> 16) & 0xff;
+    int y = (r * 77 + g * 150 + b * 29) >> 8;
+    int u = ((-r * 43 - g * 85 + b * 128) >> 8) + 128;
+    int v = ((r * 128 - g * 107 - b * 21) >> 8) + 128;
+    return (uint32_t)y | (uint32_t)u << 8 | (uint32_t)v << 16;
+}
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+// © Mike Murphy
+
+// Composite video approximation. Each row is sampled at twice the horizontal resolution,
+// converted to YIQ, and each component is low-pass filtered to about the bandwidth a
+// composite signal leaves it: luma stays sharp, I bleeds across a few pixels and Q across
+// more, so colors smear past edges the way they do on a television. The filtered chroma is
+// then modulated back into luma on a subcarrier whose phase alternates by line and frame,
+// giving the fine crawling dots along colored edges. Lines are doubled, the second slightly
+// darker.
+
+#include <math.h>
+#include <initializer_list>
+
+#include "filters.h"
+#include "simd.h"
+
+namespace vf {
+
+namespace {
+
+const int Radius = 6;
+const int Taps = 2 * Radius + 1;
+
+const float LumaSigma = 0.6f, ISigma = 1.6f, QSigma = 2.6f;
+const float Crosstalk = 0.08f;
+const float SubcarrierPeriod = 4.0f;    // samples
+const uint32_t SecondLineWeight = 0x00d8d8d8;
+
+void GaussianTaps(std::vector<float>& taps, float sigma)
+{
+    taps.resize(Taps);
+    float sum = 0;
+    for (int i = 0; i < Taps; i++)
+        sum += taps[i] = expf(-(float)((i - Radius) * (i - Radius)) / (2 * sigma * sigma));
+    for (auto& tap : taps)
+        tap /= sum;
+}
+
+// out[k] = sum of taps[j] * in[k + j]; in is padded by Radius on either side.
+void Convolve(const float* in, float* out, const float* taps, int count)
+{
+    for (int k = 0; k < count; k += 4)
+    {
+        v4f acc = splatf(0);
+        for (int j = 0; j < Taps; j++)
+            acc = maddf(acc, splatf(taps[j]), loadf(in + k + j));
+        storef(out + k, acc);
+    }
+}
+
+inline uint32_t Clamp8(float x)
+{
+    return x <= 0 ? 0u : x >= 255 ? 255u : (uint32_t)(x + 0.5f);
+}
+
+}
+
+void InitNtsc(FilterContext& c)
+{
+    GaussianTaps(c.lumaTaps, LumaSigma);
+    GaussianTaps(c.iTaps, ISigma);
+    GaussianTaps(c.qTaps, QSigma);
+
+    // Six planes per band: Y, I, Q padded for the filters, then filtered Y, I, Q. The vector
+    // loops round the sample count up to a multiple of four.
+    int samples = c.outWidth;
+    c.ntscStride = ((samples + 2 * Radius + 3) & ~3) + 4;
+    c.ntscScratch.assign((size_t)c.ntscStride * 6 * c.bandCount, 0.0f);
+
+    const float pi = 3.14159265f;
+    c.carrierI.resize(c.ntscStride);
+    c.carrierQ.resize(c.ntscStride);
+    for (int k = 0; k < c.ntscStride; k++)
+    {
+        c.carrierI[k] = cosf(2 * pi * k / SubcarrierPeriod) * Crosstalk;
+        c.carrierQ[k] = sinf(2 * pi * k / SubcarrierPeriod) * Crosstalk;
+    }
+}
+
+void NtscRows(FilterContext& c, int band, int y0, int y1)
+{
+    const int n = c.outWidth, w = c.width, stride = c.ntscStride;
+    float* planeY = c.ntscScratch.data() + (size_t)band * stride * 6;
+    float* planeI = planeY + stride;
+    float* planeQ = planeI + stride;
+    float* filteredY = planeQ + stride;
+    float* filteredI = filteredY + stride;
+    float* filteredQ = filteredI + stride;
+    const v4p dim = splat4(SecondLineWeight);
+
+    for (int y = y0; y < y1; y++)
+    {
+        const uint32_t* row = c.padded.data() + (y + 1) * c.paddedPitch + 1;
+
+        for (int x = 0; x < w; x++)
+        {
+            uint32_t p = row[x];
+            float b = (float)(p & 0xff), g = (float)((p >> 8) & 0xff), r = (float)((p >> 16) & 0xff);
+            float ly = 0.299f * r + 0.587f * g + 0.114f * b;
+            float li = 0.596f * r - 0.274f * g - 0.322f * b;
+            float lq = 0.211f * r - 0.523f * g + 0.312f * b;
+            int k = Radius + 2 * x;
+            planeY[k] = planeY[k + 1] = ly;
+            planeI[k] = planeI[k + 1] = li;
+            planeQ[k] = planeQ[k + 1] = lq;
+        }
+        for (float* plane : { planeY, planeI, planeQ })
+        {
+            for (int k = 0; k < Radius; k++)
+                plane[k] = plane[Radius];
+            for (int k = Radius + n; k < stride; k++)
+                plane[k] = plane[Radius + n - 1];
+        }
+
+        Convolve(planeY, filteredY, c.lumaTaps.data(), n);
+        Convolve(planeI, filteredI, c.iTaps.data(), n);
+        Convolve(planeQ, filteredQ, c.qTaps.data(), n);
+
+        // The subcarrier inverts phase on alternate lines and frames.
+        const v4f phase = splatf(((y + c.frame) & 1) ? -1.0f : 1.0f);
+        uint32_t* o0 = c.output.data() + (size_t)(2 * y) * n;
+        uint32_t* o1 = o0 + n;
+
+        int k = 0;
+        for (; k + 4 <= n; k += 4)
+        {
+            v4f vi = loadf(filteredI + k), vq = loadf(filteredQ + k);
+            v4f chroma = maddf(mulf(vi, loadf(c.carrierI.data() + k)), vq, loadf(c.carrierQ.data() + k));
+            v4f vy = maddf(loadf(filteredY + k), chroma, phase);
+
+            float r[4], g[4], b[4];
+            storef(r, maddf(maddf(vy, vi, splatf(0.956f)), vq, splatf(0.621f)));
+            storef(g, maddf(maddf(vy, vi, splatf(-0.272f)), vq, splatf(-0.647f)));
+            storef(b, maddf(maddf(vy, vi, splatf(-1.106f)), vq, splatf(1.703f)));
+
+            uint32_t pixels[4];
+            for (int i = 0; i < 4; i++)
+                pixels[i] = Clamp8(b[i]) | Clamp8(g[i]) << 8 | Clamp8(r[i]) << 16;
+            v4p v = load4(pixels);
+            store4(o0 + k, v);
+            store4(o1 + k, scale4(v, dim));
+        }
+        for (; k < n; k++)
+        {
+            float vi = filteredI[k], vq = filteredQ[k];
+            float vy = filteredY[k] + (vi * c.carrierI[k] + vq * c.carrierQ[k]) * (((y + c.frame) & 1) ? -1.0f : 1.0f);
+            uint32_t p = Clamp8(vy - 1.106f * vi + 1.703f * vq)
+                | Clamp8(vy - 0.272f * vi - 0.647f * vq) << 8
+                | Clamp8(vy + 0.956f * vi + 0.621f * vq) << 16;
+            o0[k] = p;
+            uint32_t d = 0;
+            for (int shift = 0; shift < 24; shift += 8)
+                d |= ((((p >> shift) & 0xff) * ((SecondLineWeight >> shift) & 0xff)) >> 8) << shift;
+            o1[k] = d;
+        }
+    }
+}
+
+}
@@ -0,0 +1,157 @@
+// © Mike Murphy
+
+// Scale2x (AdvMAME2x) and a lighter take on hq2x. Around each pixel E:
+//
+//     B          E0 E1
+//   D E F   ->   E2 E3
+//     H
+//
+// scale2x copies a neighbor into a corner when the two neighbors meeting at that corner match
+// and the opposite ones do not, rounding off staircase edges. The hq2x variant decides "match"
+// with the hqx YUV thresholds instead of exact equality, so dithered and shaded edges round off
+// too, and it blends the corner with E rather than replacing it. The full hqx rule table, which
+// also looks at the diagonal neighbors, is not implemented.
+
+#include "filters.h"
+#include "simd.h"
+
+namespace vf {
+
+namespace {
+
+// Threshold per channel of a packed Y, U, V: 0x30 luma, 7 U, 6 V.
+const uint32_t YuvThreshold = 0x00060730;
+
+struct ExactMatch
+{
+    explicit ExactMatch(const FilterContext&) {}
+    v4p Match4(int, int, v4p a, v4p b) const { return eq4(a, b); }
+    bool Match(int, int, uint32_t a, uint32_t b) const { return a == b; }
+};
+
+// Compares the YUV plane at the same positions as the pixels.
+struct YuvMatch
+{
+    const uint32_t* yuv;
+    v4p threshold;
+
+    explicit YuvMatch(const FilterContext& c) : yuv(c.paddedYuv.data()), threshold(splat4(YuvThreshold)) {}
+    v4p Match4(int ia, int ib, v4p, v4p) const { return near4(load4(yuv + ia), load4(yuv + ib), threshold); }
+    bool Match(int ia, int ib, uint32_t, uint32_t) const
+    {
+        uint32_t a = yuv[ia], b = yuv[ib];
+        for (int shift = 0; shift < 24; shift += 8)
+        {
+            int d = (int)((a >> shift) & 0xff) - (int)((b >> shift) & 0xff);
+            if ((d < 0 ? -d : d) > (int)((YuvThreshold >> shift) & 0xff))
+                return false;
+        }
+        return true;
+    }
+};
+
+inline uint32_t Avg(uint32_t a, uint32_t b)
+{
+    // Rounded per-channel average, matching avg4.
+    return (a | b) - (((a ^ b) >> 1) & 0x7f7f7f7f);
+}
+
+// Blend: false replaces a corner with its matching neighbor, true averages E with the two
+// neighbors meeting there, 2:1:1.
+template <class Matcher, bool Blend>
+void ScaleRows(FilterContext& c, int y0, int y1)
+{
+    const uint32_t* padded = c.padded.data();
+    const int pp = c.paddedPitch, w = c.width, ow = c.outWidth;
+    Matcher m(c);
+
+    for (int y = y0; y < y1; y++)
+    {
+        // Padded indices of B, E and H for column 0.
+        const int ib = y * pp + 1, ie = ib + pp, ih = ie + pp;
+        uint32_t* o0 = c.output.data() + (size_t)(2 * y) * ow;
+        uint32_t* o1 = o0 + ow;
+
+        int x = 0;
+        for (; x + 4 <= w; x += 4)
+        {
+            v4p B = load4(padded + ib + x), H = load4(padded + ih + x);
+            v4p D = load4(padded + ie + x - 1), E = load4(padded + ie + x), F = load4(padded + ie + x + 1);
+
+            v4p db = m.Match4(ie + x - 1, ib + x, D, B);
+            v4p bf = m.Match4(ib + x, ie + x + 1, B, F);
+            v4p dh = m.Match4(ie + x - 1, ih + x, D, H);
+            v4p hf = m.Match4(ih + x, ie + x + 1, H, F);
+
+            v4p c0 = andnot4(or4(bf, dh), db);
+            v4p c1 = andnot4(or4(db, hf), bf);
+            v4p c2 = andnot4(or4(db, hf), dh);
+            v4p c3 = andnot4(or4(dh, bf), hf);
+
+            v4p e0, e1, e2, e3;
+            if (Blend)
+            {
+                e0 = select4(c0, avg4(E, avg4(B, D)), E);
+                e1 = select4(c1, avg4(E, avg4(B, F)), E);
+                e2 = select4(c2, avg4(E, avg4(D, H)), E);
+                e3 = select4(c3, avg4(E, avg4(H, F)), E);
+            }
+            else
+            {
+                e0 = select4(c0, D, E);
+                e1 = select4(c1, F, E);
+                e2 = select4(c2, D, E);
+                e3 = select4(c3, F, E);
+            }
+
+            v4p lo, hi;
+            zip4(e0, e1, lo, hi);
+            store4(o0 + 2 * x, lo);
+            store4(o0 + 2 * x + 4, hi);
+            zip4(e2, e3, lo, hi);
+            store4(o1 + 2 * x, lo);
+            store4(o1 + 2 * x + 4, hi);
+        }
+
+        for (; x < w; x++)
+        {
+            uint32_t B = padded[ib + x], H = padded[ih + x];
+            uint32_t D = padded[ie + x - 1], E = padded[ie + x], F = padded[ie + x + 1];
+
+            bool db = m.Match(ie + x - 1, ib + x, D, B);
+            bool bf = m.Match(ib + x, ie + x + 1, B, F);
+            bool dh = m.Match(ie + x - 1, ih + x, D, H);
+            bool hf = m.Match(ih + x, ie + x + 1, H, F);
+
+            bool c0 = db && !bf && !dh, c1 = bf && !db && !hf, c2 = dh && !db && !hf, c3 = hf && !dh && !bf;
+            if (Blend)
+            {
+                o0[2 * x]     = c0 ? Avg(E, Avg(B, D)) : E;
+                o0[2 * x + 1] = c1 ? Avg(E, Avg(B, F)) : E;
+                o1[2 * x]     = c2 ? Avg(E, Avg(D, H)) : E;
+                o1[2 * x + 1] = c3 ? Avg(E, Avg(H, F)) : E;
+            }
+            else
+            {
+                o0[2 * x]     = c0 ? D : E;
+                o0[2 * x + 1] = c1 ? F : E;
+                o1[2 * x]     = c2 ? D : E;
+                o1[2 * x + 1] = c3 ? F : E;
+            }
+        }
+    }
+}
+
+}
+
+void Scale2xRows(FilterContext& c, int y0, int y1)
+{
+    ScaleRows<ExactMatch, false>(c, y0, y1);
+}
+
+void Hq2xRows(FilterContext& c, int y0, int y1)
+{
+    ScaleRows<YuvMatch, true>(c, y0, y1);
+}
+
+}
@@ -0,0 +1,185 @@
+// © Mike Murphy
+
+// Minimal four-lane vector types over SSE2 (x64), NEON (arm64), or plain C++ elsewhere.
+// v4p holds four BGR32 pixels, v4f four floats.
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VF_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define VF_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace vf {
+
+#if VF_SSE2
+
+typedef __m128i v4p;
+typedef __m128 v4f;
+
+inline v4p load4(const uint32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+inline void store4(uint32_t* p, v4p v) { _mm_storeu_si128((__m128i*)p, v); }
+inline v4p splat4(uint32_t x) { return _mm_set1_epi32((int)x); }
+
+// All ones in lanes where the pixels are equal.
+inline v4p eq4(v4p a, v4p b) { return _mm_cmpeq_epi32(a, b); }
+inline v4p and4(v4p a, v4p b) { return _mm_and_si128(a, b); }
+inline v4p or4(v4p a, v4p b) { return _mm_or_si128(a, b); }
+inline v4p andnot4(v4p a, v4p b) { return _mm_andnot_si128(a, b); }          // ~a & b
+inline v4p select4(v4p mask, v4p a, v4p b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+
+// Rounded per-channel average.
+inline v4p avg4(v4p a, v4p b) { return _mm_avg_epu8(a, b); }
+
+// All ones in lanes where every channel differs by no more than the corresponding channel of the threshold.
+inline v4p near4(v4p a, v4p b, v4p threshold)
+{
+    __m128i diff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+    return _mm_cmpeq_epi32(_mm_subs_epu8(diff, threshold), _mm_setzero_si128());
+}
+
+// Per-channel (a * weight) >> 8.
+inline v4p scale4(v4p a, v4p weight)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(weight, zero)), 8);
+    __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(weight, zero)), 8);
+    return _mm_packus_epi16(lo, hi);
+}
+
+// Interleaves lanes: lo = a0 b0 a1 b1, hi = a2 b2 a3 b3.
+inline void zip4(v4p a, v4p b, v4p& lo, v4p& hi) { lo = _mm_unpacklo_epi32(a, b); hi = _mm_unpackhi_epi32(a, b); }
+
+inline v4f loadf(const float* p) { return _mm_loadu_ps(p); }
+inline void storef(float* p, v4f v) { _mm_storeu_ps(p, v); }
+inline v4f splatf(float x) { return _mm_set1_ps(x); }
+inline v4f addf(v4f a, v4f b) { return _mm_add_ps(a, b); }
+inline v4f mulf(v4f a, v4f b) { return _mm_mul_ps(a, b); }
+inline v4f maddf(v4f acc, v4f a, v4f b) { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+
+#elif VF_NEON
+
+typedef uint32x4_t v4p;
+typedef float32x4_t v4f;
+
+inline v4p load4(const uint32_t* p) { return vld1q_u32(p); }
+inline void store4(uint32_t* p, v4p v) { vst1q_u32(p, v); }
+inline v4p splat4(uint32_t x) { return vdupq_n_u32(x); }
+
+inline v4p eq4(v4p a, v4p b) { return vceqq_u32(a, b); }
+inline v4p and4(v4p a, v4p b) { return vandq_u32(a, b); }
+inline v4p or4(v4p a, v4p b) { return vorrq_u32(a, b); }
+inline v4p andnot4(v4p a, v4p b) { return vbicq_u32(b, a); }
+inline v4p select4(v4p mask, v4p a, v4p b) { return vbslq_u32(mask, a, b); }
+
+inline v4p avg4(v4p a, v4p b) { return vreinterpretq_u32_u8(vrhaddq_u8(vreinterpretq_u8_u32(a), vreinterpretq_u8_u32(b))); }
+
+inline v4p near4(v4p a, v4p b, v4p threshold)
+{
+    uint8x16_t over = vcgtq_u8(vabdq_u8(vreinterpretq_u8_u32(a), vreinterpretq_u8_u32(b)), vreinterpretq_u8_u32(threshold));
+    return vceqq_u32(vreinterpretq_u32_u8(over), vdupq_n_u32(0));
+}
+
+inline v4p scale4(v4p a, v4p weight)
+{
+    uint8x16_t a8 = vreinterpretq_u8_u32(a), w8 = vreinterpretq_u8_u32(weight);
+    uint8x8_t lo = vshrn_n_u16(vmull_u8(vget_low_u8(a8), vget_low_u8(w8)), 8);
+    uint8x8_t hi = vshrn_n_u16(vmull_u8(vget_high_u8(a8), vget_high_u8(w8)), 8);
+    return vreinterpretq_u32_u8(vcombine_u8(lo, hi));
+}
+
+inline void zip4(v4p a, v4p b, v4p& lo, v4p& hi) { uint32x4x2_t z = vzipq_u32(a, b); lo = z.val[0]; hi = z.val[1]; }
+
+inline v4f loadf(const float* p) { return vld1q_f32(p); }
+inline void storef(float* p, v4f v) { vst1q_f32(p, v); }
+inline v4f splatf(float x) { return vdupq_n_f32(x); }
+inline v4f addf(v4f a, v4f b) { return vaddq_f32(a, b); }
+inline v4f mulf(v4f a, v4f b) { return vmulq_f32(a, b); }
+inline v4f maddf(v4f acc, v4f a, v4f b) { return vmlaq_f32(acc, a, b); }
+
+#else
+
+struct v4p { uint32_t l[4]; };
+struct v4f { float l[4]; };
+
+inline v4p load4(const uint32_t* p) { v4p r; memcpy(r.l, p, sizeof r.l); return r; }
+inline void store4(uint32_t* p, v4p v) { memcpy(p, v.l, sizeof v.l); }
+inline v4p splat4(uint32_t x) { return v4p{ { x, x, x, x } }; }
+
+#define VF_LANES(expr) v4p r; for (int i = 0; i < 4; i++) r.l[i] = (expr); return r
+inline v4p eq4(v4p a, v4p b) { VF_LANES(a.l[i] == b.l[i] ? 0xffffffffu : 0u); }
+inline v4p and4(v4p a, v4p b) { VF_LANES(a.l[i] & b.l[i]); }
+inline v4p or4(v4p a, v4p b) { VF_LANES(a.l[i] | b.l[i]); }
+inline v4p andnot4(v4p a, v4p b) { VF_LANES(~a.l[i] & b.l[i]); }
+inline v4p select4(v4p mask, v4p a, v4p b) { VF_LANES((mask.l[i] & a.l[i]) | (~mask.l[i] & b.l[i])); }
+#undef VF_LANES
+
+inline uint32_t channel(uint32_t p, int c) { return (p >> (c * 8)) & 0xff; }
+
+inline v4p avg4(v4p a, v4p b)
+{
+    v4p r;
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t x = 0;
+        for (int c = 0; c < 4; c++)
+            x |= ((channel(a.l[i], c) + channel(b.l[i], c) + 1) >> 1) << (c * 8);
+        r.l[i] = x;
+    }
+    return r;
+}
+
+inline v4p near4(v4p a, v4p b, v4p threshold)
+{
+    v4p r;
+    for (int i = 0; i < 4; i++)
+    {
+        bool near = true;
+        for (int c = 0; c < 4; c++)
+        {
+            int d = (int)channel(a.l[i], c) - (int)channel(b.l[i], c);
+            near &= (uint32_t)(d < 0 ? -d : d) <= channel(threshold.l[i], c);
+        }
+        r.l[i] = near ? 0xffffffffu : 0u;
+    }
+    return r;
+}
+
+inline v4p scale4(v4p a, v4p weight)
+{
+    v4p r;
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t x = 0;
+        for (int c = 0; c < 4; c++)
+            x |= ((channel(a.l[i], c) * channel(weight.l[i], c)) >> 8) << (c * 8);
+        r.l[i] = x;
+    }
+    return r;
+}
+
+inline void zip4(v4p a, v4p b, v4p& lo, v4p& hi)
+{
+    lo = v4p{ { a.l[0], b.l[0], a.l[1], b.l[1] } };
+    hi = v4p{ { a.l[2], b.l[2], a.l[3], b.l[3] } };
+}
+
+inline v4f loadf(const float* p) { v4f r; memcpy(r.l, p, sizeof r.l); return r; }
+inline void storef(float* p, v4f v) { memcpy(p, v.l, sizeof v.l); }
+inline v4f splatf(float x) { return v4f{ { x, x, x, x } }; }
+inline v4f addf(v4f a, v4f b) { return v4f{ { a.l[0] + b.l[0], a.l[1] + b.l[1], a.l[2] + b.l[2], a.l[3] + b.l[3] } }; }
+inline v4f mulf(v4f a, v4f b) { return v4f{ { a.l[0] * b.l[0], a.l[1] * b.l[1], a.l[2] * b.l[2], a.l[3] * b.l[3] } }; }
+inline v4f maddf(v4f acc, v4f a, v4f b) { return addf(acc, mulf(a, b)); }
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+// © Mike Murphy
+
+#include "threadpool.h"
+
+namespace vf {
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    for (int i = 1; i < threadCount; i++)
+        _workers.emplace_back(&ThreadPool::WorkerProc, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _jobReady.notify_all();
+    for (auto& worker : _workers)
+        worker.join();
+}
+
+void ThreadPool::Run(int taskCount, TaskProc task, void* state)
+{
+    if (_workers.empty() || taskCount <= 1)
+    {
+        for (int i = 0; i < taskCount; i++)
+            task(state, i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = task;
+        _state = state;
+        _taskCount = taskCount;
+        _nextTask.store(0, std::memory_order_relaxed);
+        _busyWorkers = (int)_workers.size();
+        _generation++;
+    }
+    _jobReady.notify_all();
+
+    RunTasks();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobDone.wait(lock, [this] { return _busyWorkers == 0; });
+}
+
+void ThreadPool::WorkerProc()
+{
+    unsigned seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobReady.wait(lock, [&] { return _stopping || _generation != seen; });
+            if (_stopping)
+                return;
+            seen = _generation;
+        }
+
+        RunTasks();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            last = --_busyWorkers == 0;
+        }
+        if (last)
+            _jobDone.notify_one();
+    }
+}
+
+void ThreadPool::RunTasks()
+{
+    for (int i = _nextTask.fetch_add(1, std::memory_order_relaxed); i < _taskCount; i = _nextTask.fetch_add(1, std::memory_order_relaxed))
+        _task(_state, i);
+}
+
+}
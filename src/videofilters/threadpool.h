@@ -0,0 +1,53 @@
+// © Mike Murphy
+
+// Fixed set of worker threads that, together with the calling thread, run the numbered tasks
+// of one job at a time. Workers sleep on a condition variable between jobs.
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vf {
+
+class ThreadPool
+{
+public:
+    typedef void (*TaskProc)(void* state, int index);
+
+    // threadCount includes the caller, so 1 creates no workers.
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int ThreadCount() const { return (int)_workers.size() + 1; }
+
+    // Runs task(state, 0) through task(state, taskCount - 1), returning when all have completed.
+    void Run(int taskCount, TaskProc task, void* state);
+
+private:
+    void WorkerProc();
+    void RunTasks();
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _jobReady, _jobDone;
+    unsigned _generation = 0;
+    int _busyWorkers = 0;
+    bool _stopping = false;
+
+    TaskProc _task = nullptr;
+    void* _state = nullptr;
+    int _taskCount = 0;
+    std::atomic<int> _nextTask{ 0 };
+};
+
+}
+
+#endif
@@ -0,0 +1,175 @@
+// © Mike Murphy
+
+#include <string.h>
+#include <algorithm>
+#include <new>
+
+#include "videofilters.h"
+#include "filters.h"
+
+using namespace vf;
+
+namespace {
+
+const int MaxDimension = 4096;
+const int MaxDefaultThreads = 8;
+const int MinBandRows = 16;
+
+struct ApplyJob
+{
+    FilterContext* context;
+    const uint8_t* input;
+    int inputPitch;
+};
+
+int DefaultThreadCount()
+{
+    int processors = (int)std::thread::hardware_concurrency();
+    return std::max(1, std::min(processors, MaxDefaultThreads));
+}
+
+void PadRow(FilterContext& c, const uint32_t* source, int paddedRow)
+{
+    uint32_t* row = c.padded.data() + paddedRow * c.paddedPitch;
+    memcpy(row + 1, source, c.width * sizeof(uint32_t));
+    row[0] = source[0];
+    row[c.width + 1] = source[c.width - 1];
+
+    if (c.filter == EMU7800_FILTER_HQ2X)
+    {
+        uint32_t* yuv = c.paddedYuv.data() + paddedRow * c.paddedPitch;
+        for (int x = 0; x < c.paddedPitch; x++)
+            yuv[x] = ToYuv(row[x]);
+    }
+}
+
+void PadBand(void* state, int band)
+{
+    const ApplyJob& job = *(const ApplyJob*)state;
+    FilterContext& c = *job.context;
+    int y0 = band * c.bandRows, y1 = std::min(y0 + c.bandRows, c.height);
+    for (int y = y0; y < y1; y++)
+    {
+        const uint32_t* source = (const uint32_t*)(job.input + (size_t)y * job.inputPitch);
+        PadRow(c, source, y + 1);
+        if (y == 0)
+            PadRow(c, source, 0);
+        if (y == c.height - 1)
+            PadRow(c, source, c.height + 1);
+    }
+}
+
+void FilterBand(void* state, int band)
+{
+    FilterContext& c = *((const ApplyJob*)state)->context;
+    int y0 = band * c.bandRows, y1 = std::min(y0 + c.bandRows, c.height);
+    switch (c.filter)
+    {
+    case EMU7800_FILTER_SCALE2X:    Scale2xRows(c, y0, y1); break;
+    case EMU7800_FILTER_HQ2X:       Hq2xRows(c, y0, y1); break;
+    case EMU7800_FILTER_SCANLINES:  ScanlineRows(c, y0, y1); break;
+    case EMU7800_FILTER_CRT:        CrtRows(c, y0, y1); break;
+    case EMU7800_FILTER_NTSC:       NtscRows(c, band, y0, y1); break;
+    }
+}
+
+void CopyBand(void* state, int band)
+{
+    const ApplyJob& job = *(const ApplyJob*)state;
+    FilterContext& c = *job.context;
+    int y0 = band * c.bandRows, y1 = std::min(y0 + c.bandRows, c.height);
+    for (int y = y0; y < y1; y++)
+        memcpy(c.output.data() + (size_t)y * c.width, job.input + (size_t)y * job.inputPitch, c.width * sizeof(uint32_t));
+}
+
+}
+
+FilterContext::FilterContext(int filter, int width, int height, int threadCount)
+    : filter(filter), width(width), height(height), frame(0), pool(threadCount)
+{
+    int scale = filter == EMU7800_FILTER_NONE ? 1 : 2;
+    outWidth = width * scale;
+    outHeight = height * scale;
+    output.resize((size_t)outWidth * outHeight);
+
+    paddedPitch = width + 2;
+    if (filter != EMU7800_FILTER_NONE)
+        padded.resize((size_t)paddedPitch * (height + 2));
+    if (filter == EMU7800_FILTER_HQ2X)
+        paddedYuv.resize(padded.size());
+
+    // A few bands per thread keeps threads busy when some finish early, without bands so
+    // thin that the rows shared at band edges dominate.
+    bandCount = std::max(1, std::min(pool.ThreadCount() * 3, height / MinBandRows));
+    bandRows = (height + bandCount - 1) / bandCount;
+    bandCount = (height + bandRows - 1) / bandRows;
+
+    ntscStride = 0;
+    if (filter == EMU7800_FILTER_CRT)
+        InitCrt(*this);
+    if (filter == EMU7800_FILTER_NTSC)
+        InitNtsc(*this);
+}
+
+extern "C" {
+
+EMU7800_VIDEOFILTERS_API void *emu7800_filter_create(int32_t filter, int32_t width, int32_t height, int32_t thread_count)
+{
+    if (filter < EMU7800_FILTER_NONE || filter > EMU7800_FILTER_NTSC)
+        return nullptr;
+    if (width < 1 || width > MaxDimension || height < 1 || height > MaxDimension)
+        return nullptr;
+    if (thread_count <= 0)
+        thread_count = DefaultThreadCount();
+
+    try
+    {
+        return new FilterContext(filter, width, height, thread_count);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+EMU7800_VIDEOFILTERS_API void emu7800_filter_destroy(void *filter)
+{
+    delete (FilterContext*)filter;
+}
+
+EMU7800_VIDEOFILTERS_API int32_t emu7800_filter_output_size(void *filter, int32_t *width, int32_t *height)
+{
+    if (!filter)
+        return 0;
+    const FilterContext& c = *(const FilterContext*)filter;
+    if (width)
+        *width = c.outWidth;
+    if (height)
+        *height = c.outHeight;
+    return 1;
+}
+
+EMU7800_VIDEOFILTERS_API const uint8_t *emu7800_filter_apply(void *filter, const uint8_t *input, int32_t input_pitch)
+{
+    if (!filter || !input)
+        return nullptr;
+    FilterContext& c = *(FilterContext*)filter;
+    if (input_pitch < c.width * (int)sizeof(uint32_t))
+        return nullptr;
+
+    ApplyJob job{ &c, input, input_pitch };
+    if (c.filter == EMU7800_FILTER_NONE)
+    {
+        c.pool.Run(c.bandCount, CopyBand, &job);
+    }
+    else
+    {
+        // Kernels read the rows either side of their band, so padding completes before filtering starts.
+        c.pool.Run(c.bandCount, PadBand, &job);
+        c.pool.Run(c.bandCount, FilterBand, &job);
+    }
+    c.frame++;
+    return (const uint8_t*)c.output.data();
+}
+
+}
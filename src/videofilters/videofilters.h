@@ -0,0 +1,65 @@
+// © Mike Murphy
+
+// C interface to the EMU7800 video post-processing library. Filters take a BGR32 frame, as
+// handed to the graphics drivers (4 bytes per pixel: blue, green, red, unused), and produce a
+// larger BGR32 frame on the CPU, spreading rows across a small pool of worker threads:
+//
+//   EMU7800_FILTER_SCALE2X    2x edge-directed pixel art scaling (AdvMAME2x)
+//   EMU7800_FILTER_HQ2X       2x scaling that treats colors within the hqx YUV thresholds as
+//                             equal and blends the corners it rounds off
+//   EMU7800_FILTER_SCANLINES  2x with darkened alternate lines
+//   EMU7800_FILTER_CRT        scanlines under an aperture grille phosphor mask
+//   EMU7800_FILTER_NTSC       2x with composite video chroma bleed and luma/chroma crosstalk
+//
+// All buffers are allocated when a filter is created for an input size; applying a filter
+// allocates nothing.
+
+#ifndef EMU7800_VIDEOFILTERS_H
+#define EMU7800_VIDEOFILTERS_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#ifdef EMU7800VIDEOFILTERS_EXPORTS
+#define EMU7800_VIDEOFILTERS_API __declspec(dllexport)
+#else
+#define EMU7800_VIDEOFILTERS_API __declspec(dllimport)
+#endif
+#else
+#define EMU7800_VIDEOFILTERS_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum emu7800_filter_type {
+    EMU7800_FILTER_NONE      = 0,
+    EMU7800_FILTER_SCALE2X   = 1,
+    EMU7800_FILTER_HQ2X      = 2,
+    EMU7800_FILTER_SCANLINES = 3,
+    EMU7800_FILTER_CRT       = 4,
+    EMU7800_FILTER_NTSC      = 5,
+};
+
+/*
+ * thread_count: total threads applying the filter, including the caller; 0 for one per processor (up to 8).
+ * Returns NULL for an unknown filter or a size outside 1..4096.
+ */
+EMU7800_VIDEOFILTERS_API void *emu7800_filter_create(int32_t filter, int32_t width, int32_t height, int32_t thread_count);
+
+EMU7800_VIDEOFILTERS_API void emu7800_filter_destroy(void *filter);
+
+EMU7800_VIDEOFILTERS_API int32_t emu7800_filter_output_size(void *filter, int32_t *width, int32_t *height);
+
+/*
+ * Filters a frame of the size the filter was created for; input_pitch is in bytes.
+ * Returns the filtered frame, owned by the filter and valid until the next call; its pitch is output width * 4.
+ */
+EMU7800_VIDEOFILTERS_API const uint8_t *emu7800_filter_apply(void *filter, const uint8_t *input, int32_t input_pitch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,13 +2,12 @@
 
 using EMU7800.Shell;
 using System;
-using System.Collections.Generic;
 
 namespace EMU7800.Win32.Interop;
 
 public sealed class GraphicsDeviceD2DDriver : DisposableResource, IGraphicsDeviceDriver
 {
-    readonly static List<IDisposable> Disposables = [];
+    readonly static DisposableResourceList Disposables = new();
 
     #region IGraphicsDeviceDriver Members
 
@@ -65,11 +64,7 @@ public sealed class GraphicsDeviceD2DDriver : DisposableResource, IGraphicsDevic
 
     public void Shutdown()
     {
-        foreach (var disposable in Disposables)
-        {
-            disposable.Dispose();
-        }
-        Disposables.Clear();
+        Disposables.DisposeAll();
 
         Direct2DNativeMethods.Direct2D_Shutdown();
     }